@@ -0,0 +1,94 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+//==============================================================================
+/**
+ * Infrastruttura minima dei benchmark di AnalogEQBench: ogni file registra
+ * le sue misure con una Bench::Registration statica, main le esegue in
+ * ordine (o solo quelle il cui nome contiene l'argomento) e stampa una
+ * tabella per misura. I tempi sono il minimo su più ripetizioni, in
+ * nanosecondi per campione e per canale (o per valutazione), con il
+ * rapporto rispetto alla prima riga della tabella. Build Release: i numeri
+ * di Debug non dicono nulla.
+ */
+namespace Bench
+{
+    using Function = void (*)();
+
+    struct Entry
+    {
+        const char* name;
+        Function run;
+    };
+
+    inline std::vector<Entry>& getRegistry()
+    {
+        static std::vector<Entry> registry;
+        return registry;
+    }
+
+    struct Registration
+    {
+        Registration(const char* name, Function run) { getRegistry().push_back({ name, run }); }
+    };
+
+    /**
+     * @param fn Processa numSamples campioni per canale a ogni chiamata
+     * @return ns per campione per canale, minimo su numRuns ripetizioni
+     */
+    template <typename Fn>
+    double measure(Fn&& fn, int numSamples, int numChannels = 2, int numIterations = 1000, int numRuns = 7)
+    {
+        fn(); // riscaldamento: cache, predittori, prima progettazione
+
+        double best = std::numeric_limits<double>::max();
+        for (int run = 0; run < numRuns; ++run)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < numIterations; ++i)
+                fn();
+
+            const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count() / (static_cast<double>(numIterations) * numSamples * numChannels));
+        }
+
+        return best;
+    }
+
+    /** Una tabella: le righe si confrontano con la prima. */
+    class Table
+    {
+    public:
+        explicit Table(const juce::String& title, const char* unit = "ns/sample")
+        {
+            std::printf("\n%s\n%-44s %12s %10s\n", title.toRawUTF8(), "", unit, "ratio");
+        }
+
+        void add(const juce::String& name, double nanoseconds)
+        {
+            if (reference <= 0.0)
+                reference = nanoseconds;
+
+            std::printf("%-44s %12.3f %9.2fx\n", name.toRawUTF8(), nanoseconds, nanoseconds / reference);
+        }
+
+    private:
+        double reference = 0.0;
+    };
+
+    /** Rumore bianco uniforme in [-amplitude, amplitude]. */
+    template <typename Buffer>
+    void fillNoise(Buffer& buffer, float amplitude, juce::int64 seed = 1)
+    {
+        juce::Random random(seed);
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.getWritePointer(ch)[i] = amplitude * (2.0f * random.nextFloat() - 1.0f);
+    }
+}
@@ -0,0 +1,21 @@
+#include "Bench.h"
+#include "DSP/KernelDispatch.h"
+#include <cstring>
+
+//==============================================================================
+/**
+ * Esegue i benchmark registrati (tutti, o quelli il cui nome contiene il
+ * primo argomento) con i kernel della ISA migliore per la CPU, o di quella
+ * forzata da ANALOGEQ_FORCE_ISA.
+ */
+int main(int argc, char* argv[])
+{
+    const auto isa = KernelDispatch::selectKernels();
+    std::printf("AnalogEQ benchmarks, kernels: %s\n", KernelDispatch::getIsaName(isa));
+
+    for (const auto& entry : Bench::getRegistry())
+        if (argc < 2 || std::strstr(entry.name, argv[1]) != nullptr)
+            entry.run();
+
+    return 0;
+}
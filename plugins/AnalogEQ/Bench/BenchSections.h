@@ -0,0 +1,37 @@
+#pragma once
+
+#include "DSP/BiquadDesign.h"
+#include <array>
+
+namespace Bench
+{
+    /** Sezioni progettate di una banda, in layout SoA, con il loro stato. */
+    struct Sections
+    {
+        Sections(const BiquadDesign::BandParameters& parameters, double sampleRate)
+        {
+            numSections = BiquadDesign::designBand(parameters, sampleRate, designed);
+
+            for (int s = 0; s < numSections; ++s)
+            {
+                const auto& c = designed[static_cast<size_t>(s)];
+                b0[static_cast<size_t>(s)] = c.b0;
+                b1[static_cast<size_t>(s)] = c.b1;
+                b2[static_cast<size_t>(s)] = c.b2;
+                a1[static_cast<size_t>(s)] = c.a1;
+                a2[static_cast<size_t>(s)] = c.a2;
+            }
+        }
+
+        BiquadKernels::SectionRange getRange()
+        {
+            return { b0.data(), b1.data(), b2.data(), a1.data(), a2.data(), z1.data(), z2.data(), numSections };
+        }
+
+        static constexpr int maxSections = BiquadCascade::maxSectionsPerBand;
+        BiquadDesign::SectionArray designed {};
+        std::array<float, maxSections> b0 {}, b1 {}, b2 {}, a1 {}, a2 {};
+        std::array<float, 2 * maxSections> z1 {}, z2 {};
+        int numSections = 0;
+    };
+}
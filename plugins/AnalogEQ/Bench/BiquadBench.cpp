@@ -0,0 +1,117 @@
+#include "Bench.h"
+#include "BenchSections.h"
+#include "DSP/KernelDispatch.h"
+#include <juce_dsp/juce_dsp.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace
+{
+    constexpr int blockSize = 512;
+    constexpr double sampleRate = 48000.0;
+
+    /**
+     * La stessa cascata con juce::dsp::IIR::Filter: un filtro per sezione e
+     * per canale, processati a blocchi con ProcessContextReplacing sul
+     * singolo canale, come faceva la catena prima del kernel stereo.
+     */
+    struct JuceCascade
+    {
+        explicit JuceCascade(const Bench::Sections& sections)
+        {
+            const juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(blockSize), 1 };
+
+            for (auto& channel : filters)
+            {
+                for (int s = 0; s < sections.numSections; ++s)
+                {
+                    const auto& c = sections.designed[static_cast<size_t>(s)];
+                    juce::dsp::IIR::Filter<float> filter;
+                    filter.coefficients = new juce::dsp::IIR::Coefficients<float>(c.b0, c.b1, c.b2, 1.0f, c.a1, c.a2);
+                    filter.prepare(spec);
+                    channel.push_back(filter);
+                }
+            }
+        }
+
+        void process(juce::AudioBuffer<float>& buffer)
+        {
+            juce::dsp::AudioBlock<float> block(buffer);
+
+            for (size_t ch = 0; ch < filters.size(); ++ch)
+            {
+                auto channelBlock = block.getSingleChannelBlock(ch);
+                juce::dsp::ProcessContextReplacing<float> context(channelBlock);
+
+                for (auto& filter : filters[ch])
+                    filter.process(context);
+            }
+        }
+
+        std::array<std::vector<juce::dsp::IIR::Filter<float>>, 2> filters;
+    };
+
+    /**
+     * Cascata di biquad stereo su blocchi di 512 campioni: il percorso
+     * per canale di juce::dsp::IIR, i kernel scalari canale per canale e il
+     * kernel stereo di ogni ISA supportata, per 1, 4 e 8 sezioni.
+     */
+    void runBiquadBench()
+    {
+        juce::AudioBuffer<float> input(2, blockSize), buffer(2, blockSize);
+        Bench::fillNoise(input, 0.5f);
+
+        // Ogni iterazione riparte dallo stesso rumore (niente denormali dal
+        // filtraggio ripetuto dello stesso blocco); la copia pesa uguale su ogni riga
+        const auto copyInput = [&]
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                std::copy_n(input.getReadPointer(ch), blockSize, buffer.getWritePointer(ch));
+        };
+
+        const auto* scalar = KernelDispatch::getKernels(KernelDispatch::Isa::scalar);
+
+        for (const int slope : { 1, 3, 4 })
+        {
+            const BiquadDesign::BandParameters parameters { FilterType::LowPass, 8000.0f, 0.0f, 0.707f, slope };
+            Bench::Sections sections(parameters, sampleRate);
+
+            Bench::Table table("Biquad cascade, " + juce::String(sections.numSections)
+                               + " sections, stereo blocks of 512 samples");
+
+            JuceCascade juceCascade(sections);
+            table.add("juce::dsp::IIR::Filter, per channel", Bench::measure([&]
+            {
+                copyInput();
+                juceCascade.process(buffer);
+            }, blockSize));
+
+            if (scalar != nullptr)
+            {
+                table.add("scalar kernel, per channel", Bench::measure([&]
+                {
+                    copyInput();
+                    scalar->biquadMono(sections.getRange(), 0, buffer.getWritePointer(0), blockSize);
+                    scalar->biquadMono(sections.getRange(), 1, buffer.getWritePointer(1), blockSize);
+                }, blockSize));
+            }
+
+            for (int i = 0; i < KernelDispatch::numIsas; ++i)
+            {
+                const auto isa = static_cast<KernelDispatch::Isa>(i);
+                const auto* kernels = KernelDispatch::getKernels(isa);
+                if (kernels == nullptr)
+                    continue;
+
+                table.add(juce::String(KernelDispatch::getIsaName(isa)) + " stereo kernel", Bench::measure([&]
+                {
+                    copyInput();
+                    kernels->biquadStereo(sections.getRange(), buffer.getWritePointer(0), buffer.getWritePointer(1), blockSize);
+                }, blockSize));
+            }
+        }
+    }
+}
+
+static Bench::Registration biquadBench("biquad", runBiquadBench);
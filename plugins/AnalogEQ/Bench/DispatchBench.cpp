@@ -0,0 +1,178 @@
+#include "Bench.h"
+#include "BenchSections.h"
+#include "DSP/FilterTypes.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <variant>
+#include <vector>
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numBands = 8;
+
+    //==============================================================================
+    /**
+     * Kernel stereo istanziato per il numero di sezioni (dispatchSectionCount)
+     * contro il ciclo sulle sezioni a runtime, blocchi di 64 campioni.
+     */
+    void runSectionCountBench()
+    {
+        constexpr int blockSize = 64;
+
+        juce::AudioBuffer<float> input(2, blockSize), buffer(2, blockSize);
+        Bench::fillNoise(input, 0.5f);
+
+        const auto copyInput = [&]
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                std::copy_n(input.getReadPointer(ch), blockSize, buffer.getWritePointer(ch));
+        };
+
+        Bench::Table table("Biquad section count, stereo blocks of 64 samples");
+
+        for (const int slope : { 1, 2, 3, 4 })
+        {
+            Bench::Sections designed({ FilterType::LowPass, 8000.0f, 0.0f, 0.707f, slope }, sampleRate);
+            const auto range = designed.getRange();
+            const auto sections = juce::String(range.numSections) + " sections";
+
+            table.add(sections + ", runtime count", Bench::measure([&]
+            {
+                copyInput();
+                BiquadKernels::processStereo<0>(range, buffer.getWritePointer(0), buffer.getWritePointer(1), blockSize);
+            }, blockSize));
+
+            table.add(sections + ", specialized", Bench::measure([&]
+            {
+                copyInput();
+                BiquadKernels::dispatchSectionCount(range.numSections, [&](auto fixedSections)
+                {
+                    BiquadKernels::processStereo<decltype(fixedSections)::value>(range, buffer.getWritePointer(0),
+                                                                                 buffer.getWritePointer(1), blockSize);
+                });
+            }, blockSize));
+        }
+    }
+
+    //==============================================================================
+    using BandFilter = std::variant<LowPassFilter, HighPassFilter, BellFilter,
+                                    LowShelfFilter, HighShelfFilter, NotchFilter>;
+
+    /** Le bande di una catena tipica, attaccate allo stesso motore a cascata. */
+    struct Bands
+    {
+        Bands()
+        {
+            for (int band = 0; band < numBands; ++band)
+            {
+                auto& slot = filters[static_cast<size_t>(band)];
+                switch (band % 6)
+                {
+                    case 0:  slot.emplace<HighPassFilter>(); break;
+                    case 1:  slot.emplace<LowShelfFilter>(); break;
+                    case 2:  slot.emplace<BellFilter>(); break;
+                    case 3:  slot.emplace<NotchFilter>(); break;
+                    case 4:  slot.emplace<HighShelfFilter>(); break;
+                    default: slot.emplace<LowPassFilter>(); break;
+                }
+
+                auto& filter = std::visit([](auto& f) -> FilterBase& { return f; }, slot);
+                filter.attachToCascade(&cascade, band);
+                filter.prepare(sampleRate, 512);
+                filter.setFrequency(60.0f * std::pow(2.0f, static_cast<float>(band)));
+                filter.setGain(band % 2 == 0 ? 4.0f : -3.0f);
+                filter.setQ(1.2f);
+                filter.setSlope(band % 3 + 1);
+                filter.updateCoefficients(sampleRate);
+                pointers.push_back(&filter);
+            }
+        }
+
+        BiquadCascade cascade;
+        std::array<BandFilter, numBands> filters;
+        std::vector<FilterBase*> pointers;
+    };
+
+    /**
+     * Chiamate per banda attraverso FilterBase (virtuali) e con std::visit sui
+     * tipi final, come FilterChain::forEachFilter: processamento a blocchi
+     * corti, dove il costo della chiamata conta di più, e curva di risposta.
+     */
+    void runBandDispatchBench()
+    {
+        constexpr int blockSize = 32;
+        constexpr int numPoints = 256;
+
+        Bands bands;
+        juce::AudioBuffer<float> input(2, blockSize), buffer(2, blockSize);
+        Bench::fillNoise(input, 0.25f);
+
+        const auto copyInput = [&]
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                std::copy_n(input.getReadPointer(ch), blockSize, buffer.getWritePointer(ch));
+        };
+
+        {
+            Bench::Table table("Band dispatch, 8 bands, stereo blocks of 32 samples");
+
+            table.add("virtual FilterBase::process", Bench::measure([&]
+            {
+                copyInput();
+                for (auto* filter : bands.pointers)
+                    filter->process(buffer);
+            }, blockSize));
+
+            table.add("std::visit on final types", Bench::measure([&]
+            {
+                copyInput();
+                for (auto& slot : bands.filters)
+                    std::visit([&](auto& filter) { filter.process(buffer); }, slot);
+            }, blockSize));
+        }
+
+        {
+            std::array<float, numPoints> frequencies {};
+            volatile float response = 0.0f; // il risultato deve restare osservabile
+            for (int i = 0; i < numPoints; ++i)
+                frequencies[static_cast<size_t>(i)] = 20.0f * std::pow(1000.0f, static_cast<float>(i) / (numPoints - 1));
+
+            Bench::Table table("Band dispatch, 8-band response of 256 points", "ns/point");
+
+            table.add("virtual FilterBase::getFrequencyResponse", Bench::measure([&]
+            {
+                for (int i = 0; i < numPoints; ++i)
+                {
+                    float sum = 0.0f;
+                    for (const auto* filter : bands.pointers)
+                        sum += filter->getFrequencyResponse(frequencies[static_cast<size_t>(i)]);
+                    response = sum;
+                }
+            }, numPoints, 1, 100));
+
+            table.add("std::visit on final types", Bench::measure([&]
+            {
+                for (int i = 0; i < numPoints; ++i)
+                {
+                    float sum = 0.0f;
+                    for (const auto& slot : bands.filters)
+                        sum += std::visit([&](const auto& filter)
+                        {
+                            return filter.getFrequencyResponse(frequencies[static_cast<size_t>(i)]);
+                        }, slot);
+                    response = sum;
+                }
+            }, numPoints, 1, 100));
+        }
+    }
+
+    void runDispatchBench()
+    {
+        runSectionCountBench();
+        runBandDispatchBench();
+    }
+}
+
+static Bench::Registration dispatchBench("dispatch", runDispatchBench);
@@ -0,0 +1,116 @@
+#include "Bench.h"
+#include "DSP/ChainOversampler.h"
+#include "DSP/FilterChain.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <tuple>
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+    constexpr int numBands = 8;
+
+    /**
+     * Una catena di 8 bande (bell e shelf fino a 16 kHz) con il metodo di
+     * progetto dato, alla frequenza di ChainOversampler.
+     */
+    struct Chain
+    {
+        Chain(BiquadDesign::Method method, int oversamplingOrder)
+        {
+            oversampler.prepare(blockSize);
+            oversampler.setMode(oversamplingOrder, ChainOversampler::Filter::polyphaseIir,
+                                ChainOversampler::Scope::wholeChain);
+
+            chain.setAsyncDesign(false);
+            chain.setDesignMethod(method);
+
+            for (int band = 0; band < numBands; ++band)
+            {
+                const auto type = band == 0 ? FilterType::LowShelf
+                                            : (band == numBands - 1 ? FilterType::HighShelf : FilterType::Bell);
+                auto* filter = chain.addFilter(type);
+                filter->setFrequency(60.0f * std::pow(2.0f, static_cast<float>(band) * 1.2f));
+                filter->setGain(band % 2 == 0 ? 4.0f : -3.0f);
+                filter->setQ(1.2f);
+            }
+
+            chain.prepare(oversampler.getProcessingRate(sampleRate), blockSize * oversampler.getFactor());
+
+            for (size_t band = 0; band < numBands; ++band)
+                chain.updateFilterCoefficients(band);
+        }
+
+        void process(juce::AudioBuffer<float>& buffer) { oversampler.process(buffer, chain); }
+
+        ChainOversampler oversampler;
+        FilterChain chain;
+    };
+
+    /**
+     * Costo dei progetti matched: la catena a 1x con progetti matched e
+     * bilineari, la catena bilineare a 2x e 4x (la via alternativa per
+     * togliere la compressione vicino a Nyquist), e il progetto di una
+     * singola banda con i due metodi.
+     */
+    void runMatchedDesignBench()
+    {
+        using BiquadDesign::Method;
+
+        juce::AudioBuffer<float> input(2, blockSize), buffer(2, blockSize);
+        Bench::fillNoise(input, 0.25f);
+
+        const auto copyInput = [&]
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                std::copy_n(input.getReadPointer(ch), blockSize, buffer.getWritePointer(ch));
+        };
+
+        {
+            Bench::Table table("Chain of 8 bands, stereo blocks of 512 samples");
+
+            for (const auto& row : { std::make_tuple("matched 1x", Method::matched, 0),
+                                     std::make_tuple("bilinear 1x", Method::bilinear, 0),
+                                     std::make_tuple("bilinear 2x, polyphase IIR", Method::bilinear, 1),
+                                     std::make_tuple("bilinear 4x, polyphase IIR", Method::bilinear, 2) })
+            {
+                auto chain = std::make_unique<Chain>(std::get<1>(row), std::get<2>(row));
+                table.add(std::get<0>(row), Bench::measure([&]
+                {
+                    copyInput();
+                    chain->process(buffer);
+                }, blockSize));
+            }
+        }
+
+        {
+            constexpr int numDesigns = 64;
+            volatile float sink = 0.0f; // i coefficienti devono restare osservabili
+
+            Bench::Table table("Design of one band", "ns/design");
+
+            for (const auto& row : { std::make_tuple("bilinear bell", FilterType::Bell, Method::bilinear),
+                                     std::make_tuple("matched bell", FilterType::Bell, Method::matched),
+                                     std::make_tuple("bilinear high shelf", FilterType::HighShelf, Method::bilinear),
+                                     std::make_tuple("matched high shelf", FilterType::HighShelf, Method::matched) })
+            {
+                BiquadDesign::SectionArray sections {};
+                table.add(std::get<0>(row), Bench::measure([&]
+                {
+                    for (int i = 0; i < numDesigns; ++i)
+                    {
+                        const BiquadDesign::BandParameters parameters { std::get<1>(row), 1000.0f + 200.0f * static_cast<float>(i),
+                                                                        -6.0f, 1.2f, std::get<1>(row) == FilterType::Bell ? 0 : 1,
+                                                                        std::get<2>(row) };
+                        BiquadDesign::designBand(parameters, sampleRate, sections);
+                        sink = sections[0].b0;
+                    }
+                }, numDesigns, 1, 100));
+            }
+        }
+    }
+}
+
+static Bench::Registration matchedDesignBench("matched", runMatchedDesignBench);
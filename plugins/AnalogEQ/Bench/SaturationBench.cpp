@@ -0,0 +1,69 @@
+#include "Bench.h"
+#include "DSP/AnalogSaturation.h"
+#include <juce_dsp/juce_dsp.h>
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+namespace
+{
+    constexpr int blockSize = 512;
+
+    /**
+     * Costo della saturazione per canale: tanh a 1x, con ADAA del primo e del
+     * secondo ordine, e tanh dentro gli stadi di sovracampionamento 2x/4x di
+     * juce::dsp::Oversampling (gli stessi di ChainOversampler), che
+     * comprendono sovra- e sottocampionamento.
+     */
+    void runSaturationBench()
+    {
+        using AnalogSaturation::Antialiasing;
+        using Oversampling = juce::dsp::Oversampling<float>;
+
+        juce::AudioBuffer<float> input(2, blockSize), buffer(2, blockSize);
+        Bench::fillNoise(input, 1.5f);
+
+        const auto copyInput = [&]
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                std::copy_n(input.getReadPointer(ch), blockSize, buffer.getWritePointer(ch));
+        };
+
+        Bench::Table table("Saturation, stereo blocks of 512 samples");
+
+        for (const auto& mode : { std::make_pair("tanh 1x", Antialiasing::none),
+                                  std::make_pair("tanh 1x, ADAA 1st order", Antialiasing::firstOrder),
+                                  std::make_pair("tanh 1x, ADAA 2nd order", Antialiasing::secondOrder) })
+        {
+            AnalogSaturation::State state;
+            table.add(mode.first, Bench::measure([&]
+            {
+                copyInput();
+                AnalogSaturation::process(buffer.getArrayOfWritePointers(), 2, blockSize, mode.second, state);
+            }, blockSize));
+        }
+
+        for (const auto& stage : { std::make_tuple("tanh 2x, polyphase IIR", 1, Oversampling::filterHalfBandPolyphaseIIR),
+                                   std::make_tuple("tanh 4x, polyphase IIR", 2, Oversampling::filterHalfBandPolyphaseIIR),
+                                   std::make_tuple("tanh 2x, linear-phase FIR", 1, Oversampling::filterHalfBandFIREquiripple),
+                                   std::make_tuple("tanh 4x, linear-phase FIR", 2, Oversampling::filterHalfBandFIREquiripple) })
+        {
+            Oversampling oversampling(2, static_cast<size_t>(std::get<1>(stage)), std::get<2>(stage), true, true);
+            oversampling.initProcessing(blockSize);
+
+            table.add(std::get<0>(stage), Bench::measure([&]
+            {
+                copyInput();
+                juce::dsp::AudioBlock<float> block(buffer);
+                auto oversampled = oversampling.processSamplesUp(block);
+
+                float* const channels[] = { oversampled.getChannelPointer(0), oversampled.getChannelPointer(1) };
+                AnalogSaturation::process(channels, 2, static_cast<int>(oversampled.getNumSamples()));
+
+                oversampling.processSamplesDown(block);
+            }, blockSize));
+        }
+    }
+}
+
+static Bench::Registration saturationBench("saturation", runSaturationBench);
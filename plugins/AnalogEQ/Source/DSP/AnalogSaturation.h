@@ -0,0 +1,105 @@
+#pragma once
+
+#include "BiquadCascade.h"
+#include "KernelDispatch.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+
+//==============================================================================
+/**
+ * Stadio di saturazione analogica (soft clipping tanh) applicato dopo le
+ * bande (FilterChain::SaturationPlacement), solo sui canali filtrati.
+ */
+namespace AnalogSaturation
+{
+    constexpr float threshold = KernelDispatch::saturationThreshold;
+    constexpr float makeup = 1.0f / threshold;
+
+    /**
+     * Antialiasing della saturazione (ADAA): invece del valore di tanh nel
+     * campione, la sua media tra ingressi consecutivi, calcolata con le
+     * primitive in forma chiusa. Toglie gran parte dell'aliasing a 1x, con un
+     * ritardo di mezzo campione (primo ordine) o di un campione (secondo
+     * ordine) per stadio, non compensato, e una leggera attenuazione verso
+     * Nyquist.
+     */
+    enum class Antialiasing
+    {
+        none = 0,
+        firstOrder,
+        secondOrder
+    };
+
+    /** Memoria di uno stadio con antialiasing: gli ultimi due ingressi di ogni canale. */
+    struct State
+    {
+        std::array<std::array<float, 2>, BiquadCascade::maxChannels> history {};
+
+        /** Falso dopo reset: il primo blocco riparte dal suo primo campione, senza salti. */
+        bool primed = false;
+
+        void reset() { primed = false; }
+
+        void prime(float* const* channels, int numChannels)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                history[static_cast<size_t>(ch)].fill(channels[ch][0] * makeup);
+
+            primed = true;
+        }
+    };
+
+    /** tanh(x * makeup) * threshold sui canali, con lo slot saturate della ISA attiva. */
+    inline void process(float* const* channels, int numChannels, int numSamples)
+    {
+        const auto saturate = KernelDispatch::getKernels().saturate;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            saturate(channels[ch], numSamples);
+    }
+
+    /** Come process, con l'antialiasing scelto; state conserva gli ingressi tra i blocchi. */
+    inline void process(float* const* channels, int numChannels, int numSamples,
+                        Antialiasing antialiasing, State& state)
+    {
+        if (antialiasing == Antialiasing::none || numSamples == 0)
+            return process(channels, numChannels, numSamples);
+
+        if (!state.primed)
+            state.prime(channels, numChannels);
+
+        const auto& kernels = KernelDispatch::getKernels();
+        const auto saturate = antialiasing == Antialiasing::firstOrder ? kernels.saturateAdaa1 : kernels.saturateAdaa2;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            saturate(channels[ch], numSamples, 1, state.history[static_cast<size_t>(ch)].data());
+    }
+
+    /**
+     * Come process, su frame stereo interleaved (i tile del percorso fused).
+     * Con la stessa memoria il risultato è identico a process sui due canali.
+     */
+    inline void processFrames(float* frames, int numFrames, Antialiasing antialiasing, State& state)
+    {
+        const auto& kernels = KernelDispatch::getKernels();
+
+        if (antialiasing == Antialiasing::none || numFrames == 0)
+            return kernels.saturate(frames, 2 * numFrames);
+
+        if (!state.primed)
+        {
+            float* const channels[] = { frames, frames + 1 };
+            state.prime(channels, 2);
+        }
+
+        auto& left = state.history[0];
+        auto& right = state.history[1];
+        std::array<float, 4> history { left[0], right[0], left[1], right[1] };
+
+        const auto saturate = antialiasing == Antialiasing::firstOrder ? kernels.saturateAdaa1 : kernels.saturateAdaa2;
+        saturate(frames, 2 * numFrames, 2, history.data());
+
+        left = { history[0], history[2] };
+        right = { history[1], history[3] };
+    }
+}
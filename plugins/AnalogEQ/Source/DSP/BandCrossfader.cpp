@@ -0,0 +1,158 @@
+#include "BandCrossfader.h"
+#include "KernelDispatch.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <algorithm>
+
+BandCrossfader::BandCrossfader()
+{
+    for (int band = 0; band < maxBands; ++band)
+        finish(band);
+}
+
+void BandCrossfader::prepare(double sampleRate)
+{
+    warmupSamples = juce::jmax(1, static_cast<int>(sampleRate * warmupMs * 0.001));
+    fadeSamples = juce::jmax(1, static_cast<int>(sampleRate * fadeMs * 0.001));
+}
+
+bool BandCrossfader::isAnyActive() const
+{
+    return std::any_of(slots.begin(), slots.end(), [](const Slot& slot) { return slot.phase != Phase::idle; });
+}
+
+void BandCrossfader::setPending(int band)
+{
+    jassert(juce::isPositiveAndBelow(band, maxBands));
+    slots[static_cast<size_t>(band)].phase = Phase::pending;
+}
+
+void BandCrossfader::begin(int band, const BiquadDesign::SectionArray& sections, int numSections)
+{
+    jassert(juce::isPositiveAndBelow(band, maxBands));
+    auto& slot = slots[static_cast<size_t>(band)];
+
+    slot.numSections = juce::jlimit(1, sectionsPerBand, numSections);
+    for (int s = 0; s < slot.numSections; ++s)
+    {
+        const auto& coefficients = sections[static_cast<size_t>(s)];
+        slot.b0[static_cast<size_t>(s)] = coefficients.b0;
+        slot.b1[static_cast<size_t>(s)] = coefficients.b1;
+        slot.b2[static_cast<size_t>(s)] = coefficients.b2;
+        slot.a1[static_cast<size_t>(s)] = coefficients.a1;
+        slot.a2[static_cast<size_t>(s)] = coefficients.a2;
+    }
+
+    slot.z1.fill(0.0f);
+    slot.z2.fill(0.0f);
+    slot.warmupRemaining = warmupSamples;
+    slot.fadePosition = 0;
+    slot.phase = Phase::warming;
+}
+
+BiquadKernels::SectionRange BandCrossfader::getRange(int band)
+{
+    auto& slot = slots[static_cast<size_t>(band)];
+    return { slot.b0.data(), slot.b1.data(), slot.b2.data(), slot.a1.data(), slot.a2.data(),
+             slot.z1.data(), slot.z2.data(), slot.numSections };
+}
+
+void BandCrossfader::finish(int band)
+{
+    auto& slot = slots[static_cast<size_t>(band)];
+    slot.b0.fill(1.0f);
+    slot.b1.fill(0.0f);
+    slot.b2.fill(0.0f);
+    slot.a1.fill(0.0f);
+    slot.a2.fill(0.0f);
+    slot.z1.fill(0.0f);
+    slot.z2.fill(0.0f);
+    slot.numSections = 1;
+    slot.phase = Phase::idle;
+}
+
+bool BandCrossfader::process(int band, BiquadCascade& cascade, float* const* channels, int numChannels, int numSamples)
+{
+    jassert(juce::isPositiveAndBelow(band, maxBands));
+    auto& slot = slots[static_cast<size_t>(band)];
+    numChannels = juce::jmin(numChannels, maxChannels);
+
+    if (slot.phase == Phase::idle || slot.phase == Phase::pending || numChannels == 0)
+    {
+        cascade.processBand(band, channels, numChannels, numSamples);
+        return false;
+    }
+
+    const auto& kernels = KernelDispatch::getKernels();
+    const auto range = getRange(band);
+
+    for (int start = 0; start < numSamples; start += shadowSize)
+    {
+        const int count = juce::jmin(shadowSize, numSamples - start);
+        float* block[maxChannels] {};
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            block[ch] = channels[ch] + start;
+            std::copy(block[ch], block[ch] + count, shadow[static_cast<size_t>(ch)].data());
+        }
+
+        // Banda corrente nel motore, banda sostitutiva in ombra sullo stesso ingresso
+        cascade.processBand(band, block, numChannels, count);
+
+        if (numChannels == 2)
+            kernels.biquadStereo(range, shadow[0].data(), shadow[1].data(), count);
+        else
+            kernels.biquadMono(range, 0, shadow[0].data(), count);
+
+        mix(slot, block, numChannels, count);
+    }
+
+    return slot.phase == Phase::completed;
+}
+
+void BandCrossfader::mix(Slot& slot, float* const* output, int numChannels, int numSamples)
+{
+    int i = 0;
+
+    // Warm-up: l'uscita resta quella della banda corrente
+    if (slot.phase == Phase::warming)
+    {
+        const int count = juce::jmin(slot.warmupRemaining, numSamples);
+        slot.warmupRemaining -= count;
+        i = count;
+
+        if (slot.warmupRemaining == 0)
+            slot.phase = Phase::fading;
+    }
+
+    // Dissolvenza lineare (le due bande sono correlate: guadagno costante)
+    if (slot.phase == Phase::fading && i < numSamples)
+    {
+        const int count = juce::jmin(fadeSamples - slot.fadePosition, numSamples - i);
+        const float step = 1.0f / static_cast<float>(fadeSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* out = output[ch];
+            const auto* replacement = shadow[static_cast<size_t>(ch)].data();
+            float gain = static_cast<float>(slot.fadePosition) * step;
+
+            for (int n = i; n < i + count; ++n)
+            {
+                out[n] += gain * (replacement[n] - out[n]);
+                gain += step;
+            }
+        }
+
+        slot.fadePosition += count;
+        i += count;
+
+        if (slot.fadePosition >= fadeSamples)
+            slot.phase = Phase::completed;
+    }
+
+    // Dissolvenza completata: solo la banda sostitutiva
+    if (slot.phase == Phase::completed && i < numSamples)
+        for (int ch = 0; ch < numChannels; ++ch)
+            std::copy(shadow[static_cast<size_t>(ch)].data() + i, shadow[static_cast<size_t>(ch)].data() + numSamples, output[ch] + i);
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "BiquadCascade.h"
+#include "BiquadDesign.h"
+#include <array>
+
+//==============================================================================
+/**
+ * Sostituzione senza click di una banda (cambio di tipo o di slope).
+ *
+ * La banda sostitutiva vive qui, fuori dal motore a cascata, con i propri
+ * coefficienti e il proprio stato. Mentre la transizione è attiva la banda
+ * corrente continua a girare nel motore e quella nuova riceve lo stesso
+ * ingresso:
+ * - warming: la nuova banda gira in ombra finché il suo transitorio da stato
+ *   nullo si è esaurito (l'uscita resta quella della banda corrente);
+ * - fading: l'uscita passa linearmente dalla banda corrente a quella nuova;
+ * - completata: coefficienti e stato della nuova banda vanno copiati nel
+ *   motore (BiquadCascade::loadBand).
+ * Il costo è fisso e limitato: una banda in più per warmupMs + fadeMs.
+ * Nessuna allocazione: il buffer d'ombra ha dimensione fissa.
+ */
+class BandCrossfader
+{
+public:
+    static constexpr int maxBands = BiquadCascade::maxBands;
+    static constexpr float warmupMs = 10.0f;
+    static constexpr float fadeMs = 5.0f;
+
+    enum class Phase
+    {
+        idle = 0,
+        pending,    // In attesa dei coefficienti dal worker
+        warming,
+        fading,
+        completed
+    };
+
+    BandCrossfader();
+
+    /**
+     * Imposta le durate in campioni per il sample rate.
+     */
+    void prepare(double sampleRate);
+
+    Phase getPhase(int band) const { return slots[static_cast<size_t>(band)].phase; }
+    bool isActive(int band) const { return getPhase(band) != Phase::idle; }
+    bool isAnyActive() const;
+
+    /**
+     * Segna la banda come in attesa dei coefficienti della sostituta.
+     */
+    void setPending(int band);
+
+    /**
+     * Avvia la transizione con le sezioni della banda sostitutiva (stato nullo).
+     */
+    void begin(int band, const BiquadDesign::SectionArray& sections, int numSections);
+
+    /**
+     * Processa la banda in transizione: la banda corrente nel motore, quella
+     * nuova in ombra, e mescola le uscite in-place in channels.
+     * @return true se la dissolvenza è completata (la banda va consolidata)
+     */
+    bool process(int band, BiquadCascade& cascade, float* const* channels, int numChannels, int numSamples);
+
+    /**
+     * Sezioni e stato della banda sostitutiva, da copiare nel motore.
+     */
+    BiquadKernels::SectionRange getRange(int band);
+
+    /**
+     * Chiude la transizione della banda (dopo il consolidamento o per annullarla).
+     */
+    void finish(int band);
+
+private:
+    static constexpr int maxChannels = BiquadCascade::maxChannels;
+    static constexpr int sectionsPerBand = BiquadCascade::maxSectionsPerBand;
+    static constexpr int shadowSize = 512;
+
+    struct Slot
+    {
+        alignas(16) std::array<float, sectionsPerBand> b0;
+        alignas(16) std::array<float, sectionsPerBand> b1;
+        alignas(16) std::array<float, sectionsPerBand> b2;
+        alignas(16) std::array<float, sectionsPerBand> a1;
+        alignas(16) std::array<float, sectionsPerBand> a2;
+        alignas(16) std::array<float, sectionsPerBand * maxChannels> z1;
+        alignas(16) std::array<float, sectionsPerBand * maxChannels> z2;
+        int numSections = 1;
+        Phase phase = Phase::idle;
+        int warmupRemaining = 0;
+        int fadePosition = 0;
+    };
+
+    void mix(Slot& slot, float* const* output, int numChannels, int numSamples);
+
+    std::array<Slot, maxBands> slots;
+    alignas(16) std::array<std::array<float, shadowSize>, maxChannels> shadow;
+
+    int warmupSamples = 441;
+    int fadeSamples = 220;
+};
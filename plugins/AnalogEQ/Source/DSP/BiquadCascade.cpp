@@ -0,0 +1,251 @@
+#include "BiquadCascade.h"
+#include "KernelDispatch.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <complex>
+
+namespace
+{
+    inline void snapToZero(float& value)
+    {
+        if (!(value < -1.0e-8f || value > 1.0e-8f))
+            value = 0.0f;
+    }
+}
+
+BiquadCascade::BiquadCascade()
+{
+    for (int idx = 0; idx < maxSections; ++idx)
+    {
+        b0[static_cast<size_t>(idx)] = 1.0f;
+        b1[static_cast<size_t>(idx)] = 0.0f;
+        b2[static_cast<size_t>(idx)] = 0.0f;
+        a1[static_cast<size_t>(idx)] = 0.0f;
+        a2[static_cast<size_t>(idx)] = 0.0f;
+    }
+
+    z1.fill(0.0f);
+    z2.fill(0.0f);
+    numSections.fill(1);
+}
+
+void BiquadCascade::setNumSections(int band, int newNumSections)
+{
+    jassert(juce::isPositiveAndBelow(band, maxBands));
+    newNumSections = juce::jlimit(1, maxSectionsPerBand, newNumSections);
+
+    auto& current = numSections[static_cast<size_t>(band)];
+    if (current != newNumSections)
+    {
+        ++revision;
+        ++bandRevision[static_cast<size_t>(band)];
+    }
+
+    for (int section = current; section < newNumSections; ++section)
+    {
+        setSection(band, section, {});
+        resetSection(index(band, section));
+    }
+
+    current = newNumSections;
+}
+
+void BiquadCascade::setSection(int band, int section, const BiquadCoefficients& coefficients)
+{
+    jassert(juce::isPositiveAndBelow(band, maxBands));
+    jassert(juce::isPositiveAndBelow(section, maxSectionsPerBand));
+
+    const auto idx = static_cast<size_t>(index(band, section));
+    if (b0[idx] != coefficients.b0 || b1[idx] != coefficients.b1 || b2[idx] != coefficients.b2
+        || a1[idx] != coefficients.a1 || a2[idx] != coefficients.a2)
+    {
+        ++revision;
+        ++bandRevision[static_cast<size_t>(band)];
+    }
+
+    b0[idx] = coefficients.b0;
+    b1[idx] = coefficients.b1;
+    b2[idx] = coefficients.b2;
+    a1[idx] = coefficients.a1;
+    a2[idx] = coefficients.a2;
+}
+
+void BiquadCascade::loadBand(int band, const BiquadKernels::SectionRange& source)
+{
+    jassert(juce::isPositiveAndBelow(band, maxBands));
+    setNumSections(band, source.numSections);
+
+    for (int section = 0; section < numSections[static_cast<size_t>(band)]; ++section)
+    {
+        setSection(band, section, { source.b0[section], source.b1[section], source.b2[section],
+                                    source.a1[section], source.a2[section] });
+
+        for (int ch = 0; ch < maxChannels; ++ch)
+        {
+            const auto idx = static_cast<size_t>(index(band, section) * maxChannels + ch);
+            z1[idx] = source.z1[section * maxChannels + ch];
+            z2[idx] = source.z2[section * maxChannels + ch];
+        }
+    }
+}
+
+BiquadCoefficients BiquadCascade::getSection(int band, int section) const
+{
+    const auto idx = static_cast<size_t>(index(band, section));
+    return { b0[idx], b1[idx], b2[idx], a1[idx], a2[idx] };
+}
+
+void BiquadCascade::resetSection(int idx)
+{
+    for (int ch = 0; ch < maxChannels; ++ch)
+    {
+        z1[static_cast<size_t>(idx * maxChannels + ch)] = 0.0f;
+        z2[static_cast<size_t>(idx * maxChannels + ch)] = 0.0f;
+    }
+}
+
+void BiquadCascade::resetBand(int band)
+{
+    for (int section = 0; section < maxSectionsPerBand; ++section)
+        resetSection(index(band, section));
+}
+
+void BiquadCascade::reset()
+{
+    z1.fill(0.0f);
+    z2.fill(0.0f);
+}
+
+BiquadKernels::SectionRange BiquadCascade::getRange(int band)
+{
+    const auto first = static_cast<size_t>(index(band, 0));
+    return {
+        b0.data() + first, b1.data() + first, b2.data() + first,
+        a1.data() + first, a2.data() + first,
+        z1.data() + first * maxChannels, z2.data() + first * maxChannels,
+        numSections[static_cast<size_t>(band)]
+    };
+}
+
+void BiquadCascade::snapBandState(int band)
+{
+    const auto range = getRange(band);
+    for (int s = 0; s < range.numSections * maxChannels; ++s)
+    {
+        snapToZero(range.z1[s]);
+        snapToZero(range.z2[s]);
+    }
+}
+
+void BiquadCascade::processBand(int band, float* const* channels, int numChannels, int numSamples)
+{
+    jassert(juce::isPositiveAndBelow(band, maxBands));
+    numChannels = juce::jmin(numChannels, maxChannels);
+
+    const auto range = getRange(band);
+    const auto& kernels = KernelDispatch::getKernels();
+
+    // Blocchi grandi (render offline): motore a blocchi in forma di stato,
+    // tranne quando è forzato il percorso senza SIMD o i poli sono troppo
+    // vicini a z = 1 per le sue matrici in float
+    if (kernels.isa != KernelDispatch::Isa::scalar && BlockStateSpace::isPreferred(range, numSamples))
+    {
+        blockStateSpace.processBand(band, range, bandRevision[static_cast<size_t>(band)],
+                                    channels, numChannels, numSamples);
+    }
+    else if (numChannels == 2)
+    {
+        // Entrambi i canali condividono i coefficienti: un solo passaggio stereo
+        kernels.biquadStereo(range, channels[0], channels[1], numSamples);
+    }
+    else if (numChannels == 1)
+    {
+        kernels.biquadMono(range, 0, channels[0], numSamples);
+    }
+
+    snapBandState(band);
+}
+
+void BiquadCascade::processBandsFused(const int* bands, int numBands, float* const* channels,
+                                      int numChannels, int numSamples, TileStage afterBand,
+                                      void* afterBandContext, unsigned int afterBandMask)
+{
+    numChannels = juce::jmin(numChannels, maxChannels);
+    if (numChannels == 0 || numBands == 0)
+        return;
+
+    std::array<BiquadKernels::SectionRange, maxBands> ranges;
+    numBands = juce::jmin(numBands, maxBands);
+    for (int i = 0; i < numBands; ++i)
+    {
+        jassert(juce::isPositiveAndBelow(bands[i], maxBands));
+        ranges[static_cast<size_t>(i)] = getRange(bands[i]);
+    }
+
+    constexpr int tileSize = BiquadKernels::stereoTileSize;
+    const auto& kernels = KernelDispatch::getKernels();
+
+    if (numChannels == 2)
+    {
+        alignas(16) float frames[2 * tileSize];
+
+        for (int start = 0; start < numSamples; start += tileSize)
+        {
+            const int count = juce::jmin(tileSize, numSamples - start);
+            BiquadKernels::interleaveTile(channels[0] + start, channels[1] + start, frames, count);
+
+            for (int i = 0; i < numBands; ++i)
+            {
+                kernels.biquadStereoFrames(ranges[static_cast<size_t>(i)], frames, count);
+
+                if (afterBand != nullptr && (afterBandMask & (1u << i)) != 0)
+                    afterBand(afterBandContext, i, frames, 2, count);
+            }
+
+            BiquadKernels::deinterleaveTile(frames, channels[0] + start, channels[1] + start, count);
+        }
+    }
+    else
+    {
+        for (int start = 0; start < numSamples; start += tileSize)
+        {
+            const int count = juce::jmin(tileSize, numSamples - start);
+
+            for (int i = 0; i < numBands; ++i)
+            {
+                kernels.biquadMono(ranges[static_cast<size_t>(i)], 0, channels[0] + start, count);
+
+                if (afterBand != nullptr && (afterBandMask & (1u << i)) != 0)
+                    afterBand(afterBandContext, i, channels[0] + start, 1, count);
+            }
+        }
+    }
+
+    for (int i = 0; i < numBands; ++i)
+        snapBandState(bands[i]);
+}
+
+float BiquadCascade::getBandResponseDb(int band, float frequency, double sampleRate) const
+{
+    const std::complex<double> jw = std::exp(std::complex<double>(0.0,
+        -juce::MathConstants<double>::twoPi * static_cast<double>(frequency) / sampleRate));
+    const std::complex<double> jw2 = jw * jw;
+
+    float totalDb = 0.0f;
+    const int first = index(band, 0);
+    const int last = first + numSections[static_cast<size_t>(band)];
+
+    for (int idx = first; idx < last; ++idx)
+    {
+        const auto i = static_cast<size_t>(idx);
+        const auto numerator = static_cast<double>(b0[i])
+                             + static_cast<double>(b1[i]) * jw
+                             + static_cast<double>(b2[i]) * jw2;
+        const auto denominator = 1.0
+                               + static_cast<double>(a1[i]) * jw
+                               + static_cast<double>(a2[i]) * jw2;
+        const auto magnitude = static_cast<float>(std::abs(numerator / denominator));
+        totalDb += juce::Decibels::gainToDecibels(magnitude);
+    }
+
+    return totalDb;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "BiquadKernels.h"
+#include "BlockStateSpace.h"
+#include <array>
+#include <cstddef>
+
+//==============================================================================
+/**
+ * Coefficienti normalizzati (a0 = 1) di una sezione biquad.
+ * Le sezioni del primo ordine usano b2 = a2 = 0.
+ */
+struct BiquadCoefficients
+{
+    float b0 = 1.0f;
+    float b1 = 0.0f;
+    float b2 = 0.0f;
+    float a1 = 0.0f;
+    float a2 = 0.0f;
+};
+
+//==============================================================================
+/**
+ * Motore a cascata di biquad (forma trasposta diretta II) con layout
+ * structure-of-arrays.
+ * Coefficienti e stati di tutte le bande vivono in blocchi contigui allineati
+ * alla cache line, dimensionati per maxBands x maxSectionsPerBand sezioni:
+ * la sezione s della banda b occupa l'indice b * maxSectionsPerBand + s.
+ * Nessuna allocazione dopo la costruzione.
+ */
+class BiquadCascade
+{
+public:
+    static constexpr int maxBands = 8;
+    static constexpr int maxSectionsPerBand = 8;
+    static constexpr int maxSections = maxBands * maxSectionsPerBand;
+    static constexpr int maxChannels = 2;
+
+    BiquadCascade();
+
+    /**
+     * Imposta il numero di sezioni attive di una banda.
+     * Le sezioni aggiunte partono da coefficienti passa-tutto e stato nullo.
+     */
+    void setNumSections(int band, int numSections);
+    int getNumSections(int band) const { return numSections[static_cast<size_t>(band)]; }
+
+    /**
+     * Scrive i coefficienti di una sezione.
+     */
+    void setSection(int band, int section, const BiquadCoefficients& coefficients);
+    BiquadCoefficients getSection(int band, int section) const;
+
+    /**
+     * Sostituisce sezioni e stato di una banda con quelli di source
+     * (es. la banda sostitutiva preparata da BandCrossfader).
+     */
+    void loadBand(int band, const BiquadKernels::SectionRange& source);
+
+    /**
+     * Azzera lo stato di una banda o di tutte le bande.
+     */
+    void resetBand(int band);
+    void reset();
+
+    /**
+     * Processa in-place le sezioni di una banda sui primi numChannels canali.
+     * Il motore viene scelto per blocco: forma di stato a blocchi quando
+     * BlockStateSpace::isPreferred, altrimenti il kernel ricorsivo della ISA
+     * selezionata da KernelDispatch.
+     * @param band L'indice della banda
+     * @param channels Puntatori ai dati di ogni canale
+     * @param numChannels Numero di canali (al massimo maxChannels)
+     * @param numSamples Numero di campioni per canale
+     */
+    void processBand(int band, float* const* channels, int numChannels, int numSamples);
+
+    /**
+     * Stadio applicato ai campioni di un tile dopo una banda (es. saturazione):
+     * frame interleaved con due canali, altrimenti i campioni del canale.
+     * @param context Il puntatore passato a processBandsFused
+     * @param position L'indice della banda in bands
+     */
+    using TileStage = void (*)(void* context, int position, float* samples, int numChannels, int numFrames);
+
+    /**
+     * Processa più bande in un solo passaggio sul buffer: ogni tile di campioni
+     * attraversa tutte le bande (e gli stadi dopo le bande) finché è in cache,
+     * quindi il traffico di memoria non dipende dal numero di bande.
+     * Il risultato è identico a chiamare processBand + stadio per ogni banda.
+     * @param bands Gli indici delle bande, nell'ordine di processamento
+     * @param numBands Il numero di bande
+     * @param afterBand Lo stadio da applicare dopo le bande (può essere nullptr)
+     * @param afterBandContext Passato ad afterBand
+     * @param afterBandMask Bit i: lo stadio viene applicato dopo bands[i]
+     */
+    void processBandsFused(const int* bands, int numBands, float* const* channels,
+                           int numChannels, int numSamples, TileStage afterBand,
+                           void* afterBandContext, unsigned int afterBandMask = ~0u);
+
+    /**
+     * Calcola la risposta in frequenza di una banda.
+     * @return La somma in dB delle risposte delle sezioni attive
+     */
+    float getBandResponseDb(int band, float frequency, double sampleRate) const;
+
+    /**
+     * Contatore incrementato a ogni modifica effettiva di coefficienti o
+     * numero di sezioni; permette di rilevare quando le forme derivate
+     * (es. ParallelFilterBank) vanno ricostruite.
+     */
+    unsigned int getRevision() const { return revision; }
+
+    /** Come getRevision, per una sola banda. */
+    unsigned int getBandRevision(int band) const { return bandRevision[static_cast<size_t>(band)]; }
+
+private:
+    static int index(int band, int section) { return band * maxSectionsPerBand + section; }
+
+    BiquadKernels::SectionRange getRange(int band);
+    void snapBandState(int band);
+
+    alignas(64) std::array<float, maxSections> b0;
+    alignas(64) std::array<float, maxSections> b1;
+    alignas(64) std::array<float, maxSections> b2;
+    alignas(64) std::array<float, maxSections> a1;
+    alignas(64) std::array<float, maxSections> a2;
+
+    // Stati interleaved per canale: [sezione][canale]
+    alignas(64) std::array<float, maxSections * maxChannels> z1;
+    alignas(64) std::array<float, maxSections * maxChannels> z2;
+
+    std::array<int, maxBands> numSections;
+    std::array<unsigned int, maxBands> bandRevision {};
+    unsigned int revision = 0;
+
+    BlockStateSpace blockStateSpace;
+    static_assert(BlockStateSpace::maxOrder >= 2 * maxSectionsPerBand, "Ordine del motore a blocchi insufficiente");
+    static_assert(BlockStateSpace::maxBands >= maxBands, "Bande del motore a blocchi insufficienti");
+
+    void resetSection(int idx);
+};
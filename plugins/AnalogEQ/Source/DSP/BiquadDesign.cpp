@@ -0,0 +1,509 @@
+#include "BiquadDesign.h"
+#include "HighOrderDesign.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cmath>
+
+namespace
+{
+    constexpr float pi = juce::MathConstants<float>::pi;
+
+    /** Normalizza per a0 come juce::dsp::IIR::Coefficients. */
+    BiquadCoefficients normalise(float b0, float b1, float b2, float a0, float a1, float a2)
+    {
+        const float a0inv = a0 != 0.0f ? 1.0f / a0 : 0.0f;
+        return { b0 * a0inv, b1 * a0inv, b2 * a0inv, a1 * a0inv, a2 * a0inv };
+    }
+
+    BiquadCoefficients normaliseFirstOrder(float b0, float b1, float a0, float a1)
+    {
+        const float a0inv = a0 != 0.0f ? 1.0f / a0 : 0.0f;
+        return { b0 * a0inv, b1 * a0inv, 0.0f, a1 * a0inv, 0.0f };
+    }
+
+    constexpr double doublePi = juce::MathConstants<double>::pi;
+
+    double square(double x) { return x * x; }
+
+    /** Pulsazione in radianti per campione. */
+    double toOmega(double sampleRate, float frequency)
+    {
+        return 2.0 * doublePi * static_cast<double>(frequency) / sampleRate;
+    }
+
+    /**
+     * Modulo quadro di un polinomio di secondo grado in z^-1 scritto come
+     * B0 φ0 + B1 φ1 + B2 φ2, con φ1 = sin²(ω/2), φ0 = 1 - φ1, φ2 = 4 φ0 φ1.
+     */
+    struct SquaredMagnitude
+    {
+        double B0 = 0.0, B1 = 0.0, B2 = 0.0;
+
+        double at(double omega) const
+        {
+            const double phi1 = square(std::sin(0.5 * omega));
+            const double phi0 = 1.0 - phi1;
+            return B0 * phi0 + B1 * phi1 + B2 * 4.0 * phi0 * phi1;
+        }
+    };
+
+    struct MatchedPoles
+    {
+        double a1 = 0.0, a2 = 0.0;
+        SquaredMagnitude magnitude;
+    };
+
+    /**
+     * Poli per invarianza all'impulso del prototipo s² + 2ζω s + ω²
+     * (omega in radianti per campione), anche sovrasmorzato.
+     */
+    MatchedPoles matchedPoles(double omega, double zeta)
+    {
+        const double radius = std::exp(-zeta * omega);
+        const double a1 = zeta <= 1.0 ? -2.0 * radius * std::cos(std::sqrt(1.0 - zeta * zeta) * omega)
+                                      : -2.0 * radius * std::cosh(std::sqrt(zeta * zeta - 1.0) * omega);
+        const double a2 = radius * radius;
+
+        return { a1, a2, { square(1.0 + a1 + a2), square(1.0 - a1 + a2), -4.0 * a2 } };
+    }
+
+    /**
+     * Zeri a fase minima con il modulo quadro dato. Se non è realizzabile
+     * (W² + B2 < 0) gli zeri diventano doppi, con continua e Nyquist esatti.
+     */
+    BiquadCoefficients fromSquaredMagnitude(const SquaredMagnitude& numerator, const MatchedPoles& poles)
+    {
+        const double root0 = std::sqrt(juce::jmax(0.0, numerator.B0));
+        const double root1 = std::sqrt(juce::jmax(0.0, numerator.B1));
+        const double w = 0.5 * (root0 + root1);
+        const double d = std::sqrt(juce::jmax(0.0, w * w + numerator.B2));
+
+        return { static_cast<float>(0.5 * (w + d)), static_cast<float>(0.5 * (root0 - root1)),
+                 static_cast<float>(0.5 * (w - d)), static_cast<float>(poles.a1), static_cast<float>(poles.a2) };
+    }
+
+    /**
+     * Zeri che riproducono il modulo quadro del prototipo in continua, a
+     * Nyquist e a omegaMatch. response(Ω) è |H(jΩ)|² del prototipo, con Ω
+     * normalizzata a omega0 (nessuna precompensazione).
+     */
+    template <typename Response>
+    BiquadCoefficients matchThreePoints(const MatchedPoles& poles, double omega0, double omegaMatch, Response&& response)
+    {
+        const double phi1 = square(std::sin(0.5 * omegaMatch));
+        const double phi0 = 1.0 - phi1;
+
+        SquaredMagnitude numerator;
+        numerator.B0 = poles.magnitude.B0 * response(0.0);
+        numerator.B1 = poles.magnitude.B1 * response(doublePi / omega0);
+        numerator.B2 = (poles.magnitude.at(omegaMatch) * response(omegaMatch / omega0)
+                        - numerator.B0 * phi0 - numerator.B1 * phi1) / (4.0 * phi0 * phi1);
+
+        return fromSquaredMagnitude(numerator, poles);
+    }
+
+    /**
+     * |H(jΩ)|² dei prototipi RBJ, con A = sqrt(gainFactor) e Ω normalizzata
+     * alla frequenza del filtro.
+     */
+    double peakResponse(double omega, double A, double q)
+    {
+        const double x = square(1.0 - omega * omega);
+        return (x + square(omega * A / q)) / (x + square(omega / (A * q)));
+    }
+
+    double lowShelfResponse(double omega, double A, double q)
+    {
+        const double slopeTerm = A * square(omega / q);
+        return A * A * (square(A - omega * omega) + slopeTerm) / (square(1.0 - A * omega * omega) + slopeTerm);
+    }
+
+    double highShelfResponse(double omega, double A, double q)
+    {
+        const double slopeTerm = A * square(omega / q);
+        return A * A * (square(1.0 - A * omega * omega) + slopeTerm) / (square(A - omega * omega) + slopeTerm);
+    }
+
+    /** 1 / H(z): per i filtri a fase minima è ancora stabile. */
+    BiquadCoefficients invert(const BiquadCoefficients& c)
+    {
+        const float b0inv = 1.0f / c.b0;
+        return { b0inv, c.a1 * b0inv, c.a2 * b0inv, c.b1 * b0inv, c.b2 * b0inv };
+    }
+
+    /** Punto intermedio dei progetti a tre punti: la frequenza del filtro, lontano da Nyquist. */
+    double matchFrequency(double omega)
+    {
+        return juce::jmin(omega, 0.5 * doublePi);
+    }
+
+    /**
+     * Bell: a slope 0 il biquad RBJ (o matched), altrimenti il Bell di
+     * ordine alto di HighOrderDesign, con gain al centro e larghezza a metà
+     * gain esatti.
+     */
+    int designBell(const BiquadDesign::BandParameters& parameters, double sampleRate, BiquadDesign::SectionArray& sections)
+    {
+        if (parameters.slope > 0)
+            return HighOrderDesign::peak(HighOrderDesign::getBellOrder(parameters.slope), sampleRate,
+                                         parameters.frequency, parameters.q, parameters.gain, sections);
+
+        const auto peak = parameters.method == BiquadDesign::Method::matched ? &BiquadDesign::matchedPeak
+                                                                             : &BiquadDesign::peak;
+        sections[0] = peak(sampleRate, parameters.frequency, parameters.q, juce::Decibels::decibelsToGain(parameters.gain));
+        return 1;
+    }
+
+    /**
+     * Shelf: a 12 dB/ottava il biquad RBJ (o matched), che è già lo shelf
+     * Butterworth del secondo ordine; altrimenti lo shelf di HighOrderDesign.
+     */
+    int designShelf(const BiquadDesign::BandParameters& parameters, double sampleRate, BiquadDesign::SectionArray& sections)
+    {
+        const bool highShelf = parameters.type == FilterType::HighShelf;
+
+        if (parameters.slope != 1)
+            return HighOrderDesign::shelf(highShelf, HighOrderDesign::getShelfOrder(parameters.slope), sampleRate,
+                                          parameters.frequency, parameters.q, parameters.gain, sections);
+
+        const bool matched = parameters.method == BiquadDesign::Method::matched;
+        const auto shelf = highShelf ? (matched ? &BiquadDesign::matchedHighShelf : &BiquadDesign::highShelf)
+                                     : (matched ? &BiquadDesign::matchedLowShelf : &BiquadDesign::lowShelf);
+        sections[0] = shelf(sampleRate, parameters.frequency, parameters.q, juce::Decibels::decibelsToGain(parameters.gain));
+        return 1;
+    }
+
+    /**
+     * Passa-basso/passa-alto: primo ordine a 6 dB/ottava, altrimenti le
+     * sezioni di HighOrderDesign per la risposta scelta. A 12 dB/ottava
+     * Butterworth ed ellittico sono il biquad singolo con il Q della banda.
+     */
+    int designCut(const BiquadDesign::BandParameters& parameters, double sampleRate, BiquadDesign::SectionArray& sections)
+    {
+        const bool highPass = parameters.type == FilterType::HighPass;
+        const int order = HighOrderDesign::getCutOrder(parameters.slope, parameters.response);
+
+        switch (parameters.response)
+        {
+            case BiquadDesign::CutResponse::linkwitzRiley:
+                if (order > 1)
+                    return HighOrderDesign::linkwitzRiley(highPass, order, sampleRate, parameters.frequency,
+                                                          parameters.q, parameters.method, sections);
+                break;
+
+            case BiquadDesign::CutResponse::elliptic:
+                if (parameters.slope > 1)
+                    return HighOrderDesign::elliptic(highPass, order, 6.0f * static_cast<float>(1 << parameters.slope),
+                                                     sampleRate, parameters.frequency, sections);
+                break;
+
+            case BiquadDesign::CutResponse::butterworth:
+            default:
+                break;
+        }
+
+        return HighOrderDesign::butterworth(highPass, order, sampleRate, parameters.frequency, parameters.q,
+                                            parameters.method, sections);
+    }
+}
+
+BiquadCoefficients BiquadDesign::matchedFirstOrderLowPass(double sampleRate, float frequency)
+{
+    // Polo e^-ω; zero scelto per continua unitaria e |H| analogico a Nyquist
+    const double omega = toOmega(sampleRate, juce::jmax(frequency, 2.0f));
+    const double pole = std::exp(-omega);
+    const double nyquist = 1.0 / std::sqrt(1.0 + square(doublePi / omega));
+    const double r0 = 1.0 - pole;
+    const double r1 = (1.0 + pole) * nyquist;
+
+    return { static_cast<float>(0.5 * (r0 + r1)), static_cast<float>(0.5 * (r0 - r1)), 0.0f,
+             static_cast<float>(-pole), 0.0f };
+}
+
+BiquadCoefficients BiquadDesign::matchedFirstOrderHighPass(double sampleRate, float frequency)
+{
+    const double omega = toOmega(sampleRate, juce::jmax(frequency, 2.0f));
+    const double pole = std::exp(-omega);
+    const double nyquistOmega = doublePi / omega;
+    const double r1 = (1.0 + pole) * nyquistOmega / std::sqrt(1.0 + nyquistOmega * nyquistOmega);
+
+    return { static_cast<float>(0.5 * r1), static_cast<float>(-0.5 * r1), 0.0f, static_cast<float>(-pole), 0.0f };
+}
+
+BiquadCoefficients BiquadDesign::matchedLowPass(double sampleRate, float frequency, float q)
+{
+    // Vicanek: un solo zero, continua e Nyquist esatti
+    const double omega = toOmega(sampleRate, juce::jmax(frequency, 2.0f));
+    const auto poles = matchedPoles(omega, 0.5 / static_cast<double>(q));
+    const double f = omega / doublePi;
+    const double r0 = 1.0 + poles.a1 + poles.a2;
+    const double r1 = (1.0 - poles.a1 + poles.a2) * f * f
+                    / std::sqrt(square(1.0 - f * f) + square(f / static_cast<double>(q)));
+    const double b0 = 0.5 * (r0 + r1);
+
+    return { static_cast<float>(b0), static_cast<float>(r0 - b0), 0.0f,
+             static_cast<float>(poles.a1), static_cast<float>(poles.a2) };
+}
+
+BiquadCoefficients BiquadDesign::matchedHighPass(double sampleRate, float frequency, float q)
+{
+    // Vicanek: zero doppio in continua, Nyquist esatto
+    const double omega = toOmega(sampleRate, juce::jmax(frequency, 2.0f));
+    const auto poles = matchedPoles(omega, 0.5 / static_cast<double>(q));
+    const double f = omega / doublePi;
+    const double r1 = (1.0 - poles.a1 + poles.a2)
+                    / std::sqrt(square(1.0 - f * f) + square(f / static_cast<double>(q)));
+    const double b0 = 0.25 * r1;
+
+    return { static_cast<float>(b0), static_cast<float>(-2.0 * b0), static_cast<float>(b0),
+             static_cast<float>(poles.a1), static_cast<float>(poles.a2) };
+}
+
+BiquadCoefficients BiquadDesign::matchedNotch(double sampleRate, float frequency, float q)
+{
+    // Zeri sul cerchio unitario alla frequenza esatta, guadagno unitario in continua
+    const double omega = toOmega(sampleRate, juce::jmax(frequency, 2.0f));
+    const auto poles = matchedPoles(omega, 0.5 / static_cast<double>(q));
+    const double cosOmega = std::cos(omega);
+    const double k = (1.0 + poles.a1 + poles.a2) / (2.0 - 2.0 * cosOmega);
+
+    return { static_cast<float>(k), static_cast<float>(-2.0 * k * cosOmega), static_cast<float>(k),
+             static_cast<float>(poles.a1), static_cast<float>(poles.a2) };
+}
+
+BiquadCoefficients BiquadDesign::matchedPeak(double sampleRate, float frequency, float q, float gainFactor)
+{
+    // Il taglio è l'inverso dell'esaltazione con lo stesso Q: i poli
+    // dell'esaltazione sono meno smorzati, e l'invarianza all'impulso più accurata
+    if (gainFactor > 0.0f && gainFactor < 1.0f)
+        return invert(matchedPeak(sampleRate, frequency, q, 1.0f / gainFactor));
+
+    const double A = std::sqrt(juce::jmax(0.0, static_cast<double>(gainFactor)));
+    const double Q = static_cast<double>(q);
+    const double omega = toOmega(sampleRate, juce::jmax(frequency, 2.0f));
+    const auto poles = matchedPoles(omega, 0.5 / (A * Q));
+
+    // Picco oltre Nyquist: continua, Nyquist e un punto intermedio
+    if (omega >= doublePi)
+        return matchThreePoints(poles, omega, 0.5 * doublePi, [A, Q](double w) { return peakResponse(w, A, Q); });
+
+    // Vicanek: continua unitaria, valore e pendenza nulla al picco
+    const double gainSquared = square(A * A);
+    const double phi1 = square(std::sin(0.5 * omega));
+    const double phi0 = 1.0 - phi1;
+    const auto& denominator = poles.magnitude;
+    const double r1 = denominator.at(omega) * gainSquared;
+    const double r2 = (-denominator.B0 + denominator.B1 + 4.0 * (phi0 - phi1) * denominator.B2) * gainSquared;
+
+    SquaredMagnitude numerator;
+    numerator.B0 = denominator.B0;
+    numerator.B2 = (r1 - r2 * phi1 - numerator.B0) / (4.0 * phi1 * phi1);
+    numerator.B1 = r2 + numerator.B0 + 4.0 * (phi1 - phi0) * numerator.B2;
+
+    return fromSquaredMagnitude(numerator, poles);
+}
+
+BiquadCoefficients BiquadDesign::matchedLowShelf(double sampleRate, float frequency, float q, float gainFactor)
+{
+    // Il taglio è l'inverso dell'esaltazione: poli sempre alla più bassa delle
+    // due frequenze d'angolo, dove l'invarianza all'impulso è accurata
+    if (gainFactor > 0.0f && gainFactor < 1.0f)
+        return invert(matchedLowShelf(sampleRate, frequency, q, 1.0f / gainFactor));
+
+    // Poli del prototipo RBJ a f / sqrt(A)
+    const double A = std::sqrt(juce::jmax(0.0, static_cast<double>(gainFactor)));
+    const double Q = static_cast<double>(q);
+    const double omega = toOmega(sampleRate, juce::jmax(frequency, 2.0f));
+    const auto poles = matchedPoles(omega / std::sqrt(A), 0.5 / Q);
+
+    return matchThreePoints(poles, omega, matchFrequency(omega), [A, Q](double w) { return lowShelfResponse(w, A, Q); });
+}
+
+BiquadCoefficients BiquadDesign::matchedHighShelf(double sampleRate, float frequency, float q, float gainFactor)
+{
+    // Come per il low shelf, ma qui i poli sono in basso nel taglio
+    if (gainFactor > 1.0f)
+        return invert(matchedHighShelf(sampleRate, frequency, q, 1.0f / gainFactor));
+
+    // Poli del prototipo RBJ a f * sqrt(A)
+    const double A = std::sqrt(juce::jmax(0.0, static_cast<double>(gainFactor)));
+    const double Q = static_cast<double>(q);
+    const double omega = toOmega(sampleRate, juce::jmax(frequency, 2.0f));
+    const auto poles = matchedPoles(omega * std::sqrt(A), 0.5 / Q);
+
+    return matchThreePoints(poles, omega, matchFrequency(omega), [A, Q](double w) { return highShelfResponse(w, A, Q); });
+}
+
+BiquadCoefficients BiquadDesign::firstOrderLowPass(double sampleRate, float frequency)
+{
+    const float n = std::tan(pi * frequency / static_cast<float>(sampleRate));
+    return normaliseFirstOrder(n, n, n + 1.0f, n - 1.0f);
+}
+
+BiquadCoefficients BiquadDesign::firstOrderHighPass(double sampleRate, float frequency)
+{
+    const float n = std::tan(pi * frequency / static_cast<float>(sampleRate));
+    return normaliseFirstOrder(1.0f, -1.0f, n + 1.0f, n - 1.0f);
+}
+
+BiquadCoefficients BiquadDesign::lowPass(double sampleRate, float frequency, float q)
+{
+    const float n = 1.0f / std::tan(pi * frequency / static_cast<float>(sampleRate));
+    const float nSquared = n * n;
+    const float invQ = 1.0f / q;
+    const float c1 = 1.0f / (1.0f + invQ * n + nSquared);
+
+    return normalise(c1, c1 * 2.0f, c1,
+                     1.0f, c1 * 2.0f * (1.0f - nSquared), c1 * (1.0f - invQ * n + nSquared));
+}
+
+BiquadCoefficients BiquadDesign::highPass(double sampleRate, float frequency, float q)
+{
+    const float n = std::tan(pi * frequency / static_cast<float>(sampleRate));
+    const float nSquared = n * n;
+    const float invQ = 1.0f / q;
+    const float c1 = 1.0f / (1.0f + invQ * n + nSquared);
+
+    return normalise(c1, c1 * -2.0f, c1,
+                     1.0f, c1 * 2.0f * (nSquared - 1.0f), c1 * (1.0f - invQ * n + nSquared));
+}
+
+BiquadCoefficients BiquadDesign::notch(double sampleRate, float frequency, float q)
+{
+    const float n = 1.0f / std::tan(pi * frequency / static_cast<float>(sampleRate));
+    const float nSquared = n * n;
+    const float invQ = 1.0f / q;
+    const float c1 = 1.0f / (1.0f + n * invQ + nSquared);
+    const float b0 = c1 * (1.0f + nSquared);
+    const float b1 = 2.0f * c1 * (1.0f - nSquared);
+
+    return normalise(b0, b1, b0, 1.0f, b1, c1 * (1.0f - n * invQ + nSquared));
+}
+
+BiquadCoefficients BiquadDesign::peak(double sampleRate, float frequency, float q, float gainFactor)
+{
+    const float A = juce::jmax(0.0f, std::sqrt(gainFactor));
+    const float omega = (2.0f * pi * juce::jmax(frequency, 2.0f)) / static_cast<float>(sampleRate);
+    const float alpha = std::sin(omega) / (q * 2.0f);
+    const float c2 = -2.0f * std::cos(omega);
+    const float alphaTimesA = alpha * A;
+    const float alphaOverA = alpha / A;
+
+    return normalise(1.0f + alphaTimesA, c2, 1.0f - alphaTimesA, 1.0f + alphaOverA, c2, 1.0f - alphaOverA);
+}
+
+BiquadCoefficients BiquadDesign::lowShelf(double sampleRate, float frequency, float q, float gainFactor)
+{
+    const float A = juce::jmax(0.0f, std::sqrt(gainFactor));
+    const float aminus1 = A - 1.0f;
+    const float aplus1 = A + 1.0f;
+    const float omega = (2.0f * pi * juce::jmax(frequency, 2.0f)) / static_cast<float>(sampleRate);
+    const float coso = std::cos(omega);
+    const float beta = std::sin(omega) * std::sqrt(A) / q;
+    const float aminus1TimesCoso = aminus1 * coso;
+
+    return normalise(A * (aplus1 - aminus1TimesCoso + beta),
+                     A * 2.0f * (aminus1 - aplus1 * coso),
+                     A * (aplus1 - aminus1TimesCoso - beta),
+                     aplus1 + aminus1TimesCoso + beta,
+                     -2.0f * (aminus1 + aplus1 * coso),
+                     aplus1 + aminus1TimesCoso - beta);
+}
+
+BiquadCoefficients BiquadDesign::highShelf(double sampleRate, float frequency, float q, float gainFactor)
+{
+    const float A = juce::jmax(0.0f, std::sqrt(gainFactor));
+    const float aminus1 = A - 1.0f;
+    const float aplus1 = A + 1.0f;
+    const float omega = (2.0f * pi * juce::jmax(frequency, 2.0f)) / static_cast<float>(sampleRate);
+    const float coso = std::cos(omega);
+    const float beta = std::sin(omega) * std::sqrt(A) / q;
+    const float aminus1TimesCoso = aminus1 * coso;
+
+    return normalise(A * (aplus1 + aminus1TimesCoso + beta),
+                     A * -2.0f * (aminus1 + aplus1 * coso),
+                     A * (aplus1 + aminus1TimesCoso - beta),
+                     aplus1 - aminus1TimesCoso + beta,
+                     2.0f * (aminus1 - aplus1 * coso),
+                     aplus1 - aminus1TimesCoso - beta);
+}
+
+int BiquadDesign::getNumSections(FilterType type, int slope, CutResponse response)
+{
+    // Passa-basso/passa-alto: ordine 1, 2, 4, 8, 16 (meno sezioni con l'ellittico)
+    if (type == FilterType::LowPass || type == FilterType::HighPass)
+        return HighOrderDesign::getCutSections(slope, response);
+
+    // Bell: una sezione per ordine del prototipo; shelf: due ordini per sezione
+    if (type == FilterType::Bell || type == FilterType::BandPass)
+        return HighOrderDesign::getBellOrder(slope);
+
+    if (type == FilterType::LowShelf || type == FilterType::HighShelf)
+        return (HighOrderDesign::getShelfOrder(slope) + 1) / 2;
+
+    // Notch: ogni livello di slope produce un numero diverso di sezioni
+    switch (slope)
+    {
+        case 0: return 1;   // 6 dB - base
+        case 1: return 2;   // 12 dB - 2 sezioni cascade
+        case 2: return 3;   // 24 dB - 3 sezioni
+        case 3: return 5;   // 48 dB - 5 sezioni
+        case 4: return 8;   // 96 dB - 8 sezioni
+        default: return 1;
+    }
+}
+
+int BiquadDesign::designBand(const BandParameters& parameters, double sampleRate, SectionArray& sections)
+{
+    switch (parameters.type)
+    {
+        case FilterType::LowPass:
+        case FilterType::HighPass:
+            return designCut(parameters, sampleRate, sections);
+
+        case FilterType::LowShelf:
+        case FilterType::HighShelf:
+            return designShelf(parameters, sampleRate, sections);
+
+        case FilterType::Notch:
+            break;
+
+        case FilterType::Bell:
+        case FilterType::BandPass:
+        default:
+            // BandPass da implementare se necessario: usa il Bell
+            return designBell(parameters, sampleRate, sections);
+    }
+
+    // Notch: sezioni identiche in cascata per un notch più profondo/largo
+    const int numSections = getNumSections(parameters.type, parameters.slope, parameters.response);
+    const auto shared = (parameters.method == Method::matched ? matchedNotch : notch)(sampleRate, parameters.frequency, parameters.q);
+
+    for (int i = 0; i < numSections; ++i)
+        sections[static_cast<size_t>(i)] = shared;
+
+    return numSections;
+}
+
+BiquadDesign::BandParameters BiquadDesign::interpolate(const BandParameters& from, const BandParameters& to, float t)
+{
+    auto parameters = to;
+    parameters.frequency = from.frequency * std::pow(to.frequency / from.frequency, t);
+    parameters.gain = from.gain + (to.gain - from.gain) * t;
+    parameters.q = from.q * std::pow(to.q / from.q, t);
+    return parameters;
+}
+
+void BiquadDesign::designInto(BiquadCascade& cascade, int band, const BandParameters& parameters, double sampleRate)
+{
+    SectionArray sections;
+    const int numSections = designBand(parameters, sampleRate, sections);
+
+    loadInto(cascade, band, sections, numSections);
+}
+
+void BiquadDesign::loadInto(BiquadCascade& cascade, int band, const SectionArray& sections, int numSections)
+{
+    cascade.setNumSections(band, numSections);
+    for (int i = 0; i < numSections; ++i)
+        cascade.setSection(band, i, sections[static_cast<size_t>(i)]);
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "BiquadCascade.h"
+#include <array>
+
+//==============================================================================
+/**
+ * Enum per i tipi di filtro disponibili.
+ */
+enum class FilterType
+{
+    LowPass,
+    HighPass,
+    BandPass,
+    Bell,
+    LowShelf,
+    HighShelf,
+    Notch
+};
+
+//==============================================================================
+/**
+ * Progettazione dei coefficienti senza allocazioni.
+ * Le formule (e l'aritmetica in float) sono quelle di
+ * juce::dsp::IIR::Coefficients<float>::make*, inclusa la normalizzazione
+ * per a0, ma il risultato viene restituito per valore invece che in un
+ * oggetto ref-counted allocato sullo heap: si può chiamare dal thread audio.
+ */
+namespace BiquadDesign
+{
+    BiquadCoefficients firstOrderLowPass(double sampleRate, float frequency);
+    BiquadCoefficients firstOrderHighPass(double sampleRate, float frequency);
+    BiquadCoefficients lowPass(double sampleRate, float frequency, float q);
+    BiquadCoefficients highPass(double sampleRate, float frequency, float q);
+    BiquadCoefficients notch(double sampleRate, float frequency, float q);
+    BiquadCoefficients peak(double sampleRate, float frequency, float q, float gainFactor);
+    BiquadCoefficients lowShelf(double sampleRate, float frequency, float q, float gainFactor);
+    BiquadCoefficients highShelf(double sampleRate, float frequency, float q, float gainFactor);
+
+    /**
+     * Progetti "matched" (Vicanek): stessi prototipi analogici delle funzioni
+     * sopra, ma senza la compressione in frequenza della bilineare verso
+     * Nyquist. I poli vengono dall'invarianza all'impulso, gli zeri dal
+     * modulo quadro del prototipo imposto in continua, a Nyquist e in un
+     * punto intermedio (per il Bell: valore e pendenza al picco). Per il
+     * notch gli zeri restano sul cerchio unitario alla frequenza esatta;
+     * Bell e shelf in taglio sono l'inverso dell'esaltazione. Errore
+     * rispetto al prototipo: Tests/MatchedDesignTests.
+     * Calcolo in double: i poli a bassa frequenza sono molto vicini a 1.
+     */
+    BiquadCoefficients matchedFirstOrderLowPass(double sampleRate, float frequency);
+    BiquadCoefficients matchedFirstOrderHighPass(double sampleRate, float frequency);
+    BiquadCoefficients matchedLowPass(double sampleRate, float frequency, float q);
+    BiquadCoefficients matchedHighPass(double sampleRate, float frequency, float q);
+    BiquadCoefficients matchedNotch(double sampleRate, float frequency, float q);
+    BiquadCoefficients matchedPeak(double sampleRate, float frequency, float q, float gainFactor);
+    BiquadCoefficients matchedLowShelf(double sampleRate, float frequency, float q, float gainFactor);
+    BiquadCoefficients matchedHighShelf(double sampleRate, float frequency, float q, float gainFactor);
+
+    /**
+     * Metodo di discretizzazione dei prototipi analogici.
+     * - bilinear: trasformata bilineare (RBJ, come juce::dsp::IIR).
+     * - matched: risposta in modulo del prototipo fino a Nyquist, senza
+     *   sovracampionamento.
+     */
+    enum class Method
+    {
+        bilinear = 0,
+        matched
+    };
+
+    /**
+     * Risposta dei passa-basso/passa-alto oltre i 12 dB/ottava
+     * (HighOrderDesign).
+     * - butterworth: poli sul cerchio, massimamente piatto, -3 dB al taglio.
+     * - linkwitzRiley: Butterworth al quadrato, -6 dB al taglio (crossover).
+     * - elliptic: l'attenuazione nominale a un'ottava dal taglio con il
+     *   minimo numero di sezioni, ripple di 0.1 dB in banda passante.
+     */
+    enum class CutResponse
+    {
+        butterworth = 0,
+        linkwitzRiley,
+        elliptic
+    };
+
+    /** Parametri di una banda, come li vede il thread audio. */
+    struct BandParameters
+    {
+        FilterType type = FilterType::Bell;
+        float frequency = 1000.0f;  // Hz
+        float gain = 0.0f;          // dB
+        float q = 0.707f;
+        int slope = 1;              // 0=6dB, 1=12dB, 2=24dB, 3=48dB, 4=96dB
+        Method method = Method::bilinear;
+        CutResponse response = CutResponse::butterworth;
+    };
+
+    using SectionArray = std::array<BiquadCoefficients, BiquadCascade::maxSectionsPerBand>;
+
+    /**
+     * Numero di sezioni biquad di una banda per tipo, slope e (per i
+     * passa-basso/passa-alto) risposta.
+     */
+    int getNumSections(FilterType type, int slope, CutResponse response = CutResponse::butterworth);
+
+    /**
+     * Progetta tutte le sezioni di una banda.
+     * @param sections Riceve i coefficienti delle prime getNumSections sezioni
+     * @return Il numero di sezioni progettate
+     */
+    int designBand(const BandParameters& parameters, double sampleRate, SectionArray& sections);
+
+    /**
+     * Parametri intermedi tra due progetti dello stesso tipo, slope e risposta:
+     * frequenza e Q in scala logaritmica, gain in dB.
+     * @param t Posizione tra from (0) e to (1)
+     */
+    BandParameters interpolate(const BandParameters& from, const BandParameters& to, float t);
+
+    /**
+     * Progetta la banda e la scrive direttamente nel motore a cascata.
+     */
+    void designInto(BiquadCascade& cascade, int band, const BandParameters& parameters, double sampleRate);
+
+    /**
+     * Scrive nel motore a cascata sezioni già progettate (es. dal DesignWorker).
+     */
+    void loadInto(BiquadCascade& cascade, int band, const SectionArray& sections, int numSections);
+}
@@ -0,0 +1,442 @@
+#pragma once
+
+// Le TU dei kernel per ISA (KernelDispatch) includono questo header con flag
+// di compilazione diversi: ognuna definisce un proprio namespace di target,
+// così le funzioni inline compilate per AVX non possono sostituire quelle
+// del codice base al link. ANALOGEQ_KERNEL_FORCE_SCALAR disattiva le SIMD.
+#ifndef ANALOGEQ_KERNEL_TARGET
+ #define ANALOGEQ_KERNEL_TARGET native
+#endif
+
+#if ANALOGEQ_KERNEL_FORCE_SCALAR
+ // Nessun kernel vettoriale
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define ANALOGEQ_BIQUAD_SSE2 1
+ #include <emmintrin.h>
+ #if defined(__SSE4_1__) || defined(__AVX__)
+  #define ANALOGEQ_BIQUAD_SSE41 1
+  #include <smmintrin.h>
+ #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+ #define ANALOGEQ_BIQUAD_NEON 1
+ #include <arm_neon.h>
+#endif
+
+#include <type_traits>
+
+//==============================================================================
+/**
+ * Kernel di processamento per le sezioni del BiquadCascade
+ * (forma trasposta diretta II, stessa aritmetica di juce::dsp::IIR::Filter).
+ */
+namespace BiquadKernels
+{
+    /**
+     * Vista SoA su un intervallo contiguo di sezioni.
+     * Gli stati z1/z2 sono interleaved [sezione][canale] con 2 canali.
+     */
+    struct SectionRange
+    {
+        const float* b0;
+        const float* b1;
+        const float* b2;
+        const float* a1;
+        const float* a2;
+        float* z1;
+        float* z2;
+        int numSections;
+    };
+
+inline namespace ANALOGEQ_KERNEL_TARGET
+{
+    /** Le sezioni di range a partire da firstSection. */
+    inline SectionRange tail(const SectionRange& range, int firstSection)
+    {
+        return {
+            range.b0 + firstSection, range.b1 + firstSection, range.b2 + firstSection,
+            range.a1 + firstSection, range.a2 + firstSection,
+            range.z1 + 2 * firstSection, range.z2 + 2 * firstSection,
+            range.numSections - firstSection
+        };
+    }
+
+   #if ANALOGEQ_BIQUAD_SSE2
+    inline __m128 loadPair(const float* p)
+    {
+        return _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p));
+    }
+
+    inline void storePair(float* p, __m128 v)
+    {
+        _mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+    }
+   #endif
+
+   #if ANALOGEQ_BIQUAD_SSE2 || ANALOGEQ_BIQUAD_NEON
+    /**
+     * Operazioni vettoriali a 4 lane usate dal kernel a fronte d'onda
+     * e dal motore a blocchi.
+     */
+    namespace Lanes
+    {
+       #if ANALOGEQ_BIQUAD_SSE2
+        using Vec = __m128;
+        inline Vec load(const float* p) { return _mm_loadu_ps(p); }
+        inline void store(float* p, Vec v) { _mm_storeu_ps(p, v); }
+        inline Vec zero() { return _mm_setzero_ps(); }
+        inline Vec broadcast(float x) { return _mm_set1_ps(x); }
+        inline Vec mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+        inline Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+        inline Vec sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+
+        /** { x, v0, v1, v2 }: ogni lane riceve l'uscita della lane precedente. */
+        inline Vec shiftIn(Vec v, float x)
+        {
+            return _mm_move_ss(_mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)), _mm_set_ss(x));
+        }
+
+        inline float last(Vec v) { return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))); }
+
+        using Mask = __m128;
+        inline Mask loadMask(const int* m) { return _mm_castsi128_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(m))); }
+       #if ANALOGEQ_BIQUAD_SSE41
+        inline Vec select(Mask m, Vec a, Vec b) { return _mm_blendv_ps(b, a, m); }
+       #else
+        inline Vec select(Mask m, Vec a, Vec b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+       #endif
+       #else
+        using Vec = float32x4_t;
+        inline Vec load(const float* p) { return vld1q_f32(p); }
+        inline void store(float* p, Vec v) { vst1q_f32(p, v); }
+        inline Vec zero() { return vdupq_n_f32(0.0f); }
+        inline Vec broadcast(float x) { return vdupq_n_f32(x); }
+        inline Vec mul(Vec a, Vec b) { return vmulq_f32(a, b); }
+        inline Vec add(Vec a, Vec b) { return vaddq_f32(a, b); }
+        inline Vec sub(Vec a, Vec b) { return vsubq_f32(a, b); }
+        inline Vec shiftIn(Vec v, float x) { return vextq_f32(vdupq_n_f32(x), v, 3); }
+        inline float last(Vec v) { return vgetq_lane_f32(v, 3); }
+
+        using Mask = uint32x4_t;
+        inline Mask loadMask(const int* m) { return vreinterpretq_u32_s32(vld1q_s32(m)); }
+        inline Vec select(Mask m, Vec a, Vec b) { return vbslq_f32(m, a, b); }
+       #endif
+    }
+
+    constexpr int wavefrontLanes = 4;
+
+    /**
+     * Kernel a fronte d'onda (skewed pipeline) per sezioni in cascata.
+     * Ogni gruppo di 4 sezioni consecutive occupa le 4 lane: al passo t la
+     * lane k processa il campione t - k, prendendo in ingresso l'uscita che
+     * la lane k - 1 ha prodotto al passo precedente. Così le sezioni avanzano
+     * insieme invece di ripercorrere il blocco una alla volta.
+     * I primi e gli ultimi 3 passi (riempimento e svuotamento della pipeline)
+     * aggiornano solo le lane che hanno un campione valido, quindi lo stato
+     * di ogni sezione avanza esattamente di numSamples campioni per blocco e
+     * il risultato è identico, bit per bit, al kernel sezione per sezione.
+     * @param data Puntatori al primo campione di ogni canale
+     * @param firstChannel Indice di canale (negli stati) di data[0]
+     * @param stride Distanza tra campioni consecutivi (2 per frame interleaved)
+     * @return Il numero di sezioni processate (multiplo di 4)
+     */
+    template <int numChannels, int fixedSections = 0>
+    inline int processWavefront(const SectionRange& range, float* const* data, int firstChannel,
+                                int stride, int numSamples)
+    {
+        using namespace Lanes;
+        constexpr int skew = wavefrontLanes - 1;
+        const int numGroups = (fixedSections > 0 ? fixedSections : range.numSections) / wavefrontLanes;
+
+        for (int g = 0; g < numGroups; ++g)
+        {
+            const int s0 = g * wavefrontLanes;
+            const Vec vb0 = load(range.b0 + s0), vb1 = load(range.b1 + s0), vb2 = load(range.b2 + s0);
+            const Vec va1 = load(range.a1 + s0), va2 = load(range.a2 + s0);
+
+            Vec lv1[numChannels], lv2[numChannels], previous[numChannels];
+            for (int c = 0; c < numChannels; ++c)
+            {
+                alignas(16) float gather1[wavefrontLanes], gather2[wavefrontLanes];
+                for (int k = 0; k < wavefrontLanes; ++k)
+                {
+                    gather1[k] = range.z1[2 * (s0 + k) + firstChannel + c];
+                    gather2[k] = range.z2[2 * (s0 + k) + firstChannel + c];
+                }
+
+                lv1[c] = load(gather1);
+                lv2[c] = load(gather2);
+                previous[c] = zero();
+            }
+
+            // Passo di riempimento/svuotamento: solo le lane con 0 <= t - k < numSamples
+            auto maskedStep = [&](int t)
+            {
+                alignas(16) int laneMask[wavefrontLanes];
+                for (int k = 0; k < wavefrontLanes; ++k)
+                    laneMask[k] = (t - k >= 0 && t - k < numSamples) ? -1 : 0;
+
+                const Mask m = loadMask(laneMask);
+
+                for (int c = 0; c < numChannels; ++c)
+                {
+                    const float x = t < numSamples ? data[c][t * stride] : 0.0f;
+                    const Vec input = shiftIn(previous[c], x);
+                    const Vec output = add(mul(input, vb0), lv1[c]);
+                    const Vec next1 = add(sub(mul(input, vb1), mul(output, va1)), lv2[c]);
+                    const Vec next2 = sub(mul(input, vb2), mul(output, va2));
+                    lv1[c] = select(m, next1, lv1[c]);
+                    lv2[c] = select(m, next2, lv2[c]);
+                    previous[c] = output;
+
+                    if (t >= skew && t - skew < numSamples)
+                        data[c][(t - skew) * stride] = last(output);
+                }
+            };
+
+            const int steadyEnd = numSamples > skew ? numSamples : skew;
+
+            for (int t = 0; t < skew; ++t)
+                maskedStep(t);
+
+            for (int t = skew; t < steadyEnd; ++t)
+            {
+                for (int c = 0; c < numChannels; ++c)
+                {
+                    const Vec input = shiftIn(previous[c], data[c][t * stride]);
+                    const Vec output = add(mul(input, vb0), lv1[c]);
+                    lv1[c] = add(sub(mul(input, vb1), mul(output, va1)), lv2[c]);
+                    lv2[c] = sub(mul(input, vb2), mul(output, va2));
+                    previous[c] = output;
+                    data[c][(t - skew) * stride] = last(output);
+                }
+            }
+
+            for (int t = steadyEnd; t < numSamples + skew; ++t)
+                maskedStep(t);
+
+            for (int c = 0; c < numChannels; ++c)
+            {
+                alignas(16) float scatter1[wavefrontLanes], scatter2[wavefrontLanes];
+                store(scatter1, lv1[c]);
+                store(scatter2, lv2[c]);
+
+                for (int k = 0; k < wavefrontLanes; ++k)
+                {
+                    range.z1[2 * (s0 + k) + firstChannel + c] = scatter1[k];
+                    range.z2[2 * (s0 + k) + firstChannel + c] = scatter2[k];
+                }
+            }
+        }
+
+        return numGroups * wavefrontLanes;
+    }
+   #endif
+
+    /**
+     * Processa un singolo canale attraverso tutte le sezioni dell'intervallo.
+     */
+    template <int fixedSections = 0>
+    inline void processMono(const SectionRange& range, int channel, float* data, int numSamples)
+    {
+        const int numSections = fixedSections > 0 ? fixedSections : range.numSections;
+
+       #if ANALOGEQ_BIQUAD_SSE2 || ANALOGEQ_BIQUAD_NEON
+        float* const channels[] = { data };
+        const int firstSection = processWavefront<1, fixedSections>(range, channels, channel, 1, numSamples);
+       #else
+        const int firstSection = 0;
+       #endif
+
+        for (int s = firstSection; s < numSections; ++s)
+        {
+            const float cb0 = range.b0[s], cb1 = range.b1[s], cb2 = range.b2[s];
+            const float ca1 = range.a1[s], ca2 = range.a2[s];
+            float lv1 = range.z1[2 * s + channel];
+            float lv2 = range.z2[2 * s + channel];
+
+            for (int n = 0; n < numSamples; ++n)
+            {
+                const float input = data[n];
+                const float output = input * cb0 + lv1;
+                lv1 = input * cb1 - output * ca1 + lv2;
+                lv2 = input * cb2 - output * ca2;
+                data[n] = output;
+            }
+
+            range.z1[2 * s + channel] = lv1;
+            range.z2[2 * s + channel] = lv2;
+        }
+    }
+
+    /**
+     * Processa in-place un tile di frame stereo interleaved [L0 R0 L1 R1 ...]
+     * attraverso tutte le sezioni dell'intervallo.
+     * I due canali condividono i coefficienti, quindi ogni sezione carica i
+     * coefficienti una volta sola e avanza entrambi gli stati nelle lane SIMD
+     * (SSE2 su x86, NEON su ARM): ogni frame è un singolo load/store a 64 bit.
+     */
+    template <int fixedSections = 0>
+    inline void processStereoFrames(const SectionRange& range, float* frames, int count)
+    {
+        const int numSections = fixedSections > 0 ? fixedSections : range.numSections;
+
+       #if ANALOGEQ_BIQUAD_SSE2 || ANALOGEQ_BIQUAD_NEON
+        // Gruppi di 4 sezioni a fronte d'onda, le restanti sezione per sezione
+        float* const channels[] = { frames, frames + 1 };
+        const int firstSection = processWavefront<2, fixedSections>(range, channels, 0, 2, count);
+       #else
+        const int firstSection = 0;
+       #endif
+
+        for (int s = firstSection; s < numSections; ++s)
+        {
+           #if ANALOGEQ_BIQUAD_SSE2
+            const __m128 vb0 = _mm_set1_ps(range.b0[s]);
+            const __m128 vb1 = _mm_set1_ps(range.b1[s]);
+            const __m128 vb2 = _mm_set1_ps(range.b2[s]);
+            const __m128 va1 = _mm_set1_ps(range.a1[s]);
+            const __m128 va2 = _mm_set1_ps(range.a2[s]);
+            __m128 lv1 = loadPair(range.z1 + 2 * s);
+            __m128 lv2 = loadPair(range.z2 + 2 * s);
+
+            for (int n = 0; n < count; ++n)
+            {
+                float* frame = frames + 2 * n;
+                const __m128 input = loadPair(frame);
+                const __m128 output = _mm_add_ps(_mm_mul_ps(input, vb0), lv1);
+                lv1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(input, vb1), _mm_mul_ps(output, va1)), lv2);
+                lv2 = _mm_sub_ps(_mm_mul_ps(input, vb2), _mm_mul_ps(output, va2));
+                storePair(frame, output);
+            }
+
+            storePair(range.z1 + 2 * s, lv1);
+            storePair(range.z2 + 2 * s, lv2);
+           #elif ANALOGEQ_BIQUAD_NEON
+            const float32x2_t vb0 = vdup_n_f32(range.b0[s]);
+            const float32x2_t vb1 = vdup_n_f32(range.b1[s]);
+            const float32x2_t vb2 = vdup_n_f32(range.b2[s]);
+            const float32x2_t va1 = vdup_n_f32(range.a1[s]);
+            const float32x2_t va2 = vdup_n_f32(range.a2[s]);
+            float32x2_t lv1 = vld1_f32(range.z1 + 2 * s);
+            float32x2_t lv2 = vld1_f32(range.z2 + 2 * s);
+
+            for (int n = 0; n < count; ++n)
+            {
+                const float32x2_t input = vld1_f32(frames + 2 * n);
+                const float32x2_t output = vadd_f32(vmul_f32(input, vb0), lv1);
+                lv1 = vadd_f32(vsub_f32(vmul_f32(input, vb1), vmul_f32(output, va1)), lv2);
+                lv2 = vsub_f32(vmul_f32(input, vb2), vmul_f32(output, va2));
+                vst1_f32(frames + 2 * n, output);
+            }
+
+            vst1_f32(range.z1 + 2 * s, lv1);
+            vst1_f32(range.z2 + 2 * s, lv2);
+           #else
+            const float cb0 = range.b0[s], cb1 = range.b1[s], cb2 = range.b2[s];
+            const float ca1 = range.a1[s], ca2 = range.a2[s];
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                float lv1 = range.z1[2 * s + channel];
+                float lv2 = range.z2[2 * s + channel];
+
+                for (int n = 0; n < count; ++n)
+                {
+                    const float input = frames[2 * n + channel];
+                    const float output = input * cb0 + lv1;
+                    lv1 = input * cb1 - output * ca1 + lv2;
+                    lv2 = input * cb2 - output * ca2;
+                    frames[2 * n + channel] = output;
+                }
+
+                range.z1[2 * s + channel] = lv1;
+                range.z2[2 * s + channel] = lv2;
+            }
+           #endif
+        }
+    }
+
+    /** Numero di frame stereo per tile: 512 byte, sempre residenti in L1. */
+    constexpr int stereoTileSize = 64;
+
+    inline void interleaveTile(const float* left, const float* right, float* frames, int count)
+    {
+        for (int n = 0; n < count; ++n)
+        {
+            frames[2 * n] = left[n];
+            frames[2 * n + 1] = right[n];
+        }
+    }
+
+    inline void deinterleaveTile(const float* frames, float* left, float* right, int count)
+    {
+        for (int n = 0; n < count; ++n)
+        {
+            left[n] = frames[2 * n];
+            right[n] = frames[2 * n + 1];
+        }
+    }
+
+    /**
+     * Processa L e R insieme. I gruppi di 4 sezioni girano a fronte d'onda
+     * sull'intero blocco; le sezioni restanti vengono interleaved in tile
+     * sullo stack.
+     */
+    template <int fixedSections = 0>
+    inline void processStereo(const SectionRange& range, float* left, float* right, int numSamples)
+    {
+       #if ANALOGEQ_BIQUAD_SSE2 || ANALOGEQ_BIQUAD_NEON
+        constexpr int fixedRest = fixedSections > 0 ? fixedSections % wavefrontLanes : 0;
+        const int numSections = fixedSections > 0 ? fixedSections : range.numSections;
+        float* const channels[] = { left, right };
+        const int firstSection = processWavefront<2, fixedSections>(range, channels, 0, 1, numSamples);
+
+        SectionRange rest = tail(range, firstSection);
+        rest.numSections = numSections - firstSection;
+
+        if (rest.numSections == 0)
+            return;
+
+        alignas(16) float frames[2 * stereoTileSize];
+
+        for (int start = 0; start < numSamples; start += stereoTileSize)
+        {
+            const int count = (numSamples - start < stereoTileSize) ? (numSamples - start) : stereoTileSize;
+
+            interleaveTile(left + start, right + start, frames, count);
+            processStereoFrames<fixedRest>(rest, frames, count);
+            deinterleaveTile(frames, left + start, right + start, count);
+        }
+       #else
+        processMono<fixedSections>(range, 0, left, numSamples);
+        processMono<fixedSections>(range, 1, right, numSamples);
+       #endif
+    }
+
+    /** Numero massimo di sezioni per cui esistono kernel specializzati. */
+    constexpr int maxSpecializedSections = 8;
+
+    /**
+     * Chiama fn con il numero di sezioni come costante di compilazione
+     * (std::integral_constant), così ogni kernel viene istanziato per 1-8
+     * sezioni e il compilatore può srotolare i cicli sulle sezioni.
+     * Oltre maxSpecializedSections passa 0, cioè il conteggio a runtime.
+     */
+    template <typename Function>
+    inline void dispatchSectionCount(int numSections, Function&& fn)
+    {
+        switch (numSections)
+        {
+            case 1: fn(std::integral_constant<int, 1> {}); break;
+            case 2: fn(std::integral_constant<int, 2> {}); break;
+            case 3: fn(std::integral_constant<int, 3> {}); break;
+            case 4: fn(std::integral_constant<int, 4> {}); break;
+            case 5: fn(std::integral_constant<int, 5> {}); break;
+            case 6: fn(std::integral_constant<int, 6> {}); break;
+            case 7: fn(std::integral_constant<int, 7> {}); break;
+            case 8: fn(std::integral_constant<int, 8> {}); break;
+            default: fn(std::integral_constant<int, 0> {}); break;
+        }
+    }
+} // inline namespace ANALOGEQ_KERNEL_TARGET
+}
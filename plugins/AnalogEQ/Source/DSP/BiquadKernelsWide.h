@@ -0,0 +1,283 @@
+#pragma once
+
+#include "BiquadKernels.h"
+
+#if ANALOGEQ_BIQUAD_SSE2 && defined(__AVX2__)
+ #define ANALOGEQ_BIQUAD_AVX2 1
+ #include <immintrin.h>
+ #if defined(__AVX512F__)
+  #define ANALOGEQ_BIQUAD_AVX512 1
+ #endif
+#endif
+
+//==============================================================================
+/**
+ * Kernel a fronte d'onda su registri larghi (8 sezioni per canale), usati
+ * solo dalle TU dei kernel AVX2/AVX-512 di KernelDispatch.
+ * Stessa aritmetica del kernel a 4 lane (nessuna FMA), quindi risultati
+ * identici bit per bit.
+ */
+namespace BiquadKernels
+{
+inline namespace ANALOGEQ_KERNEL_TARGET
+{
+   #if ANALOGEQ_BIQUAD_AVX2
+    namespace WideLanes
+    {
+        /** 8 sezioni consecutive di un canale in un registro a 256 bit. */
+        struct Avx2
+        {
+            using Vec = __m256;
+            using Mask = __m256;
+            static constexpr int sections = 8;
+            static constexpr int packedChannels = 1;
+
+            static Vec coefficients(const float* p) { return _mm256_loadu_ps(p); }
+            static Vec mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+            static Vec add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+            static Vec sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+            static Vec zero() { return _mm256_setzero_ps(); }
+            static Vec select(Mask m, Vec a, Vec b) { return _mm256_blendv_ps(b, a, m); }
+
+            /** { x, v0, ..., v6 } */
+            static Vec shiftIn(Vec v, const float* x)
+            {
+                const __m256i up = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+                return _mm256_blend_ps(_mm256_permutevar8x32_ps(v, up), _mm256_set1_ps(x[0]), 0x01);
+            }
+
+            static void storeLast(Vec v, float* const* data, int index)
+            {
+                const __m128 high = _mm256_extractf128_ps(v, 1);
+                data[0][index] = _mm_cvtss_f32(_mm_shuffle_ps(high, high, _MM_SHUFFLE(3, 3, 3, 3)));
+            }
+
+            /** Lane k attiva se 0 <= t - k < numSamples. */
+            static Mask mask(int t, int numSamples)
+            {
+                const __m256i sample = _mm256_sub_epi32(_mm256_set1_epi32(t), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+                const __m256i valid = _mm256_and_si256(_mm256_cmpgt_epi32(sample, _mm256_set1_epi32(-1)),
+                                                       _mm256_cmpgt_epi32(_mm256_set1_epi32(numSamples), sample));
+                return _mm256_castsi256_ps(valid);
+            }
+
+            static Vec loadState(const float* z, int s0, int channel)
+            {
+                alignas(32) float gather[sections];
+                for (int k = 0; k < sections; ++k)
+                    gather[k] = z[2 * (s0 + k) + channel];
+                return _mm256_load_ps(gather);
+            }
+
+            static void storeState(float* z, int s0, int channel, Vec v)
+            {
+                alignas(32) float scatter[sections];
+                _mm256_store_ps(scatter, v);
+                for (int k = 0; k < sections; ++k)
+                    z[2 * (s0 + k) + channel] = scatter[k];
+            }
+        };
+
+       #if ANALOGEQ_BIQUAD_AVX512
+        /**
+         * 8 sezioni di due canali in un registro a 512 bit: il canale 0 nelle
+         * lane 0-7, il canale 1 nelle lane 8-15. I coefficienti sono condivisi,
+         * quindi uno stesso passo avanza entrambi i canali.
+         * Le varianti maskz delle permutazioni evitano i falsi -Wuninitialized
+         * degli header AVX-512 di GCC 12.
+         */
+        struct Avx512Stereo
+        {
+            using Vec = __m512;
+            using Mask = __mmask16;
+            static constexpr int sections = 8;
+            static constexpr int packedChannels = 2;
+
+            static Vec coefficients(const float* p)
+            {
+                const __m512i twice = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7);
+                return _mm512_maskz_permutexvar_ps(0xffff, twice, _mm512_maskz_loadu_ps(0x00ff, p));
+            }
+
+            static Vec mul(Vec a, Vec b) { return _mm512_mul_ps(a, b); }
+            static Vec add(Vec a, Vec b) { return _mm512_add_ps(a, b); }
+            static Vec sub(Vec a, Vec b) { return _mm512_sub_ps(a, b); }
+            static Vec zero() { return _mm512_setzero_ps(); }
+            static Vec select(Mask m, Vec a, Vec b) { return _mm512_mask_blend_ps(m, b, a); }
+
+            static Vec shiftIn(Vec v, const float* x)
+            {
+                const __m512i up = _mm512_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6, 8, 8, 9, 10, 11, 12, 13, 14);
+                const Vec shifted = _mm512_maskz_permutexvar_ps(0xffff, up, v);
+                return _mm512_mask_broadcastss_ps(_mm512_mask_broadcastss_ps(shifted, 0x0001, _mm_set_ss(x[0])),
+                                                  0x0100, _mm_set_ss(x[1]));
+            }
+
+            static void storeLast(Vec v, float* const* data, int index)
+            {
+                // Lane 7 e 15 nelle prime due lane
+                const __m512i lastLanes = _mm512_setr_epi32(7, 15, 7, 15, 7, 15, 7, 15, 7, 15, 7, 15, 7, 15, 7, 15);
+                const __m128 pair = _mm512_maskz_extractf32x4_ps(0x0f, _mm512_maskz_permutexvar_ps(0xffff, lastLanes, v), 0);
+                data[0][index] = _mm_cvtss_f32(pair);
+                data[1][index] = _mm_cvtss_f32(_mm_shuffle_ps(pair, pair, _MM_SHUFFLE(1, 1, 1, 1)));
+            }
+
+            static Mask mask(int t, int numSamples)
+            {
+                unsigned int bits = 0;
+                for (int k = 0; k < sections; ++k)
+                    if (t - k >= 0 && t - k < numSamples)
+                        bits |= 1u << k;
+                return static_cast<Mask>(bits | (bits << sections));
+            }
+
+            static Vec loadState(const float* z, int s0, int channel)
+            {
+                alignas(64) float gather[2 * sections];
+                for (int k = 0; k < sections; ++k)
+                {
+                    gather[k] = z[2 * (s0 + k) + channel];
+                    gather[sections + k] = z[2 * (s0 + k) + channel + 1];
+                }
+                return _mm512_load_ps(gather);
+            }
+
+            static void storeState(float* z, int s0, int channel, Vec v)
+            {
+                alignas(64) float scatter[2 * sections];
+                _mm512_store_ps(scatter, v);
+                for (int k = 0; k < sections; ++k)
+                {
+                    z[2 * (s0 + k) + channel] = scatter[k];
+                    z[2 * (s0 + k) + channel + 1] = scatter[sections + k];
+                }
+            }
+        };
+       #endif
+    }
+
+    /**
+     * Come processWavefront, con gruppi di Lanes::sections sezioni.
+     * @return Il numero di sezioni processate (multiplo di Lanes::sections)
+     */
+    template <typename Lanes, int numChannels, int fixedSections = 0>
+    inline int processWavefrontWide(const SectionRange& range, float* const* data, int firstChannel,
+                                    int stride, int numSamples)
+    {
+        static_assert(numChannels % Lanes::packedChannels == 0, "Canali non divisibili tra i registri");
+        using Vec = typename Lanes::Vec;
+        constexpr int numVecs = numChannels / Lanes::packedChannels;
+        constexpr int skew = Lanes::sections - 1;
+        const int numGroups = (fixedSections > 0 ? fixedSections : range.numSections) / Lanes::sections;
+
+        for (int g = 0; g < numGroups; ++g)
+        {
+            const int s0 = g * Lanes::sections;
+            const Vec vb0 = Lanes::coefficients(range.b0 + s0), vb1 = Lanes::coefficients(range.b1 + s0);
+            const Vec vb2 = Lanes::coefficients(range.b2 + s0);
+            const Vec va1 = Lanes::coefficients(range.a1 + s0), va2 = Lanes::coefficients(range.a2 + s0);
+
+            Vec lv1[numVecs], lv2[numVecs], previous[numVecs];
+            for (int v = 0; v < numVecs; ++v)
+            {
+                lv1[v] = Lanes::loadState(range.z1, s0, firstChannel + v * Lanes::packedChannels);
+                lv2[v] = Lanes::loadState(range.z2, s0, firstChannel + v * Lanes::packedChannels);
+                previous[v] = Lanes::zero();
+            }
+
+            auto maskedStep = [&](int t)
+            {
+                const auto m = Lanes::mask(t, numSamples);
+
+                for (int v = 0; v < numVecs; ++v)
+                {
+                    float* const* channels = data + v * Lanes::packedChannels;
+                    float x[Lanes::packedChannels];
+                    for (int c = 0; c < Lanes::packedChannels; ++c)
+                        x[c] = t < numSamples ? channels[c][t * stride] : 0.0f;
+
+                    const Vec input = Lanes::shiftIn(previous[v], x);
+                    const Vec output = Lanes::add(Lanes::mul(input, vb0), lv1[v]);
+                    const Vec next1 = Lanes::add(Lanes::sub(Lanes::mul(input, vb1), Lanes::mul(output, va1)), lv2[v]);
+                    const Vec next2 = Lanes::sub(Lanes::mul(input, vb2), Lanes::mul(output, va2));
+                    lv1[v] = Lanes::select(m, next1, lv1[v]);
+                    lv2[v] = Lanes::select(m, next2, lv2[v]);
+                    previous[v] = output;
+
+                    if (t >= skew && t - skew < numSamples)
+                        Lanes::storeLast(output, channels, (t - skew) * stride);
+                }
+            };
+
+            const int steadyEnd = numSamples > skew ? numSamples : skew;
+
+            for (int t = 0; t < skew; ++t)
+                maskedStep(t);
+
+            for (int t = skew; t < steadyEnd; ++t)
+            {
+                for (int v = 0; v < numVecs; ++v)
+                {
+                    float* const* channels = data + v * Lanes::packedChannels;
+                    float x[Lanes::packedChannels];
+                    for (int c = 0; c < Lanes::packedChannels; ++c)
+                        x[c] = channels[c][t * stride];
+
+                    const Vec input = Lanes::shiftIn(previous[v], x);
+                    const Vec output = Lanes::add(Lanes::mul(input, vb0), lv1[v]);
+                    lv1[v] = Lanes::add(Lanes::sub(Lanes::mul(input, vb1), Lanes::mul(output, va1)), lv2[v]);
+                    lv2[v] = Lanes::sub(Lanes::mul(input, vb2), Lanes::mul(output, va2));
+                    previous[v] = output;
+                    Lanes::storeLast(output, channels, (t - skew) * stride);
+                }
+            }
+
+            for (int t = steadyEnd; t < numSamples + skew; ++t)
+                maskedStep(t);
+
+            for (int v = 0; v < numVecs; ++v)
+            {
+                Lanes::storeState(range.z1, s0, firstChannel + v * Lanes::packedChannels, lv1[v]);
+                Lanes::storeState(range.z2, s0, firstChannel + v * Lanes::packedChannels, lv2[v]);
+            }
+        }
+
+        return numGroups * Lanes::sections;
+    }
+
+    /**
+     * Gruppi larghi sull'intero blocco, poi le sezioni restanti con il
+     * kernel a 4 lane.
+     */
+    template <typename StereoLanes, int fixedSections = 0>
+    inline void processStereoWide(const SectionRange& range, float* left, float* right, int numSamples)
+    {
+        constexpr int fixedRest = fixedSections > 0 ? fixedSections % StereoLanes::sections : 0;
+        float* const channels[] = { left, right };
+        const int firstSection = processWavefrontWide<StereoLanes, 2, fixedSections>(range, channels, 0, 1, numSamples);
+
+        processStereo<fixedRest>(tail(range, firstSection), left, right, numSamples);
+    }
+
+    template <typename StereoLanes, int fixedSections = 0>
+    inline void processStereoFramesWide(const SectionRange& range, float* frames, int count)
+    {
+        constexpr int fixedRest = fixedSections > 0 ? fixedSections % StereoLanes::sections : 0;
+        float* const channels[] = { frames, frames + 1 };
+        const int firstSection = processWavefrontWide<StereoLanes, 2, fixedSections>(range, channels, 0, 2, count);
+
+        processStereoFrames<fixedRest>(tail(range, firstSection), frames, count);
+    }
+
+    template <int fixedSections = 0>
+    inline void processMonoWide(const SectionRange& range, int channel, float* data, int numSamples)
+    {
+        constexpr int fixedRest = fixedSections > 0 ? fixedSections % WideLanes::Avx2::sections : 0;
+        float* const channels[] = { data };
+        const int firstSection = processWavefrontWide<WideLanes::Avx2, 1, fixedSections>(range, channels, channel, 1, numSamples);
+
+        processMono<fixedRest>(tail(range, firstSection), channel, data, numSamples);
+    }
+   #endif
+} // inline namespace ANALOGEQ_KERNEL_TARGET
+}
@@ -0,0 +1,192 @@
+#include "BlockStateSpace.h"
+#include <juce_core/juce_core.h>
+
+namespace
+{
+    /**
+     * Un passo della cascata in double, con lo stesso ordine di stato del
+     * motore ricorsivo: state[2k] = z1, state[2k + 1] = z2 della sezione k.
+     */
+    double stepCascade(const BiquadKernels::SectionRange& range, double* state, double input)
+    {
+        double value = input;
+
+        for (int s = 0; s < range.numSections; ++s)
+        {
+            const double output = static_cast<double>(range.b0[s]) * value + state[2 * s];
+            state[2 * s] = static_cast<double>(range.b1[s]) * value - static_cast<double>(range.a1[s]) * output + state[2 * s + 1];
+            state[2 * s + 1] = static_cast<double>(range.b2[s]) * value - static_cast<double>(range.a2[s]) * output;
+            value = output;
+        }
+
+        return value;
+    }
+}
+
+void BlockStateSpace::build(BandMatrices& m, const BiquadKernels::SectionRange& range)
+{
+    constexpr int L = blockLength;
+    m.order = juce::jmin(2 * range.numSections, maxOrder);
+
+    m.impulse.fill(0.0f);
+    m.observation.fill(0.0f);
+    m.transition.fill(0.0f);
+    m.input.fill(0.0f);
+
+    std::array<double, maxOrder> state {};
+
+    // Impulso al campione 0: dopo n + 1 passi lo stato vale A^n B, cioè la
+    // colonna di K per un impulso al campione L - 1 - n
+    for (int n = 0; n < L; ++n)
+    {
+        m.impulse[static_cast<size_t>(L + n)] = static_cast<float>(stepCascade(range, state.data(), n == 0 ? 1.0 : 0.0));
+
+        for (int r = 0; r < m.order; ++r)
+            m.input[static_cast<size_t>((L - 1 - n) * maxOrder + r)] = static_cast<float>(state[static_cast<size_t>(r)]);
+    }
+
+    // Evoluzione libera da ogni stato unitario
+    for (int j = 0; j < m.order; ++j)
+    {
+        state.fill(0.0);
+        state[static_cast<size_t>(j)] = 1.0;
+
+        for (int n = 0; n < L; ++n)
+            m.observation[static_cast<size_t>(j * L + n)] = static_cast<float>(stepCascade(range, state.data(), 0.0));
+
+        for (int r = 0; r < m.order; ++r)
+            m.transition[static_cast<size_t>(j * maxOrder + r)] = static_cast<float>(state[static_cast<size_t>(r)]);
+    }
+
+    m.built = true;
+}
+
+#if ANALOGEQ_BIQUAD_SSE2 || ANALOGEQ_BIQUAD_NEON
+namespace
+{
+    /**
+     * Tile in forma di stato con numero di gruppi di stato noto a compile
+     * time: tutti gli accumulatori restano nei registri.
+     */
+    template <int stateGroups, int L, int maxOrder>
+    void processStateSpaceTiles(const float* impulse, const float* observation, const float* transition,
+                                const float* input, int order, float* state, float* data, int numTiles)
+    {
+        using namespace BiquadKernels::Lanes;
+        constexpr int lanes = BiquadKernels::wavefrontLanes;
+        constexpr int outputGroups = L / lanes;
+
+        for (int tile = 0; tile < numTiles; ++tile)
+        {
+            float* y = data + tile * L;
+
+            // Accumulatori indipendenti per ogni gruppo di 4 uscite e di 4 stati,
+            // così ogni broadcast viene riusato e le somme non formano una catena
+            Vec out[outputGroups], next[stateGroups];
+            for (int g = 0; g < outputGroups; ++g)
+                out[g] = zero();
+            for (int r = 0; r < stateGroups; ++r)
+                next[r] = zero();
+
+            // Contributo dello stato: O s e A^L s
+            for (int j = 0; j < order; ++j)
+            {
+                const Vec sj = broadcast(state[j]);
+
+                for (int g = 0; g < outputGroups; ++g)
+                    out[g] = add(out[g], mul(load(observation + j * L + g * lanes), sj));
+
+                for (int r = 0; r < stateGroups; ++r)
+                    next[r] = add(next[r], mul(load(transition + j * maxOrder + r * lanes), sj));
+            }
+
+            // Contributo dell'ingresso: T x (la parte sopra la diagonale di T
+            // legge gli zeri che precedono la risposta all'impulso) e K x
+            for (int i = 0; i < L; ++i)
+            {
+                const Vec xi = broadcast(y[i]);
+
+                for (int g = 0; g < outputGroups; ++g)
+                    out[g] = add(out[g], mul(load(impulse + L + g * lanes - i), xi));
+
+                for (int r = 0; r < stateGroups; ++r)
+                    next[r] = add(next[r], mul(load(input + i * maxOrder + r * lanes), xi));
+            }
+
+            for (int g = 0; g < outputGroups; ++g)
+                store(y + g * lanes, out[g]);
+
+            for (int r = 0; r < stateGroups; ++r)
+                store(state + r * lanes, next[r]);
+        }
+    }
+}
+#endif
+
+void BlockStateSpace::processTiles(const BandMatrices& m, float* state, float* data, int numTiles)
+{
+   #if ANALOGEQ_BIQUAD_SSE2 || ANALOGEQ_BIQUAD_NEON
+    constexpr int lanes = BiquadKernels::wavefrontLanes;
+    const auto* impulse = m.impulse.data();
+    const auto* observation = m.observation.data();
+    const auto* transition = m.transition.data();
+    const auto* input = m.input.data();
+
+    switch ((m.order + lanes - 1) / lanes)
+    {
+        case 1: processStateSpaceTiles<1, blockLength, maxOrder>(impulse, observation, transition, input, m.order, state, data, numTiles); break;
+        case 2: processStateSpaceTiles<2, blockLength, maxOrder>(impulse, observation, transition, input, m.order, state, data, numTiles); break;
+        case 3: processStateSpaceTiles<3, blockLength, maxOrder>(impulse, observation, transition, input, m.order, state, data, numTiles); break;
+        case 4: processStateSpaceTiles<4, blockLength, maxOrder>(impulse, observation, transition, input, m.order, state, data, numTiles); break;
+        default: jassertfalse; break;
+    }
+   #else
+    juce::ignoreUnused(m, state, data, numTiles);
+    jassertfalse;
+   #endif
+}
+
+void BlockStateSpace::processBand(int band, const BiquadKernels::SectionRange& range, unsigned int bandRevision,
+                                  float* const* channels, int numChannels, int numSamples)
+{
+    jassert(juce::isPositiveAndBelow(band, maxBands));
+    jassert(range.numSections * 2 <= maxOrder);
+    numChannels = juce::jmin(numChannels, maxChannels);
+
+    auto& m = matrices[static_cast<size_t>(band)];
+    if (!m.built || m.revision != bandRevision)
+    {
+        build(m, range);
+        m.revision = bandRevision;
+    }
+
+    const int numTiles = numSamples / blockLength;
+    const int done = numTiles * blockLength;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        alignas(16) float state[maxOrder] = {};
+        for (int s = 0; s < range.numSections; ++s)
+        {
+            state[2 * s] = range.z1[2 * s + ch];
+            state[2 * s + 1] = range.z2[2 * s + ch];
+        }
+
+        processTiles(m, state, channels[ch], numTiles);
+
+        for (int s = 0; s < range.numSections; ++s)
+        {
+            range.z1[2 * s + ch] = state[2 * s];
+            range.z2[2 * s + ch] = state[2 * s + 1];
+        }
+    }
+
+    // Coda più corta di un tile: percorso ricorsivo, stati condivisi
+    if (done < numSamples)
+    {
+        if (numChannels == 2)
+            BiquadKernels::processStereo(range, channels[0] + done, channels[1] + done, numSamples - done);
+        else if (numChannels == 1)
+            BiquadKernels::processMono(range, 0, channels[0] + done, numSamples - done);
+    }
+}
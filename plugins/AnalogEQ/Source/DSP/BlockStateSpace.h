@@ -0,0 +1,130 @@
+#pragma once
+
+#include "BiquadKernels.h"
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+//==============================================================================
+/**
+ * Motore IIR a blocchi in forma di stato per blocchi grandi.
+ *
+ * L'intera cascata di una banda viene descritta come sistema lineare con
+ * stato s = [z1_0, z2_0, z1_1, z2_1, ...] (gli stessi stati TDF-II del
+ * BiquadCascade, quindi si può passare da un motore all'altro a ogni blocco).
+ * Per un tile di blockLength campioni:
+ *   y     = O s + T x          (T triangolare di Toeplitz con la risposta all'impulso)
+ *   s_new = A^L s + K x
+ * Sono solo prodotti matrice-vettore densi, senza dipendenze campione per
+ * campione, quindi vettorizzano bene. Le matrici vengono calcolate in double
+ * simulando la cascata e salvate in float.
+ *
+ * Con poli vicini a z = 1 (bande sotto qualche centinaio di Hz) o al
+ * cerchio unitario (Q alto) l'arrotondamento delle matrici in float pesa
+ * molto, e l'uscita si scosta da quella del percorso ricorsivo fino a 6e-3
+ * del fondo scala (a 20 Hz): isPreferred esclude queste bande, che restano
+ * sul kernel ricorsivo qualunque sia il blocco. Per le bande ammesse la
+ * differenza dal percorso ricorsivo resta sotto 1e-4 del fondo scala
+ * (misurato: 4e-5 con rumore a -6 dBFS); Tests/BlockStateSpaceTests la
+ * verifica su una griglia di bande.
+ *
+ * Con 4 lane (SSE2/NEON) conviene solo per bande da 2-3 sezioni: da 4
+ * sezioni in su il kernel a fronte d'onda è più veloce, con 1 sezione lo è
+ * il kernel ricorsivo.
+ */
+class BlockStateSpace
+{
+public:
+    static constexpr int blockLength = 16;
+    static constexpr int maxOrder = 16;
+    static constexpr int maxBands = 8;
+    static constexpr int maxChannels = 2;
+
+    /** Blocco minimo e numero di sezioni per cui conviene il motore a blocchi. */
+    static constexpr int minBlockSize = 256;
+    static constexpr int minSections = 2;
+    static constexpr int maxSections = 3;
+
+    /**
+     * Indica se il motore è disponibile (richiede SSE2 o NEON).
+     */
+    static constexpr bool isAvailable()
+    {
+       #if ANALOGEQ_BIQUAD_SSE2 || ANALOGEQ_BIQUAD_NEON
+        return true;
+       #else
+        return false;
+       #endif
+    }
+
+    /**
+     * Distanze minime dei poli di ogni sezione da z = 1, come
+     * |1 + a1 + a2| = |1 - p1| |1 - p2|, e dal cerchio unitario, come
+     * 1 - a2 (1 - |p|² per poli complessi), sotto cui il motore a blocchi
+     * non è abbastanza accurato.
+     */
+    static constexpr float minDistanceFromDc = 2.0e-3f;
+    static constexpr float minDistanceFromUnitCircle = 1.0e-2f;
+
+    /**
+     * Indica se conviene il motore a blocchi per un numero di sezioni e un blocco.
+     */
+    static constexpr bool isPreferred(int numSections, int numSamples)
+    {
+        return isAvailable()
+            && numSamples >= minBlockSize
+            && numSections >= minSections
+            && numSections <= maxSections;
+    }
+
+    /**
+     * Come sopra, ma esclude le bande con poli troppo vicini a z = 1 o al
+     * cerchio unitario.
+     */
+    static bool isPreferred(const BiquadKernels::SectionRange& range, int numSamples)
+    {
+        if (!isPreferred(range.numSections, numSamples))
+            return false;
+
+        for (int s = 0; s < range.numSections; ++s)
+        {
+            if (std::abs(1.0f + range.a1[s] + range.a2[s]) < minDistanceFromDc
+                || 1.0f - range.a2[s] < minDistanceFromUnitCircle)
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Processa in-place una banda. Le matrici vengono ricalcolate quando
+     * bandRevision cambia; i campioni oltre l'ultimo tile completo passano
+     * per il kernel ricorsivo.
+     * @param range Coefficienti e stati (interleaved [sezione][canale]) della banda
+     * @param bandRevision Revisione dei coefficienti della banda
+     */
+    void processBand(int band, const BiquadKernels::SectionRange& range, unsigned int bandRevision,
+                     float* const* channels, int numChannels, int numSamples);
+
+private:
+    struct BandMatrices
+    {
+        // Risposta all'impulso preceduta da blockLength zeri: hp[blockLength + k] = h[k]
+        alignas(16) std::array<float, 2 * blockLength> impulse;
+        // Colonna j: uscita del tile con stato iniziale e_j
+        alignas(16) std::array<float, maxOrder * blockLength> observation;
+        // Colonna j: stato finale con stato iniziale e_j (A^L)
+        alignas(16) std::array<float, maxOrder * maxOrder> transition;
+        // Colonna i: stato finale per un impulso in ingresso al campione i
+        alignas(16) std::array<float, blockLength * maxOrder> input;
+
+        int order = 0;
+        unsigned int revision = 0;
+        bool built = false;
+    };
+
+    std::array<BandMatrices, maxBands> matrices;
+
+    static void build(BandMatrices& m, const BiquadKernels::SectionRange& range);
+    static void processTiles(const BandMatrices& m, float* state, float* data, int numTiles);
+};
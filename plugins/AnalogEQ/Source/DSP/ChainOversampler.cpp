@@ -0,0 +1,89 @@
+#include "ChainOversampler.h"
+#include "FilterChain.h"
+
+ChainOversampler::ChainOversampler()
+{
+    for (int order = 1; order <= maxOrder; ++order)
+    {
+        for (const auto filter : { Filter::polyphaseIir, Filter::linearPhaseFir })
+        {
+            const auto type = filter == Filter::polyphaseIir ? Stage::filterHalfBandPolyphaseIIR
+                                                             : Stage::filterHalfBandFIREquiripple;
+
+            stages[static_cast<size_t>((order - 1) * 2 + static_cast<int>(filter))] =
+                std::make_unique<Stage>(static_cast<size_t>(maxChannels), static_cast<size_t>(order), type, true, true);
+        }
+    }
+}
+
+void ChainOversampler::prepare(int samplesPerBlock)
+{
+    preparedSamplesPerBlock = juce::jmax(1, samplesPerBlock);
+
+    for (auto& stage : stages)
+        stage->initProcessing(static_cast<size_t>(preparedSamplesPerBlock));
+}
+
+void ChainOversampler::reset()
+{
+    for (auto& stage : stages)
+        stage->reset();
+}
+
+bool ChainOversampler::setMode(int order, Filter filter, Scope scope)
+{
+    order = juce::jlimit(0, maxOrder, order);
+    if (order == currentOrder && (order == 0 || (filter == currentFilter && scope == currentScope)))
+        return false;
+
+    currentOrder = order;
+    currentFilter = filter;
+    currentScope = scope;
+    active = order > 0 ? stages[static_cast<size_t>((order - 1) * 2 + static_cast<int>(filter))].get() : nullptr;
+
+    // Lo stadio che subentra riparte da stato nullo
+    if (active != nullptr)
+        active->reset();
+
+    return true;
+}
+
+int ChainOversampler::getLatencySamples() const
+{
+    return active != nullptr ? juce::roundToInt(active->getLatencyInSamples()) : 0;
+}
+
+void ChainOversampler::process(juce::AudioBuffer<float>& buffer, FilterChain& chain)
+{
+    if (active == nullptr)
+        return chain.processBlock(buffer);
+
+    const bool selective = currentScope == Scope::highBands;
+    if (selective)
+        chain.processBlock(buffer, FilterChain::Segment::baseRate);
+
+    const int numChannels = juce::jmin(buffer.getNumChannels(), maxChannels);
+    const int numSamples = buffer.getNumSamples();
+    if (numChannels == 0 || numSamples == 0)
+        return;
+
+    // Blocchi più lunghi di quelli dichiarati in prepare: a pezzi
+    for (int start = 0; start < numSamples; start += preparedSamplesPerBlock)
+    {
+        const int length = juce::jmin(preparedSamplesPerBlock, numSamples - start);
+
+        juce::dsp::AudioBlock<float> block(buffer.getArrayOfWritePointers(), static_cast<size_t>(numChannels),
+                                           static_cast<size_t>(start), static_cast<size_t>(length));
+        auto upsampled = active->processSamplesUp(block);
+
+        // Buffer che punta ai dati dello stadio: nessuna copia né allocazione
+        std::array<float*, maxChannels> channels {};
+        for (int ch = 0; ch < numChannels; ++ch)
+            channels[static_cast<size_t>(ch)] = upsampled.getChannelPointer(static_cast<size_t>(ch));
+
+        juce::AudioBuffer<float> oversampled(channels.data(), numChannels, static_cast<int>(upsampled.getNumSamples()));
+        chain.processBlock(oversampled, selective ? FilterChain::Segment::oversampled : FilterChain::Segment::whole);
+
+        active->processSamplesDown(block);
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "BiquadCascade.h"
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <memory>
+
+class FilterChain;
+
+//==============================================================================
+/**
+ * Sovracampionamento 2x/4x/8x attorno alla catena di filtri.
+ *
+ * Con Scope::highBands viene sovracampionato solo il segmento delle bande
+ * sopra la soglia (FilterChain::setSelectiveOversampling): il segmento a
+ * frequenza base gira prima, poi la stessa coppia di stadi porta il blocco
+ * alla frequenza alta e indietro. La coppia resta attiva anche quando
+ * nessuna banda supera la soglia, così la latenza dichiarata non cambia
+ * mentre le bande si spostano.
+ *
+ * Ogni raddoppio è uno stadio half-band polifase di juce::dsp::Oversampling
+ * (IIR ellittico a fase minima o FIR equiripple a fase lineare), con latenza
+ * resa intera per poterla dichiarare all'host. Gli stadi di tutti i fattori
+ * vengono allocati in prepare: il cambio di fattore dal thread audio non
+ * alloca. Il chiamante riprogetta la catena a getProcessingRate quando
+ * setMode restituisce true.
+ *
+ * A fattore 1 process chiama direttamente la catena: nessun costo.
+ */
+class ChainOversampler
+{
+public:
+    static constexpr int maxChannels = BiquadCascade::maxChannels;
+    static constexpr int maxOrder = 3; // 8x
+
+    enum class Filter
+    {
+        polyphaseIir = 0,
+        linearPhaseFir
+    };
+
+    enum class Scope
+    {
+        wholeChain = 0,
+        highBands
+    };
+
+    ChainOversampler();
+
+    /**
+     * Alloca gli stadi di tutti i fattori per blocchi fino a samplesPerBlock.
+     */
+    void prepare(int samplesPerBlock);
+
+    void reset();
+
+    /**
+     * Seleziona fattore (ordine 0..maxOrder, cioè 1x..8x), filtro e ambito.
+     * @return true se qualcosa è cambiato (la catena va preparata di nuovo)
+     */
+    bool setMode(int order, Filter filter, Scope scope);
+
+    int getFactor() const { return 1 << currentOrder; }
+
+    /** Frequenza della catena: alta solo se viene sovracampionata tutta. */
+    double getProcessingRate(double baseSampleRate) const
+    {
+        return currentScope == Scope::wholeChain ? baseSampleRate * getFactor() : baseSampleRate;
+    }
+
+    /** Fattore per FilterChain::setSelectiveOversampling (1 se non selettivo). */
+    int getSelectiveFactor() const { return currentScope == Scope::highBands ? getFactor() : 1; }
+
+    /**
+     * Latenza (in campioni alla frequenza base) di sovra- e sottocampionamento.
+     */
+    int getLatencySamples() const;
+
+    /**
+     * Processa buffer con la catena alla frequenza di lavoro. Come
+     * FilterChain::processBlock agisce solo sui primi maxChannels canali.
+     */
+    void process(juce::AudioBuffer<float>& buffer, FilterChain& chain);
+
+private:
+    using Stage = juce::dsp::Oversampling<float>;
+
+    // Indice (ordine - 1) * 2 + filtro; a ordine 0 nessuno stadio
+    std::array<std::unique_ptr<Stage>, 2 * maxOrder> stages;
+    Stage* active = nullptr;
+
+    int currentOrder = 0;
+    Filter currentFilter = Filter::polyphaseIir;
+    Scope currentScope = Scope::wholeChain;
+    int preparedSamplesPerBlock = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(ChainOversampler)
+};
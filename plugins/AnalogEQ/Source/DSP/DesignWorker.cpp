@@ -0,0 +1,107 @@
+#include "DesignWorker.h"
+#include <cmath>
+
+DesignWorker::DesignWorker()
+    : juce::Thread("AnalogEQ Design")
+{
+}
+
+DesignWorker::~DesignWorker()
+{
+    stop();
+}
+
+void DesignWorker::start()
+{
+    if (!isThreadRunning())
+        startThread();
+}
+
+void DesignWorker::stop()
+{
+    stopThread(1000);
+}
+
+int DesignWorker::getRampLength(const BiquadDesign::BandParameters& from, const BiquadDesign::BandParameters& to)
+{
+    const auto octaves = [](float a, float b) { return std::abs(std::log2(b / a)); };
+    const auto steps = juce::jmax(octaves(from.frequency, to.frequency) / maxStepOctaves,
+                                  octaves(from.q, to.q) / maxStepOctaves,
+                                  std::abs(to.gain - from.gain) / maxStepDecibels);
+
+    return juce::jlimit(minRampLength, maxRampLength, static_cast<int>(std::ceil(steps)));
+}
+
+void DesignWorker::design(const Request& request, Result& result)
+{
+    result.kind = request.kind;
+    result.band = request.band;
+    result.generation = request.generation;
+    result.numSteps = juce::jlimit(1, maxRampLength, request.numSteps);
+    result.rampFrom = request.rampFrom;
+    result.parameters = request.parameters;
+
+    for (int step = 0; step < result.numSteps; ++step)
+    {
+        const auto parameters = step + 1 < result.numSteps
+            ? BiquadDesign::interpolate(request.rampFrom, request.parameters,
+                                        static_cast<float>(step + 1) / static_cast<float>(result.numSteps))
+            : request.parameters;
+
+        result.numSections = BiquadDesign::designBand(parameters, request.sampleRate, result.steps[static_cast<size_t>(step)]);
+    }
+}
+
+void DesignWorker::designParallelForm(const ParallelRequest& request, ParallelResult& result)
+{
+    result.generation = request.generation;
+    result.verified = ParallelFilterBank::design(request.sections.data(), request.numSections, result.coefficients)
+                   && ParallelFilterBank::measureErrorDb(result.coefficients, request.sections.data(), request.numSections,
+                                                         request.sampleRate, parallelVerificationPoints,
+                                                         parallelFloorDb) <= parallelToleranceDb;
+}
+
+template <typename Item, int capacity>
+bool DesignWorker::pushResult(SpscQueue<Item, capacity>& queue, const Item& item)
+{
+    // Coda dei risultati piena: il thread audio la svuota a ogni blocco
+    while (!queue.push(item))
+    {
+        if (threadShouldExit())
+            return false;
+
+        wait(pollIntervalMs);
+    }
+
+    return true;
+}
+
+void DesignWorker::run()
+{
+    while (!threadShouldExit())
+    {
+        Request request;
+        Result result;
+
+        while (requests.pop(request))
+        {
+            design(request, result);
+
+            if (!pushResult(results, result))
+                return;
+        }
+
+        ParallelRequest parallelRequest;
+        ParallelResult parallelResult;
+
+        while (parallelRequests.pop(parallelRequest))
+        {
+            designParallelForm(parallelRequest, parallelResult);
+
+            if (!pushResult(parallelResults, parallelResult))
+                return;
+        }
+
+        wait(pollIntervalMs);
+    }
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "BiquadDesign.h"
+#include "ParallelFilterBank.h"
+#include <juce_core/juce_core.h>
+#include <array>
+
+//==============================================================================
+/**
+ * Coda single-producer/single-consumer a capacità fissa (su juce::AbstractFifo):
+ * push e pop non allocano e non bloccano, quindi si possono chiamare dal
+ * thread audio. Contiene al massimo capacity - 1 elementi.
+ */
+template <typename Item, int capacity>
+class SpscQueue
+{
+public:
+    bool push(const Item& item)
+    {
+        int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+        fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+        if (size1 + size2 == 0)
+            return false;
+
+        items[static_cast<size_t>(size1 > 0 ? start1 : start2)] = item;
+        fifo.finishedWrite(1);
+        return true;
+    }
+
+    bool pop(Item& item)
+    {
+        int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+        fifo.prepareToRead(1, start1, size1, start2, size2);
+
+        if (size1 + size2 == 0)
+            return false;
+
+        item = items[static_cast<size_t>(size1 > 0 ? start1 : start2)];
+        fifo.finishedRead(1);
+        return true;
+    }
+
+private:
+    juce::AbstractFifo fifo { capacity };
+    std::array<Item, static_cast<size_t>(capacity)> items {};
+};
+
+//==============================================================================
+/**
+ * Thread di progettazione dei coefficienti.
+ * Il thread audio invia richieste (parametri di una banda) e raccoglie i
+ * risultati (tutte le sezioni progettate) tramite due SpscQueue: nessuna
+ * allocazione né lock sul thread audio, che si limita a copiare nel motore
+ * le sezioni pronte. Il worker controlla la coda ogni pollIntervalMs, così il
+ * thread audio non deve mai svegliarlo.
+ */
+class DesignWorker : private juce::Thread
+{
+public:
+    enum class Kind
+    {
+        update = 0,     // Nuovi coefficienti per la banda corrente
+        replacement     // Banda sostitutiva per BandCrossfader
+    };
+
+    /**
+     * Passi di una rampa di coefficienti (incluso il progetto finale).
+     * Ogni passo sposta frequenza e Q al più di maxStepOctaves e il gain al
+     * più di maxStepDecibels rispetto al precedente (getRampLength): con i
+     * range dei parametri (20 Hz - 20 kHz, ±24 dB, Q 0.1 - 10) bastano sempre
+     * maxRampLength passi. Le modifiche piccole usano comunque minRampLength
+     * passi, per non scendere sotto la durata minima della rampa.
+     */
+    static constexpr int minRampLength = 8;
+    static constexpr int maxRampLength = 32;
+    static constexpr float maxStepOctaves = 1.0f / 3.0f;
+    static constexpr float maxStepDecibels = 1.5f;
+
+    /** Numero di passi della rampa da from a to (stesso tipo e slope). */
+    static int getRampLength(const BiquadDesign::BandParameters& from, const BiquadDesign::BandParameters& to);
+
+    struct Request
+    {
+        Kind kind = Kind::update;
+        int band = 0;
+        unsigned int generation = 0;
+        BiquadDesign::BandParameters parameters;
+        double sampleRate = 44100.0;
+
+        // Rampa da rampFrom (stesso tipo e slope) a parameters: 1 = nessuna rampa
+        BiquadDesign::BandParameters rampFrom;
+        int numSteps = 1;
+    };
+
+    /**
+     * Progetti di una richiesta: un passo per ogni punto della rampa, sui
+     * parametri interpolati da BiquadDesign::interpolate; l'ultimo passo è il
+     * progetto di Request::parameters.
+     */
+    struct Result
+    {
+        Kind kind = Kind::update;
+        int band = 0;
+        unsigned int generation = 0;
+        int numSections = 0;
+        int numSteps = 1;
+        BiquadDesign::BandParameters rampFrom, parameters;
+        std::array<BiquadDesign::SectionArray, maxRampLength> steps;
+
+        const BiquadDesign::SectionArray& getFinalSections() const { return steps[static_cast<size_t>(numSteps - 1)]; }
+    };
+
+    /**
+     * Forma parallela della catena: le sezioni delle bande attive, convertite
+     * (ParallelFilterBank::design) e verificate contro il prodotto delle
+     * sezioni sul worker. Il thread audio carica solo il risultato.
+     */
+    struct ParallelRequest
+    {
+        unsigned int generation = 0;
+        int numSections = 0;
+        std::array<BiquadCoefficients, BiquadCascade::maxSections> sections;
+        double sampleRate = 44100.0;
+    };
+
+    struct ParallelResult
+    {
+        unsigned int generation = 0;
+        bool verified = false;      // convertita ed entro parallelToleranceDb
+        ParallelFilterBank::Coefficients coefficients;
+    };
+
+    // Tolleranza della verifica e floor sotto cui le differenze non contano
+    static constexpr float parallelToleranceDb = 0.1f;
+    static constexpr float parallelFloorDb = -80.0f;
+    static constexpr int parallelVerificationPoints = 32;
+
+    static constexpr int queueSize = 32;
+    static constexpr int parallelQueueSize = 4;
+    static constexpr int pollIntervalMs = 2;
+
+    DesignWorker();
+    ~DesignWorker() override;
+
+    void start();
+    void stop();
+    bool isRunning() const { return isThreadRunning(); }
+
+    /**
+     * Progetta una richiesta (anche in linea, es. nel rendering offline).
+     */
+    static void design(const Request& request, Result& result);
+
+    /** Converte e verifica la forma parallela (anche in linea). */
+    static void designParallelForm(const ParallelRequest& request, ParallelResult& result);
+
+    /** Thread audio: accoda una richiesta. @return false se la coda è piena */
+    bool post(const Request& request) { return requests.push(request); }
+
+    /** Thread audio: preleva un risultato pronto. */
+    bool fetch(Result& result) { return results.pop(result); }
+
+    /** Thread audio: accoda una forma parallela. @return false se la coda è piena */
+    bool post(const ParallelRequest& request) { return parallelRequests.push(request); }
+
+    /** Thread audio: preleva una forma parallela pronta. */
+    bool fetch(ParallelResult& result) { return parallelResults.pop(result); }
+
+private:
+    void run() override;
+
+    template <typename Item, int capacity>
+    bool pushResult(SpscQueue<Item, capacity>& queue, const Item& item);
+
+    SpscQueue<Request, queueSize> requests;
+    SpscQueue<Result, queueSize> results;
+    SpscQueue<ParallelRequest, parallelQueueSize> parallelRequests;
+    SpscQueue<ParallelResult, parallelQueueSize> parallelResults;
+
+    JUCE_DECLARE_NON_COPYABLE(DesignWorker)
+};
@@ -0,0 +1,698 @@
+#pragma once
+
+#include "BiquadKernels.h"
+#include <cstdint>
+#include <cstring>
+
+#if ANALOGEQ_BIQUAD_SSE2 && defined(__AVX2__)
+ #include <immintrin.h>
+#endif
+
+//==============================================================================
+/**
+ * Approssimazioni vettoriali di exp2, log2, tanh e sin/cos (e soft clipping
+ * con antialiasing, sulle primitive di tanh) per le TU dei
+ * kernel di KernelDispatch (stesso namespace di target di BiquadKernels:
+ * niente <cmath> né JUCE).
+ *
+ * Ogni funzione è scritta una volta sola sulle operazioni di una struct di
+ * lane (Scalar, Sse2, Avx2, Avx512) con la stessa sequenza di operazioni,
+ * senza FMA: il risultato è identico bit per bit in ogni ISA.
+ * Errori massimi rispetto a libm in double, verificati per ogni ISA da
+ * Tests/MathAccuracyTests (misurati, tra parentesi il limite del test):
+ * exp2 1.0 ULP (1.5), log2 2.8 ULP (3.0), saturazione (tanh) 4.0 ULP (4.5);
+ * sin/cos 8.2e-8 in assoluto (2.5e-7); conversioni in dB 9.8e-6 dB (2e-5);
+ * ADAA 8.3e-7 (2e-6, primo ordine) e 3.2e-5 (5e-5, secondo) in assoluto.
+ *
+ * Domini: log2 solo per x > 0 normali; exp2 satura a 2^-126 e 2^126.
+ */
+namespace FastMath
+{
+inline namespace ANALOGEQ_KERNEL_TARGET
+{
+    namespace Lanes
+    {
+        /** Una lane: coda dei blocchi e TU senza SIMD. */
+        struct Scalar
+        {
+            using Vec = float;
+            using Int = std::int32_t;
+            using Mask = bool;
+            static constexpr int width = 1;
+
+            static Vec load(const float* p) { return *p; }
+            static void store(float* p, Vec v) { *p = v; }
+            static Vec broadcast(float x) { return x; }
+            static Int broadcastInt(std::int32_t x) { return x; }
+            static Vec add(Vec a, Vec b) { return a + b; }
+            static Vec sub(Vec a, Vec b) { return a - b; }
+            static Vec mul(Vec a, Vec b) { return a * b; }
+            static Vec div(Vec a, Vec b) { return a / b; }
+            static Vec min(Vec a, Vec b) { return b < a ? b : a; }
+            static Vec max(Vec a, Vec b) { return a < b ? b : a; }
+            static Mask lessThan(Vec a, Vec b) { return a < b; }
+            static Mask equal(Int a, Int b) { return a == b; }
+            static Vec select(Mask m, Vec a, Vec b) { return m ? a : b; }
+            static bool any(Mask m) { return m; }
+
+            static Int bits(Vec v) { Int i; std::memcpy(&i, &v, sizeof(i)); return i; }
+            static Vec fromBits(Int i) { Vec v; std::memcpy(&v, &i, sizeof(v)); return v; }
+            static Int truncate(Vec v) { return static_cast<Int>(v); }
+            static Vec toFloat(Int i) { return static_cast<Vec>(i); }
+            static Int addInt(Int a, Int b) { return static_cast<Int>(static_cast<std::uint32_t>(a) + static_cast<std::uint32_t>(b)); }
+            static Int andInt(Int a, Int b) { return a & b; }
+            static Int orInt(Int a, Int b) { return a | b; }
+            static Int xorInt(Int a, Int b) { return a ^ b; }
+            static Int shiftLeft(Int a, int n) { return static_cast<Int>(static_cast<std::uint32_t>(a) << n); }
+            static Int shiftRight(Int a, int n) { return static_cast<Int>(static_cast<std::uint32_t>(a) >> n); }
+        };
+
+       #if ANALOGEQ_BIQUAD_SSE2
+        struct Sse2
+        {
+            using Vec = __m128;
+            using Int = __m128i;
+            using Mask = __m128;
+            static constexpr int width = 4;
+
+            static Vec load(const float* p) { return _mm_loadu_ps(p); }
+            static void store(float* p, Vec v) { _mm_storeu_ps(p, v); }
+            static Vec broadcast(float x) { return _mm_set1_ps(x); }
+            static Int broadcastInt(std::int32_t x) { return _mm_set1_epi32(x); }
+            static Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+            static Vec sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+            static Vec mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+            static Vec div(Vec a, Vec b) { return _mm_div_ps(a, b); }
+            static Vec min(Vec a, Vec b) { return _mm_min_ps(a, b); }
+            static Vec max(Vec a, Vec b) { return _mm_max_ps(a, b); }
+            static Mask lessThan(Vec a, Vec b) { return _mm_cmplt_ps(a, b); }
+            static Mask equal(Int a, Int b) { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, b)); }
+            static Vec select(Mask m, Vec a, Vec b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+            static bool any(Mask m) { return _mm_movemask_ps(m) != 0; }
+
+            static Int bits(Vec v) { return _mm_castps_si128(v); }
+            static Vec fromBits(Int i) { return _mm_castsi128_ps(i); }
+            static Int truncate(Vec v) { return _mm_cvttps_epi32(v); }
+            static Vec toFloat(Int i) { return _mm_cvtepi32_ps(i); }
+            static Int addInt(Int a, Int b) { return _mm_add_epi32(a, b); }
+            static Int andInt(Int a, Int b) { return _mm_and_si128(a, b); }
+            static Int orInt(Int a, Int b) { return _mm_or_si128(a, b); }
+            static Int xorInt(Int a, Int b) { return _mm_xor_si128(a, b); }
+            static Int shiftLeft(Int a, int n) { return _mm_slli_epi32(a, n); }
+            static Int shiftRight(Int a, int n) { return _mm_srli_epi32(a, n); }
+        };
+       #endif
+
+       #if ANALOGEQ_BIQUAD_SSE2 && defined(__AVX2__)
+        struct Avx2
+        {
+            using Vec = __m256;
+            using Int = __m256i;
+            using Mask = __m256;
+            static constexpr int width = 8;
+
+            static Vec load(const float* p) { return _mm256_loadu_ps(p); }
+            static void store(float* p, Vec v) { _mm256_storeu_ps(p, v); }
+            static Vec broadcast(float x) { return _mm256_set1_ps(x); }
+            static Int broadcastInt(std::int32_t x) { return _mm256_set1_epi32(x); }
+            static Vec add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+            static Vec sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+            static Vec mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+            static Vec div(Vec a, Vec b) { return _mm256_div_ps(a, b); }
+            static Vec min(Vec a, Vec b) { return _mm256_min_ps(a, b); }
+            static Vec max(Vec a, Vec b) { return _mm256_max_ps(a, b); }
+            static Mask lessThan(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+            static Mask equal(Int a, Int b) { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)); }
+            static Vec select(Mask m, Vec a, Vec b) { return _mm256_blendv_ps(b, a, m); }
+            static bool any(Mask m) { return _mm256_movemask_ps(m) != 0; }
+
+            static Int bits(Vec v) { return _mm256_castps_si256(v); }
+            static Vec fromBits(Int i) { return _mm256_castsi256_ps(i); }
+            static Int truncate(Vec v) { return _mm256_cvttps_epi32(v); }
+            static Vec toFloat(Int i) { return _mm256_cvtepi32_ps(i); }
+            static Int addInt(Int a, Int b) { return _mm256_add_epi32(a, b); }
+            static Int andInt(Int a, Int b) { return _mm256_and_si256(a, b); }
+            static Int orInt(Int a, Int b) { return _mm256_or_si256(a, b); }
+            static Int xorInt(Int a, Int b) { return _mm256_xor_si256(a, b); }
+            static Int shiftLeft(Int a, int n) { return _mm256_slli_epi32(a, n); }
+            static Int shiftRight(Int a, int n) { return _mm256_srli_epi32(a, n); }
+        };
+       #endif
+
+       #if ANALOGEQ_BIQUAD_SSE2 && defined(__AVX512F__)
+        struct Avx512
+        {
+            using Vec = __m512;
+            using Int = __m512i;
+            using Mask = __mmask16;
+            static constexpr int width = 16;
+
+            // Varianti maskz su tutte le lane: le forme senza maschera partono da
+            // _mm512_undefined e GCC 12 segnala -Wmaybe-uninitialized
+            static constexpr Mask all = 0xffff;
+
+            static Vec load(const float* p) { return _mm512_loadu_ps(p); }
+            static void store(float* p, Vec v) { _mm512_storeu_ps(p, v); }
+            static Vec broadcast(float x) { return _mm512_set1_ps(x); }
+            static Int broadcastInt(std::int32_t x) { return _mm512_set1_epi32(x); }
+            static Vec add(Vec a, Vec b) { return _mm512_add_ps(a, b); }
+            static Vec sub(Vec a, Vec b) { return _mm512_sub_ps(a, b); }
+            static Vec mul(Vec a, Vec b) { return _mm512_mul_ps(a, b); }
+            static Vec div(Vec a, Vec b) { return _mm512_div_ps(a, b); }
+            static Vec min(Vec a, Vec b) { return _mm512_maskz_min_ps(all, a, b); }
+            static Vec max(Vec a, Vec b) { return _mm512_maskz_max_ps(all, a, b); }
+            static Mask lessThan(Vec a, Vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+            static Mask equal(Int a, Int b) { return _mm512_cmpeq_epi32_mask(a, b); }
+            static Vec select(Mask m, Vec a, Vec b) { return _mm512_mask_blend_ps(m, b, a); }
+            static bool any(Mask m) { return m != 0; }
+
+            static Int bits(Vec v) { return _mm512_castps_si512(v); }
+            static Vec fromBits(Int i) { return _mm512_castsi512_ps(i); }
+            static Int truncate(Vec v) { return _mm512_maskz_cvttps_epi32(all, v); }
+            static Vec toFloat(Int i) { return _mm512_maskz_cvtepi32_ps(all, i); }
+            static Int addInt(Int a, Int b) { return _mm512_add_epi32(a, b); }
+            static Int andInt(Int a, Int b) { return _mm512_and_epi32(a, b); }
+            static Int orInt(Int a, Int b) { return _mm512_or_epi32(a, b); }
+            static Int xorInt(Int a, Int b) { return _mm512_xor_epi32(a, b); }
+            static Int shiftLeft(Int a, int n) { return _mm512_maskz_slli_epi32(all, a, static_cast<unsigned int>(n)); }
+            static Int shiftRight(Int a, int n) { return _mm512_maskz_srli_epi32(all, a, static_cast<unsigned int>(n)); }
+        };
+       #endif
+    }
+
+    constexpr float log2e = 1.44269504088896341f;
+    constexpr float log2Of10 = 3.32192809488736235f;
+    constexpr float decibelsPerOctave = 6.02059991327962390f;   // 20 log10(2)
+    constexpr float ln2 = 0.693147180559945309f;
+    constexpr float pi2Over24 = 0.411233516712056609f;
+
+    /** Arrotonda all'intero più vicino (pari a metà) con la costante 1.5 * 2^23, |x| < 2^22. */
+    template <typename L>
+    inline typename L::Vec roundToInteger(typename L::Vec x)
+    {
+        const auto magic = L::broadcast(12582912.0f);
+        return L::sub(L::add(x, magic), magic);
+    }
+
+    template <typename L>
+    inline typename L::Vec abs(typename L::Vec x)
+    {
+        return L::fromBits(L::andInt(L::bits(x), L::broadcastInt(0x7fffffff)));
+    }
+
+    /** 2^x: parte intera nell'esponente, 2^f su [-0.5, 0.5] con Taylor di grado 7. */
+    template <typename L>
+    inline typename L::Vec exp2(typename L::Vec x)
+    {
+        x = L::min(L::max(x, L::broadcast(-126.0f)), L::broadcast(126.0f));
+
+        const auto n = roundToInteger<L>(x);
+        const auto f = L::sub(x, n);
+
+        auto p = L::broadcast(1.5252733804059841e-5f);
+        p = L::add(L::mul(p, f), L::broadcast(1.5403530393381606e-4f));
+        p = L::add(L::mul(p, f), L::broadcast(1.3333558146428443e-3f));
+        p = L::add(L::mul(p, f), L::broadcast(9.6181291076284772e-3f));
+        p = L::add(L::mul(p, f), L::broadcast(5.5504108664821580e-2f));
+        p = L::add(L::mul(p, f), L::broadcast(2.4022650695910071e-1f));
+        p = L::add(L::mul(p, f), L::broadcast(6.9314718055994531e-1f));
+        p = L::add(L::mul(p, f), L::broadcast(1.0f));
+
+        const auto scale = L::fromBits(L::shiftLeft(L::addInt(L::truncate(n), L::broadcastInt(127)), 23));
+        return L::mul(p, scale);
+    }
+
+    /**
+     * log2(x) per x > 0 normale: esponente più log2 della mantissa in
+     * [sqrt(1/2), sqrt(2)), con la serie di atanh in t = (m - 1) / (m + 1).
+     */
+    template <typename L>
+    inline typename L::Vec log2(typename L::Vec x)
+    {
+        const auto bits = L::bits(x);
+        const auto exponent = L::addInt(L::shiftRight(bits, 23), L::broadcastInt(-127));
+        auto m = L::fromBits(L::orInt(L::andInt(bits, L::broadcastInt(0x007fffff)), L::broadcastInt(0x3f800000)));
+
+        const auto above = L::lessThan(L::broadcast(1.41421356f), m);
+        m = L::select(above, L::mul(m, L::broadcast(0.5f)), m);
+        const auto e = L::add(L::toFloat(exponent), L::select(above, L::broadcast(1.0f), L::broadcast(0.0f)));
+
+        const auto one = L::broadcast(1.0f);
+        const auto t = L::div(L::sub(m, one), L::add(m, one));
+        const auto t2 = L::mul(t, t);
+
+        auto p = L::broadcast(1.0f / 9.0f);
+        p = L::add(L::mul(p, t2), L::broadcast(1.0f / 7.0f));
+        p = L::add(L::mul(p, t2), L::broadcast(1.0f / 5.0f));
+        p = L::add(L::mul(p, t2), L::broadcast(1.0f / 3.0f));
+        p = L::add(L::mul(p, t2), one);
+
+        return L::add(e, L::mul(L::mul(t, p), L::broadcast(2.0f * log2e)));
+    }
+
+    /**
+     * tanh(x) razionale: polinomio dispari di grado 13 su polinomio pari di
+     * grado 6 (minimax), con x limitato a +-7.9053, dove il quoziente
+     * arrotondato vale già +-1. Una divisione e nessuna exp; sotto 4e-4
+     * restituisce x, che lì è tanh(x) arrotondato.
+     */
+    template <typename L>
+    inline typename L::Vec tanh(typename L::Vec x)
+    {
+        const auto clamped = L::min(L::max(x, L::broadcast(-7.90531110763549805f)), L::broadcast(7.90531110763549805f));
+        const auto x2 = L::mul(clamped, clamped);
+
+        auto p = L::broadcast(-2.76076847742355e-16f);
+        p = L::add(L::mul(p, x2), L::broadcast(2.00018790482477e-13f));
+        p = L::add(L::mul(p, x2), L::broadcast(-8.60467152213735e-11f));
+        p = L::add(L::mul(p, x2), L::broadcast(5.12229709037114e-08f));
+        p = L::add(L::mul(p, x2), L::broadcast(1.48572235717979e-05f));
+        p = L::add(L::mul(p, x2), L::broadcast(6.37261928875436e-04f));
+        p = L::add(L::mul(p, x2), L::broadcast(4.89352455891786e-03f));
+        p = L::mul(p, clamped);
+
+        auto q = L::broadcast(1.19825839466702e-06f);
+        q = L::add(L::mul(q, x2), L::broadcast(1.18534705686654e-04f));
+        q = L::add(L::mul(q, x2), L::broadcast(2.26843463243900e-03f));
+        q = L::add(L::mul(q, x2), L::broadcast(4.89352518554385e-03f));
+
+        const auto tiny = L::lessThan(abs<L>(x), L::broadcast(0.0004f));
+        return L::select(tiny, x, L::div(p, q));
+    }
+
+    /** magnitude con il segno di sign (magnitude >= 0). */
+    template <typename L>
+    inline typename L::Vec copySign(typename L::Vec magnitude, typename L::Vec sign)
+    {
+        const auto signBit = L::broadcastInt(static_cast<std::int32_t>(0x80000000u));
+        return L::fromBits(L::orInt(L::bits(magnitude), L::andInt(L::bits(sign), signBit)));
+    }
+
+    /*
+     * Primitive di tanh per l'antialiasing (ADAA), scritte come parte
+     * polinomiale esatta più una coda limitata, così le differenze divise
+     * perdono precisione solo sulla coda:
+     *   F1(x) = log cosh x + ln 2 = |x| + log(1 + e^-2|x|)
+     *   F2(x) = x|x| / 2 + sign(x) (Li2(-e^-2|x|) + pi^2 / 12) / 2, con F2' = F1
+     * Il ln 2 in più (un termine lineare in F2) sparisce nelle differenze seconde.
+     */
+
+    /** Coda di F1: log(1 + e^-2a) per a = |x|, in [0, ln 2]. */
+    template <typename L>
+    inline typename L::Vec logCoshTail(typename L::Vec a)
+    {
+        const auto u = exp2<L>(L::mul(a, L::broadcast(-2.0f * log2e)));
+        return L::mul(log2<L>(L::add(L::broadcast(1.0f), u)), L::broadcast(ln2));
+    }
+
+    /**
+     * Coda di F2: (Li2(-u) + pi^2 / 12) / 2 con u = e^-2a, in [0, pi^2 / 24].
+     * Li2(-u) = -u g(u), g interpolato su [0, 1] da un polinomio di Chebyshev
+     * di grado 8 in 2u - 1 (errore 4e-8).
+     */
+    template <typename L>
+    inline typename L::Vec dilogTail(typename L::Vec a)
+    {
+        const auto u = exp2<L>(L::mul(a, L::broadcast(-2.0f * log2e)));
+        const auto s = L::sub(L::add(u, u), L::broadcast(1.0f));
+
+        auto g = L::broadcast(2.94831580776450108e-06f);
+        g = L::add(L::mul(g, s), L::broadcast(-1.09681885607893708e-05f));
+        g = L::add(L::mul(g, s), L::broadcast(3.52932860013881729e-05f));
+        g = L::add(L::mul(g, s), L::broadcast(-1.41355118130515720e-04f));
+        g = L::add(L::mul(g, s), L::broadcast(6.00445402121622257e-04f));
+        g = L::add(L::mul(g, s), L::broadcast(-2.71598738306346164e-03f));
+        g = L::add(L::mul(g, s), L::broadcast(1.37664148978441646e-02f));
+        g = L::add(L::mul(g, s), L::broadcast(-8.58981691611815972e-02f));
+        g = L::add(L::mul(g, s), L::broadcast(8.96828413847292408e-01f));
+
+        return L::sub(L::broadcast(pi2Over24), L::mul(L::mul(u, g), L::broadcast(0.5f)));
+    }
+
+    /**
+     * Differenza divisa di x|x| / 2 tra a e b (parte polinomiale di F2): in
+     * forma chiusa, (|a| + |b|) / 2 con segni concordi, senza cancellazioni.
+     */
+    template <typename L>
+    inline typename L::Vec halfSquareSlope(typename L::Vec a, typename L::Vec b)
+    {
+        const auto sumAbs = L::add(abs<L>(a), abs<L>(b));
+        const auto opposite = L::lessThan(L::mul(a, b), L::broadcast(0.0f));
+        const auto denominator = L::select(opposite, sumAbs, L::broadcast(1.0f));
+        const auto crossing = L::div(L::add(L::mul(a, a), L::mul(b, b)), L::add(denominator, denominator));
+        return L::select(opposite, crossing, L::mul(sumAbs, L::broadcast(0.5f)));
+    }
+
+    /** Vero dove a e b hanno lo stesso bit di segno. */
+    template <typename L>
+    inline typename L::Mask sameSign(typename L::Vec a, typename L::Vec b)
+    {
+        const auto signBit = L::broadcastInt(static_cast<std::int32_t>(0x80000000u));
+        return L::equal(L::andInt(L::xorInt(L::bits(a), L::bits(b)), signBit), L::broadcastInt(0));
+    }
+
+    /**
+     * sin e cos insieme: riduzione a [-pi/4, pi/4] sul multiplo di pi/2 più
+     * vicino (Cody-Waite su tre costanti), polinomi di Taylor, quadrante dai
+     * due bit bassi del multiplo.
+     */
+    template <typename L>
+    inline void sinCos(typename L::Vec x, typename L::Vec& sine, typename L::Vec& cosine)
+    {
+        const auto n = roundToInteger<L>(L::mul(x, L::broadcast(0.636619772367581343f)));
+        auto r = L::sub(x, L::mul(n, L::broadcast(1.5703125f)));
+        r = L::sub(r, L::mul(n, L::broadcast(4.837512969970703125e-4f)));
+        r = L::sub(r, L::mul(n, L::broadcast(7.54978995489188216e-8f)));
+
+        const auto r2 = L::mul(r, r);
+
+        auto s = L::broadcast(1.0f / 362880.0f);
+        s = L::add(L::mul(s, r2), L::broadcast(-1.0f / 5040.0f));
+        s = L::add(L::mul(s, r2), L::broadcast(1.0f / 120.0f));
+        s = L::add(L::mul(s, r2), L::broadcast(-1.0f / 6.0f));
+        s = L::add(r, L::mul(L::mul(r, r2), s));
+
+        auto c = L::broadcast(-1.0f / 3628800.0f);
+        c = L::add(L::mul(c, r2), L::broadcast(1.0f / 40320.0f));
+        c = L::add(L::mul(c, r2), L::broadcast(-1.0f / 720.0f));
+        c = L::add(L::mul(c, r2), L::broadcast(1.0f / 24.0f));
+        c = L::add(L::mul(c, r2), L::broadcast(-0.5f));
+        c = L::add(L::mul(c, r2), L::broadcast(1.0f));
+
+        // Quadrante q: sin = (s, c, -s, -c)[q], cos = (c, -s, -c, s)[q]
+        const auto q = L::truncate(n);
+        const auto swap = L::equal(L::andInt(q, L::broadcastInt(1)), L::broadcastInt(1));
+        const auto sineSign = L::shiftLeft(L::andInt(q, L::broadcastInt(2)), 30);
+        const auto cosineSign = L::shiftLeft(L::andInt(L::addInt(q, L::broadcastInt(1)), L::broadcastInt(2)), 30);
+
+        sine = L::fromBits(L::xorInt(L::bits(L::select(swap, c, s)), sineSign));
+        cosine = L::fromBits(L::xorInt(L::bits(L::select(swap, s, c)), cosineSign));
+    }
+
+    //==============================================================================
+    /**
+     * Applica fn(lanes, x) a blocchi di L::width valori, e alla coda una lane
+     * alla volta.
+     */
+    template <typename L, typename Function>
+    inline void transform(const float* input, float* output, int numValues, Function&& fn)
+    {
+        int i = 0;
+
+        for (; i + L::width <= numValues; i += L::width)
+            L::store(output + i, fn(L {}, L::load(input + i)));
+
+        for (; i < numValues; ++i)
+            Lanes::Scalar::store(output + i, fn(Lanes::Scalar {}, Lanes::Scalar::load(input + i)));
+    }
+
+    template <typename L>
+    inline void exp2(const float* input, float* output, int numValues)
+    {
+        transform<L>(input, output, numValues, [](auto lanes, auto x)
+        {
+            return exp2<decltype(lanes)>(x);
+        });
+    }
+
+    template <typename L>
+    inline void log2(const float* input, float* output, int numValues)
+    {
+        transform<L>(input, output, numValues, [](auto lanes, auto x)
+        {
+            return log2<decltype(lanes)>(x);
+        });
+    }
+
+    /** Guadagno lineare da dB: 2^(dB * log2(10) / 20). */
+    template <typename L>
+    inline void decibelsToGains(const float* decibels, float* gains, int numValues)
+    {
+        transform<L>(decibels, gains, numValues, [](auto lanes, auto x)
+        {
+            using Lanes = decltype(lanes);
+            return exp2<Lanes>(Lanes::mul(x, Lanes::broadcast(log2Of10 / 20.0f)));
+        });
+    }
+
+    /** 20 log10 delle magnitudini (limitate sotto a minMagnitude), in [minDb, maxDb]. */
+    template <typename L>
+    inline void magnitudesToDecibels(const float* magnitudes, float* decibels, int numValues,
+                                     float minMagnitude, float minDb, float maxDb)
+    {
+        transform<L>(magnitudes, decibels, numValues, [=](auto lanes, auto x)
+        {
+            using Lanes = decltype(lanes);
+            const auto db = Lanes::mul(log2<Lanes>(Lanes::max(x, Lanes::broadcast(minMagnitude))),
+                                       Lanes::broadcast(decibelsPerOctave));
+            return Lanes::min(Lanes::max(db, Lanes::broadcast(minDb)), Lanes::broadcast(maxDb));
+        });
+    }
+
+    /** Soft clipping in-place: tanh(x * drive) * outputGain. */
+    template <typename L>
+    inline void softClip(float* data, int numValues, float drive, float outputGain)
+    {
+        transform<L>(data, data, numValues, [=](auto lanes, auto x)
+        {
+            using Lanes = decltype(lanes);
+            return Lanes::mul(tanh<Lanes>(Lanes::mul(x, Lanes::broadcast(drive))), Lanes::broadcast(outputGain));
+        });
+    }
+
+    /**
+     * Chiama fn(lanes, i) a blocchi di L::width indici, e alla coda una lane
+     * alla volta.
+     */
+    template <typename L, typename Function>
+    inline void forEachBlock(int numValues, Function&& fn)
+    {
+        int i = 0;
+
+        for (; i + L::width <= numValues; i += L::width)
+            fn(L {}, i);
+
+        for (; i < numValues; ++i)
+            fn(Lanes::Scalar {}, i);
+    }
+
+    /** Blocco interno delle versioni ADAA e distanza massima tra campioni di un canale. */
+    constexpr int adaaBlockSize = 64;
+    constexpr int maxAdaaStride = 2;
+
+    /**
+     * Distanze tra ingressi sotto cui le differenze divise (in float) perdono
+     * più cifre dello sviluppo in serie che le sostituisce.
+     */
+    constexpr float adaaTolerance1 = 0.15f;
+    constexpr float adaaTolerance2 = 0.05f;
+
+    /**
+     * Soft clipping con antialiasing del primo ordine (ADAA1), in-place:
+     * y[n] = outputGain (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1]), x = drive * ingresso,
+     * cioè la media di tanh tra due ingressi consecutivi (ritardo di mezzo
+     * campione). Con |x[n] - x[n-1]| sotto adaaTolerance1 usa lo sviluppo nel
+     * punto medio m: tanh(m) + tanh''(m) d^2 / 24.
+     * @param stride Distanza tra campioni consecutivi di un canale (2 per frame stereo)
+     * @param history Gli ultimi 2 * stride ingressi per drive, aggiornati alla fine
+     */
+    template <typename L>
+    inline void softClipAdaa1(float* data, int numValues, int stride, float* history, float drive, float outputGain)
+    {
+        float x[2 * maxAdaaStride + adaaBlockSize];
+        float tail[2 * maxAdaaStride + adaaBlockSize];
+        const int past = 2 * stride;
+
+        for (int start = 0; start < numValues; start += adaaBlockSize)
+        {
+            const int count = numValues - start < adaaBlockSize ? numValues - start : adaaBlockSize;
+            float* const block = data + start;
+
+            std::memcpy(x, history, sizeof(float) * static_cast<size_t>(past));
+
+            forEachBlock<L>(count, [&](auto lanes, int i)
+            {
+                using V = decltype(lanes);
+                V::store(x + past + i, V::mul(V::load(block + i), V::broadcast(drive)));
+            });
+
+            forEachBlock<L>(stride + count, [&](auto lanes, int i)
+            {
+                using V = decltype(lanes);
+                V::store(tail + stride + i, logCoshTail<V>(abs<V>(V::load(x + stride + i))));
+            });
+
+            forEachBlock<L>(count, [&](auto lanes, int i)
+            {
+                using V = decltype(lanes);
+                const auto x0 = V::load(x + past + i);
+                const auto x1 = V::load(x + stride + i);
+                const auto d = V::sub(x0, x1);
+                const auto illConditioned = V::lessThan(abs<V>(d), V::broadcast(adaaTolerance1));
+
+                const auto rise = V::add(V::sub(abs<V>(x0), abs<V>(x1)),
+                                         V::sub(V::load(tail + past + i), V::load(tail + stride + i)));
+                auto y = V::div(rise, V::select(illConditioned, V::broadcast(1.0f), d));
+
+                if (V::any(illConditioned))
+                {
+                    const auto t = tanh<V>(V::mul(V::add(x0, x1), V::broadcast(0.5f)));
+                    const auto curvature = V::mul(V::mul(t, V::sub(V::broadcast(1.0f), V::mul(t, t))),
+                                                  V::mul(V::mul(d, d), V::broadcast(1.0f / 12.0f)));
+                    y = V::select(illConditioned, V::sub(t, curvature), y);
+                }
+
+                V::store(block + i, V::mul(y, V::broadcast(outputGain)));
+            });
+
+            std::memcpy(history, x + count, sizeof(float) * static_cast<size_t>(past));
+        }
+    }
+
+    /**
+     * Soft clipping con antialiasing del secondo ordine (ADAA2), in-place:
+     * y[n] = 2 outputGain (D[n] - D[n-1]) / (x[n] - x[n-2]), con
+     * D[n] = (F2(x[n]) - F2(x[n-1])) / (x[n] - x[n-1]) (ritardo di un campione).
+     * La parte polinomiale di F2 è in forma chiusa (con tre segni concordi il
+     * suo contributo è sign(x)), le differenze riguardano solo le code.
+     * Casi mal condizionati (distanze sotto adaaTolerance2):
+     * - x[n] ~ x[n-1]: D[n] = F1(m) + tanh'(m) d^2 / 24 nel punto medio;
+     * - x[n] ~ x[n-2]: il limite con i due ingressi nella media xm,
+     *   2 (F1(xm) - (F2(xm) - F2(x[n-1])) / dm) / dm con dm = xm - x[n-1];
+     * - tutti e tre vicini: tanh(m) + tanh''(m) S / 24, con m e S media e
+     *   somma degli scarti quadratici dei tre ingressi.
+     * @see softClipAdaa1 per stride e history
+     */
+    template <typename L>
+    inline void softClipAdaa2(float* data, int numValues, int stride, float* history, float drive, float outputGain)
+    {
+        float x[2 * maxAdaaStride + adaaBlockSize];
+        float tail[2 * maxAdaaStride + adaaBlockSize];
+        float tailSlope[2 * maxAdaaStride + adaaBlockSize];
+        const int past = 2 * stride;
+
+        for (int start = 0; start < numValues; start += adaaBlockSize)
+        {
+            const int count = numValues - start < adaaBlockSize ? numValues - start : adaaBlockSize;
+            float* const block = data + start;
+
+            std::memcpy(x, history, sizeof(float) * static_cast<size_t>(past));
+
+            forEachBlock<L>(count, [&](auto lanes, int i)
+            {
+                using V = decltype(lanes);
+                V::store(x + past + i, V::mul(V::load(block + i), V::broadcast(drive)));
+            });
+
+            forEachBlock<L>(past + count, [&](auto lanes, int i)
+            {
+                using V = decltype(lanes);
+                const auto value = V::load(x + i);
+                V::store(tail + i, copySign<V>(dilogTail<V>(abs<V>(value)), value));
+            });
+
+            // Parte di D dovuta alle code, tra ogni ingresso e il precedente dello stesso canale
+            forEachBlock<L>(stride + count, [&](auto lanes, int i)
+            {
+                using V = decltype(lanes);
+                const auto a = V::load(x + stride + i);
+                const auto b = V::load(x + i);
+                const auto d = V::sub(a, b);
+                const auto illConditioned = V::lessThan(abs<V>(d), V::broadcast(adaaTolerance2));
+
+                auto y = V::div(V::sub(V::load(tail + stride + i), V::load(tail + i)),
+                                V::select(illConditioned, V::broadcast(1.0f), d));
+
+                if (V::any(illConditioned))
+                {
+                    const auto m = V::mul(V::add(a, b), V::broadcast(0.5f));
+                    const auto t = tanh<V>(m);
+                    const auto curvature = V::mul(V::sub(V::broadcast(1.0f), V::mul(t, t)),
+                                                  V::mul(V::mul(d, d), V::broadcast(1.0f / 24.0f)));
+                    const auto meanF1 = V::add(V::sub(abs<V>(m), halfSquareSlope<V>(a, b)),
+                                               V::add(logCoshTail<V>(abs<V>(m)), curvature));
+                    y = V::select(illConditioned, meanF1, y);
+                }
+
+                V::store(tailSlope + stride + i, y);
+            });
+
+            forEachBlock<L>(count, [&](auto lanes, int i)
+            {
+                using V = decltype(lanes);
+                const auto one = V::broadcast(1.0f);
+                const auto tolerance = V::broadcast(adaaTolerance2);
+                const auto x0 = V::load(x + past + i);
+                const auto x1 = V::load(x + stride + i);
+                const auto x2 = V::load(x + i);
+                const auto d = V::sub(x0, x2);
+                const auto illConditioned = V::lessThan(abs<V>(d), tolerance);
+                const auto safeD = V::select(illConditioned, one, d);
+
+                const auto polynomialChange = V::sub(halfSquareSlope<V>(x0, x1), halfSquareSlope<V>(x1, x2));
+                const auto mixedSigns = V::div(V::add(polynomialChange, polynomialChange), safeD);
+                const auto polynomial = V::select(sameSign<V>(x0, x1),
+                                                  V::select(sameSign<V>(x1, x2), copySign<V>(one, x1), mixedSigns),
+                                                  mixedSigns);
+
+                const auto tailChange = V::sub(V::load(tailSlope + past + i), V::load(tailSlope + stride + i));
+                auto y = V::add(polynomial, V::div(V::add(tailChange, tailChange), safeD));
+
+                if (V::any(illConditioned))
+                {
+                    const auto mean = V::mul(V::add(x0, x2), V::broadcast(0.5f));
+                    const auto dm = V::sub(mean, x1);
+                    const auto close = V::lessThan(abs<V>(dm), tolerance);
+                    const auto safeDm = V::select(close, one, dm);
+
+                    // F1(xm) - D(xm, x1), separando parte polinomiale e code
+                    const auto polynomialLimit = V::sub(abs<V>(mean), halfSquareSlope<V>(mean, x1));
+                    const auto meanPolynomial = V::select(sameSign<V>(mean, x1), copySign<V>(one, mean),
+                                                          V::div(V::add(polynomialLimit, polynomialLimit), safeDm));
+
+                    const auto meanTail = copySign<V>(dilogTail<V>(abs<V>(mean)), mean);
+                    const auto tailLimit = V::sub(logCoshTail<V>(abs<V>(mean)),
+                                                  V::div(V::sub(meanTail, V::load(tail + stride + i)), safeDm));
+                    auto fallback = V::add(meanPolynomial, V::div(V::add(tailLimit, tailLimit), safeDm));
+
+                    if (V::any(close))
+                    {
+                        const auto m = V::mul(V::add(V::add(x0, x1), x2), V::broadcast(1.0f / 3.0f));
+                        const auto e0 = V::sub(x0, m);
+                        const auto e1 = V::sub(x1, m);
+                        const auto e2 = V::sub(x2, m);
+                        const auto spread = V::add(V::add(V::mul(e0, e0), V::mul(e1, e1)), V::mul(e2, e2));
+                        const auto t = tanh<V>(m);
+                        const auto curvature = V::mul(V::mul(t, V::sub(one, V::mul(t, t))),
+                                                      V::mul(spread, V::broadcast(1.0f / 12.0f)));
+                        fallback = V::select(close, V::sub(t, curvature), fallback);
+                    }
+
+                    y = V::select(illConditioned, fallback, y);
+                }
+
+                V::store(block + i, V::mul(y, V::broadcast(outputGain)));
+            });
+
+            std::memcpy(history, x + count, sizeof(float) * static_cast<size_t>(past));
+        }
+    }
+
+    template <typename L>
+    inline void sinCos(const float* input, float* sines, float* cosines, int numValues)
+    {
+        int i = 0;
+
+        for (; i + L::width <= numValues; i += L::width)
+        {
+            typename L::Vec sine, cosine;
+            sinCos<L>(L::load(input + i), sine, cosine);
+            L::store(sines + i, sine);
+            L::store(cosines + i, cosine);
+        }
+
+        for (; i < numValues; ++i)
+            sinCos<Lanes::Scalar>(input[i], sines[i], cosines[i]);
+    }
+}
+}
@@ -2,6 +2,8 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include "BiquadCascade.h"
+#include "BiquadDesign.h"
 
 //==============================================================================
 /**
@@ -54,22 +56,45 @@ public:
     virtual void setGain(float gainDb) { gain = gainDb; }
     virtual void setQ(float qVal) { q = qVal; }
     virtual void setSlope(int slopeIndex) { slope = slopeIndex; }
+    void setDesignMethod(BiquadDesign::Method newMethod) { designMethod = newMethod; }
+    void setCutResponse(BiquadDesign::CutResponse newResponse) { cutResponse = newResponse; }
 
     // Getters
     float getFrequency() const { return frequency; }
     float getGain() const { return gain; }
     float getQ() const { return q; }
     int getSlope() const { return slope; }
+    BiquadDesign::Method getDesignMethod() const { return designMethod; }
+    BiquadDesign::CutResponse getCutResponse() const { return cutResponse; }
     bool isEnabled() const { return enabled; }
     void setEnabled(bool shouldBeEnabled) { enabled = shouldBeEnabled; }
+
+    /**
+     * Collega il filtro a uno slot di banda del motore a cascata condiviso,
+     * dove vivono i suoi coefficienti e il suo stato.
+     * @param cascadeToUse Il motore a cascata della catena
+     * @param bandIndex Lo slot di banda assegnato
+     */
+    void attachToCascade(BiquadCascade* cascadeToUse, int bandIndex)
+    {
+        cascade = cascadeToUse;
+        cascadeBand = bandIndex;
+    }
+
+    int getCascadeBand() const { return cascadeBand; }
     
 protected:
     float frequency = 1000.0f;  // Hz
     float gain = 0.0f;          // dB
     float q = 0.707f;           // Q factor
     int slope = 1;              // 0=6dB, 1=12dB, 2=24dB, 3=48dB, 4=96dB
+    BiquadDesign::Method designMethod = BiquadDesign::Method::bilinear;
+    BiquadDesign::CutResponse cutResponse = BiquadDesign::CutResponse::butterworth;
     bool enabled = true;
     
     double currentSampleRate = 44100.0;
     int maxSamplesPerBlock = 512;
+
+    BiquadCascade* cascade = nullptr;
+    int cascadeBand = -1;
 };
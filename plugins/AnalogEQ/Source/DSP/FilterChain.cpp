@@ -1,51 +1,670 @@
 #include "FilterChain.h"
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+
+FilterChain::~FilterChain()
+{
+    designWorker.stop();
+}
 
 FilterBase* FilterChain::addFilter(FilterType filterType)
 {
-    auto filter = createFilter(filterType);
-    auto* filterPtr = filter.get();
-    
-    filter->prepare(currentSampleRate, currentSamplesPerBlock);
-    filters.push_back(std::move(filter));
+    const auto freeSlot = std::find_if(bandFilters.begin(), bandFilters.end(), [](const BandFilter& slot)
+    {
+        return std::holds_alternative<std::monostate>(slot);
+    });
+
+    if (freeSlot == bandFilters.end())
+        return nullptr;
+
+    const auto band = static_cast<int>(std::distance(bandFilters.begin(), freeSlot));
+    cascade.setNumSections(band, 1);
+    cascade.setSection(band, 0, {});
+    cascade.resetBand(band);
+    svf.resetBand(band);
+    svfSyncedBands &= ~(1u << band);
+    oversampledBands &= ~(1u << band);
+
+    auto& filter = emplaceFilter(*freeSlot, filterType);
+    filter.attachToCascade(&cascade, band);
+    filter.prepare(getBandSampleRate(band), currentSamplesPerBlock);
+    bandOrder[numFilters++] = band;
     
-    return filterPtr;
+    return &filter;
+}
+
+FilterBase* FilterChain::setFilterType(size_t index, FilterType filterType)
+{
+    auto* previous = getFilter(index);
+    if (previous == nullptr)
+        return nullptr;
+
+    const auto band = previous->getCascadeBand();
+    const auto frequency = previous->getFrequency();
+    const auto gain = previous->getGain();
+    const auto q = previous->getQ();
+    const auto slope = previous->getSlope();
+    const auto enabled = previous->isEnabled();
+
+    // Lo stato della banda resta nel motore: solo i coefficienti cambiano
+    auto& filter = emplaceFilter(bandFilters[static_cast<size_t>(band)], filterType);
+    filter.attachToCascade(&cascade, band);
+    filter.prepare(getBandSampleRate(band), currentSamplesPerBlock);
+    filter.setFrequency(frequency);
+    filter.setGain(gain);
+    filter.setQ(q);
+    filter.setSlope(slope);
+    filter.setEnabled(enabled);
+
+    // I coefficienti in arrivo dal worker (o in rampa) sono del tipo precedente
+    designCoefficientsInline(band);
+
+    return &filter;
+}
+
+bool FilterChain::scheduleFilterChange(size_t index, const BiquadDesign::BandParameters& requested)
+{
+    // Metodo di progetto e risposta sono quelli della catena
+    auto parameters = requested;
+    parameters.method = designMethod;
+    parameters.response = cutResponse;
+
+    auto* filter = getFilter(index);
+    if (filter == nullptr)
+        return false;
+
+    const auto band = filter->getCascadeBand();
+    if (crossfader.isActive(band))
+        return false;
+
+    // La topologia svf interpola anche il cambio di tipo: nessuna dissolvenza
+    if (!designWorker.isRunning() || topology == Topology::svf)
+    {
+        filter = setFilterType(index, parameters.type);
+        filter->setFrequency(parameters.frequency);
+        filter->setGain(parameters.gain);
+        filter->setQ(parameters.q);
+        filter->setSlope(parameters.slope);
+        filter->updateCoefficients(getBandSampleRate(band));
+        return true;
+    }
+
+    invalidateCoefficientUpdates(band);
+    pendingChanges[static_cast<size_t>(band)] = parameters;
+
+    // Rendering offline: progetto in linea, la dissolvenza resta deterministica
+    if (!asyncDesign)
+    {
+        BiquadDesign::SectionArray sections;
+        const auto numSections = BiquadDesign::designBand(parameters, getBandSampleRate(band), sections);
+        crossfader.begin(band, sections, numSections);
+        return true;
+    }
+
+    const auto generation = ++pendingGenerations[static_cast<size_t>(band)];
+    if (!designWorker.post({ DesignWorker::Kind::replacement, band, generation, parameters, getBandSampleRate(band), {}, 1 }))
+        return false;
+
+    crossfader.setPending(band);
+    return true;
+}
+
+void FilterChain::updateFilterCoefficients(size_t index)
+{
+    auto* filter = getFilter(index);
+    if (filter == nullptr)
+        return;
+
+    const auto band = filter->getCascadeBand();
+
+    if (!coefficientSmoothing && (!asyncDesign || !designWorker.isRunning()))
+    {
+        designCoefficientsInline(band);
+        return;
+    }
+
+    // Una richiesta per banda alla volta: le modifiche nel frattempo vengono
+    // raccolte e inviate all'arrivo del risultato, con i parametri più recenti.
+    // Una rampa in corso non le trattiene: la nuova riparte dal passo caricato
+    if (designInFlight[static_cast<size_t>(band)])
+        designQueued[static_cast<size_t>(band)] = true;
+    else
+        startCoefficientUpdate(band);
+}
+
+void FilterChain::setAsyncDesign(bool shouldDesignAsync)
+{
+    if (asyncDesign && !shouldDesignAsync)
+        flushCoefficientUpdates();
+
+    asyncDesign = shouldDesignAsync;
+}
+
+void FilterChain::setCoefficientSmoothing(bool shouldSmooth)
+{
+    if (coefficientSmoothing && !shouldSmooth)
+        for (int band = 0; band < BiquadCascade::maxBands; ++band)
+            finishCoefficientRamp(band);
+
+    coefficientSmoothing = shouldSmooth;
+}
+
+bool FilterChain::isFilterChangePending(size_t index) const
+{
+    return index < numFilters && crossfader.isActive(bandOrder[index]);
+}
+
+void FilterChain::finishFilterChanges()
+{
+    flushCoefficientUpdates();
+
+    for (int band = 0; band < BiquadCascade::maxBands; ++band)
+    {
+        if (!crossfader.isActive(band))
+            continue;
+
+        if (crossfader.getPhase(band) == BandCrossfader::Phase::pending)
+        {
+            // Il risultato del worker, se arriva, verrà scartato
+            ++pendingGenerations[static_cast<size_t>(band)];
+
+            BiquadDesign::SectionArray sections;
+            const auto numSections = BiquadDesign::designBand(pendingChanges[static_cast<size_t>(band)],
+                                                              getBandSampleRate(band), sections);
+            crossfader.begin(band, sections, numSections);
+        }
+
+        commitFilterChange(band);
+    }
+}
+
+FilterBase* FilterChain::getBandFilter(int band)
+{
+    return std::visit([](auto& filter) -> FilterBase*
+    {
+        if constexpr (std::is_same_v<std::decay_t<decltype(filter)>, std::monostate>)
+            return nullptr;
+        else
+            return &filter;
+    }, bandFilters[static_cast<size_t>(band)]);
+}
+
+void FilterChain::collectDesignResults()
+{
+    DesignWorker::Result result;
+
+    while (designWorker.fetch(result))
+    {
+        const auto band = result.band;
+
+        if (result.kind == DesignWorker::Kind::update)
+        {
+            designInFlight[static_cast<size_t>(band)] = false;
+
+            if (result.generation == designGenerations[static_cast<size_t>(band)] && getBandFilter(band) != nullptr)
+                applyDesignResult(result);
+
+            continue;
+        }
+
+        if (result.generation != pendingGenerations[static_cast<size_t>(band)]
+            || crossfader.getPhase(band) != BandCrossfader::Phase::pending)
+            continue;
+
+        crossfader.begin(band, result.getFinalSections(), result.numSections);
+
+        // Una banda disattivata non viene processata: subentra subito
+        const auto* filter = getBandFilter(band);
+        if (filter == nullptr || !filter->isEnabled())
+            commitFilterChange(band);
+    }
+
+    for (int band = 0; band < BiquadCascade::maxBands; ++band)
+    {
+        const auto b = static_cast<size_t>(band);
+
+        // Una banda non processata non avanzerebbe: la rampa salta alla fine
+        const auto* filter = getBandFilter(band);
+        if (filter == nullptr || !filter->isEnabled())
+            finishCoefficientRamp(band);
+
+        // Modifiche arrivate durante una richiesta in volo o a coda piena
+        if (designQueued[b] && !designInFlight[b])
+            startCoefficientUpdate(band);
+    }
+}
+
+void FilterChain::startCoefficientUpdate(int band)
+{
+    const auto b = static_cast<size_t>(band);
+    const bool async = asyncDesign && designWorker.isRunning();
+
+    // Una rampa ferma non deve restare sul punto di partenza: con modifiche a
+    // ogni blocco ogni rampa appena arrivata verrebbe fermata prima del primo
+    // passo e la banda non si muoverebbe mai. Il primo passo entra subito, e
+    // la nuova rampa parte da lì
+    auto& ramp = ramps[b];
+    if (async && ramp.isActive() && ramp.position == 0)
+    {
+        BiquadDesign::loadInto(cascade, band, ramp.steps[0], ramp.numSections);
+        ramp.position = 1;
+        ramp.countdown = rampStepSamples;
+    }
+
+    const auto request = makeUpdateRequest(band);
+
+    if (async)
+    {
+        // Coda piena: si riprova al blocco successivo
+        designQueued[b] = !designWorker.post(request);
+        designInFlight[b] = !designQueued[b];
+
+        // La rampa in corso resta sul passo da cui parte quella nuova
+        if (designInFlight[b] && ramps[b].isActive())
+            ramps[b].held = true;
+    }
+    else
+    {
+        designQueued[b] = false;
+        DesignWorker::design(request, inlineResult);
+        applyDesignResult(inlineResult);
+    }
+
+    if (!designQueued[b])
+    {
+        designedParameters[b] = request.parameters;
+        designedValid[b] = true;
+    }
+}
+
+DesignWorker::Request FilterChain::makeUpdateRequest(int band)
+{
+    const auto b = static_cast<size_t>(band);
+    DesignWorker::Request request { DesignWorker::Kind::update, band, designGenerations[b],
+                                    getDesignParameters(band), getBandSampleRate(band), {}, 1 };
+
+    // La rampa parte dal passo caricato (o dall'ultimo progetto, a rampa
+    // finita): tipo, slope e risposta devono coincidere
+    const auto from = ramps[b].isActive() ? ramps[b].getCurrentParameters() : designedParameters[b];
+    const auto& to = request.parameters;
+
+    if (coefficientSmoothing && topology == Topology::biquad && designedValid[b]
+        && from.type == to.type && from.slope == to.slope
+        && from.response == to.response
+        && (from.frequency != to.frequency || from.gain != to.gain || from.q != to.q))
+    {
+        request.rampFrom = from;
+        request.numSteps = DesignWorker::getRampLength(from, to);
+    }
+
+    return request;
+}
+
+void FilterChain::applyDesignResult(const DesignWorker::Result& result)
+{
+    const auto band = result.band;
+    auto& ramp = ramps[static_cast<size_t>(band)];
+    ramp.held = false;
+
+    if (result.numSteps == 1)
+    {
+        BiquadDesign::loadInto(cascade, band, result.getFinalSections(), result.numSections);
+        ramp.numSteps = 0;
+        ramp.position = 0;
+        return;
+    }
+
+    // I passi vengono caricati da advanceCoefficientRamps durante il processamento;
+    // una rampa in corso viene sostituita a partire dal passo su cui era ferma
+    std::copy(result.steps.begin(), result.steps.begin() + result.numSteps, ramp.steps.begin());
+    ramp.from = result.rampFrom;
+    ramp.to = result.parameters;
+    ramp.numSections = result.numSections;
+    ramp.numSteps = result.numSteps;
+    ramp.position = 0;
+    ramp.countdown = 0;
+}
+
+void FilterChain::designCoefficientsInline(int band)
+{
+    invalidateCoefficientUpdates(band);
+
+    if (auto* filter = getBandFilter(band))
+    {
+        filter->updateCoefficients(getBandSampleRate(band));
+        designedParameters[static_cast<size_t>(band)] = getDesignParameters(band);
+        designedValid[static_cast<size_t>(band)] = true;
+    }
+}
+
+void FilterChain::invalidateCoefficientUpdates(int band)
+{
+    const auto b = static_cast<size_t>(band);
+    ++designGenerations[b];
+    designQueued[b] = false;
+    designedValid[b] = false;
+
+    // Chi invalida progetta subito la banda: il passo caricato viene sostituito
+    ramps[b].numSteps = 0;
+    ramps[b].position = 0;
+    ramps[b].held = false;
+}
+
+void FilterChain::flushCoefficientUpdates()
+{
+    for (int band = 0; band < BiquadCascade::maxBands; ++band)
+    {
+        const auto b = static_cast<size_t>(band);
+        if (designInFlight[b] || designQueued[b] || ramps[b].isActive())
+            designCoefficientsInline(band);
+    }
+}
+
+void FilterChain::finishCoefficientRamp(int band)
+{
+    auto& ramp = ramps[static_cast<size_t>(band)];
+    if (!ramp.isActive())
+        return;
+
+    BiquadDesign::loadInto(cascade, band, ramp.steps[static_cast<size_t>(ramp.numSteps - 1)], ramp.numSections);
+    ramp.position = ramp.numSteps;
+}
+
+int FilterChain::advanceCoefficientRamps(const int* bands, int numBands, int maxSamples)
+{
+    int count = maxSamples;
+
+    for (int i = 0; i < numBands; ++i)
+    {
+        auto& ramp = ramps[static_cast<size_t>(bands[i])];
+        if (!ramp.isActive() || ramp.held)
+            continue;
+
+        if (ramp.countdown == 0)
+        {
+            BiquadDesign::loadInto(cascade, bands[i], ramp.steps[static_cast<size_t>(ramp.position++)], ramp.numSections);
+            ramp.countdown = rampStepSamples;
+        }
+
+        // Caricato l'ultimo passo la banda non limita più il blocco
+        if (ramp.isActive())
+            count = juce::jmin(count, ramp.countdown);
+    }
+
+    for (int i = 0; i < numBands; ++i)
+    {
+        auto& ramp = ramps[static_cast<size_t>(bands[i])];
+        if (ramp.isActive() && !ramp.held)
+            ramp.countdown -= count;
+    }
+
+    return count;
+}
+
+BiquadDesign::BandParameters FilterChain::getDesignParameters(int band)
+{
+    return std::visit([](auto& filter) -> BiquadDesign::BandParameters
+    {
+        if constexpr (std::is_same_v<std::decay_t<decltype(filter)>, std::monostate>)
+            return {};
+        else
+            return filter.getDesignParameters();
+    }, bandFilters[static_cast<size_t>(band)]);
+}
+
+void FilterChain::commitFilterChange(int band)
+{
+    const auto* previous = getBandFilter(band);
+    const bool enabled = previous != nullptr && previous->isEnabled();
+    const auto& parameters = pendingChanges[static_cast<size_t>(band)];
+
+    // Il nuovo filtro prende coefficienti e stato della banda sostitutiva
+    auto& filter = emplaceFilter(bandFilters[static_cast<size_t>(band)], parameters.type);
+    filter.attachToCascade(&cascade, band);
+    filter.prepare(getBandSampleRate(band), currentSamplesPerBlock);
+    filter.setFrequency(parameters.frequency);
+    filter.setGain(parameters.gain);
+    filter.setQ(parameters.q);
+    filter.setSlope(parameters.slope);
+    filter.setEnabled(enabled);
+
+    cascade.loadBand(band, crossfader.getRange(band));
+    crossfader.finish(band);
+
+    designedParameters[static_cast<size_t>(band)] = parameters;
+    designedValid[static_cast<size_t>(band)] = true;
 }
 
 void FilterChain::removeFilter(size_t index)
 {
-    if (index < filters.size())
-        filters.erase(filters.begin() + index);
+    if (index < numFilters)
+    {
+        const auto band = bandOrder[index];
+        ++pendingGenerations[static_cast<size_t>(band)];
+        invalidateCoefficientUpdates(band);
+        crossfader.finish(band);
+        oversampledBands &= ~(1u << band);
+
+        bandFilters[static_cast<size_t>(band)] = std::monostate {};
+        std::copy(bandOrder.begin() + static_cast<std::ptrdiff_t>(index) + 1,
+                  bandOrder.begin() + static_cast<std::ptrdiff_t>(numFilters),
+                  bandOrder.begin() + static_cast<std::ptrdiff_t>(index));
+        --numFilters;
+    }
 }
 
-void FilterChain::processBlock(juce::AudioBuffer<float>& buffer)
+void FilterChain::processBlock(juce::AudioBuffer<float>& buffer, Segment segment)
 {
-    // Processa il buffer attraverso ogni filtro in sequenza
-    for (auto& filter : filters)
+    const int numChannels = juce::jmin(buffer.getNumChannels(), BiquadCascade::maxChannels);
+    const int numSamples = buffer.getNumSamples();
+    if (numChannels == 0 || numSamples == 0)
+        return;
+
+    auto* const* channels = buffer.getArrayOfWritePointers();
+
+    // Risultati del worker e classificazione delle bande una volta per blocco,
+    // prima del segmento a frequenza base
+    if (segment != Segment::oversampled)
     {
-        if (filter && filter->isEnabled())
-            filter->process(buffer);
+        collectDesignResults();
+        updateOversampledBands();
     }
+    else if (oversampledBands == 0)
+    {
+        return;
+    }
+
+    // Forma parallela: cade in serie se la catena non è convertibile, se
+    // ha bande sovracampionate o finché il worker non ha pubblicato la prima
+    // forma. Al cambio di forma lo stato della forma che subentra è obsoleto.
+    const bool useParallel = topology == Topology::biquad && executionMode == ExecutionMode::parallel
+                          && oversampledBands == 0 && updateParallelForm();
+    if (useParallel != parallelActive)
+    {
+        if (useParallel)
+            parallelBank.reset();
+        else
+            cascade.reset();
+
+        resetSaturationStates();
+        parallelActive = useParallel;
+    }
+
+    if (useParallel)
+    {
+        // La forma parallela non ha stato per banda: i cambi di tipo
+        // subentrano appena la banda sostitutiva è pronta
+        if (crossfader.isAnyActive())
+            for (int band = 0; band < BiquadCascade::maxBands; ++band)
+                if (crossfader.isActive(band) && crossfader.getPhase(band) != BandCrossfader::Phase::pending)
+                    commitFilterChange(band);
+
+        // Le rampe avanzano nel motore a cascata; la forma parallela le segue
+        // a ogni nuovo progetto del worker
+        std::array<int, BiquadCascade::maxBands> bands;
+        const int numBands = getSegmentBands(Segment::whole, bands);
+        for (int start = 0; start < numSamples;)
+            start += advanceCoefficientRamps(bands.data(), numBands, numSamples - start);
+
+        if (parallelBandMask != 0)
+        {
+            parallelBank.process(channels, numChannels, numSamples);
+
+            if (getSaturationMask() != 0)
+                AnalogSaturation::process(channels, numChannels, numSamples, saturationAntialiasing, saturationStates[0]);
+        }
+        return;
+    }
+
+    const auto saturationMask = getSaturationMask();
+
+    // Le posizioni senza saturazione ripartono senza memoria quando tornano attive
+    if (segment != Segment::oversampled)
+        for (size_t i = 0; i < saturationStates.size(); ++i)
+            if ((saturationMask & (1u << i)) == 0)
+                saturationStates[i].reset();
+
+    // Posizioni di saturazione del segmento: quelle sovracampionate seguono le altre
+    std::array<int, BiquadCascade::maxBands> bands;
+    const int numBands = getSegmentBands(segment, bands);
+
+    int firstPosition = 0;
+    if (segment == Segment::oversampled)
+        forEachEnabledFilter(Segment::baseRate, [&](const auto&) { ++firstPosition; });
+
+    // Topologia svf: bande in serie, parametri interpolati dentro il motore
+    if (topology == Topology::svf)
+    {
+        syncSvfBands(bands.data(), numBands);
+
+        for (int i = 0; i < numBands; ++i)
+        {
+            const int position = firstPosition + i;
+            svf.processBand(bands[static_cast<size_t>(i)], channels, numChannels, numSamples);
+
+            if ((saturationMask & (1u << position)) != 0)
+                AnalogSaturation::process(channels, numChannels, numSamples, saturationAntialiasing,
+                                          saturationStates[static_cast<size_t>(position)]);
+        }
+
+        return;
+    }
+
+    // Durante una dissolvenza il percorso per banda (stesso risultato del fused)
+    if (executionMode == ExecutionMode::fused && !crossfader.isAnyActive())
+    {
+        TileContext context { this, firstPosition };
+
+        // Con una rampa in corso il buffer viene diviso ai cambi di passo
+        for (int start = 0; start < numSamples;)
+        {
+            const auto count = advanceCoefficientRamps(bands.data(), numBands, numSamples - start);
+
+            std::array<float*, BiquadCascade::maxChannels> chunk;
+            for (int ch = 0; ch < numChannels; ++ch)
+                chunk[static_cast<size_t>(ch)] = channels[ch] + start;
+
+            cascade.processBandsFused(bands.data(), numBands, chunk.data(), numChannels, count,
+                                      saturateTile, &context, saturationMask >> firstPosition);
+            start += count;
+        }
+
+        return;
+    }
+
+    // Processa il buffer attraverso ogni banda in sequenza
+    std::array<int, BiquadCascade::maxBands> completed;
+    int numCompleted = 0;
+
+    for (int i = 0; i < numBands; ++i)
+    {
+        auto band = bands[static_cast<size_t>(i)];
+        const int position = firstPosition + i;
+
+        if (crossfader.isActive(band))
+        {
+            if (crossfader.process(band, cascade, channels, numChannels, numSamples))
+                completed[static_cast<size_t>(numCompleted++)] = band;
+        }
+        else
+        {
+            for (int start = 0; start < numSamples;)
+            {
+                const auto count = advanceCoefficientRamps(&band, 1, numSamples - start);
+
+                std::array<float*, BiquadCascade::maxChannels> chunk;
+                for (int ch = 0; ch < numChannels; ++ch)
+                    chunk[static_cast<size_t>(ch)] = channels[ch] + start;
+
+                cascade.processBand(band, chunk.data(), numChannels, count);
+                start += count;
+            }
+        }
+
+        if ((saturationMask & (1u << position)) != 0)
+            AnalogSaturation::process(channels, numChannels, numSamples, saturationAntialiasing,
+                                      saturationStates[static_cast<size_t>(position)]);
+    }
+
+    // Consolidamento dopo il passaggio: sostituisce il filtro della banda
+    for (int i = 0; i < numCompleted; ++i)
+        commitFilterChange(completed[static_cast<size_t>(i)]);
 }
 
 void FilterChain::prepare(double sampleRate, int samplesPerBlock)
 {
+    finishFilterChanges();
+
     currentSampleRate = sampleRate;
     currentSamplesPerBlock = samplesPerBlock;
-    
-    for (auto& filter : filters)
-    {
-        if (filter)
-            filter->prepare(sampleRate, samplesPerBlock);
-    }
+    crossfader.prepare(sampleRate);
+    designWorker.start();
+    svfSyncedBands = 0;
+    invalidateParallelForm();
+
+    forEachFilter([&](auto& filter) { filter.prepare(getBandSampleRate(filter.getCascadeBand()), samplesPerBlock); });
+
+    resetSaturationStates();
 }
 
 void FilterChain::reset()
 {
-    for (auto& filter : filters)
-    {
-        if (filter)
-            filter->reset();
-    }
+    finishFilterChanges();
+
+    forEachFilter([](auto& filter) { filter.reset(); });
+
+    svf.reset();
+    parallelBank.reset();
+    resetSaturationStates();
+}
+
+void FilterChain::setSaturationAntialiasing(AnalogSaturation::Antialiasing newAntialiasing)
+{
+    if (newAntialiasing == saturationAntialiasing)
+        return;
+
+    // La memoria del modo precedente non è aggiornata: si riparte dal blocco successivo
+    saturationAntialiasing = newAntialiasing;
+    resetSaturationStates();
+}
+
+void FilterChain::resetSaturationStates()
+{
+    for (auto& state : saturationStates)
+        state.reset();
+}
+
+void FilterChain::saturateTile(void* context, int position, float* samples, int numChannels, int numFrames)
+{
+    const auto& tile = *static_cast<TileContext*>(context);
+    auto& chain = *tile.chain;
+    auto& state = chain.saturationStates[static_cast<size_t>(tile.firstPosition + position)];
+
+    if (numChannels == 2)
+        AnalogSaturation::processFrames(samples, numFrames, chain.saturationAntialiasing, state);
+    else
+        AnalogSaturation::process(&samples, 1, numFrames, chain.saturationAntialiasing, state);
 }
 
 float FilterChain::getTotalFrequencyResponse(float frequency) const
@@ -53,55 +672,387 @@ float FilterChain::getTotalFrequencyResponse(float frequency) const
     float totalResponse = 0.0f;
     
     // Somma le risposte in dB di tutti i filtri
-    for (const auto& filter : filters)
+    forEachFilter([&](const auto& filter)
     {
-        if (filter && filter->isEnabled())
-            totalResponse += filter->getFrequencyResponse(frequency);
-    }
+        if (filter.isEnabled())
+            totalResponse += filter.getFrequencyResponse(frequency);
+    });
     
     return totalResponse;
 }
 
+void FilterChain::publishResponseSnapshot()
+{
+    std::array<int, BiquadCascade::maxBands> bands;
+    const int numBands = getSegmentBands(Segment::whole, bands);
+
+    const auto revision = cascade.getRevision();
+    if (revision == publishedRevision && currentSampleRate == publishedSampleRate && numBands == publishedNumBands
+        && oversampledBands == publishedOversampledBands
+        && std::equal(bands.begin(), bands.begin() + numBands, publishedBands.begin()))
+        return;
+
+    // Tutti gli slot liberi sono in lettura: si riprova al blocco successivo
+    auto* snapshot = responseSnapshots.beginWrite();
+    if (snapshot == nullptr)
+        return;
+
+    snapshot->sampleRate = currentSampleRate;
+    snapshot->oversampledSampleRate = currentSampleRate * selectiveFactor;
+    snapshot->numSections = 0;
+    snapshot->numBaseRateSections = 0;
+
+    for (int i = 0; i < numBands; ++i)
+    {
+        const auto band = bands[static_cast<size_t>(i)];
+        if ((oversampledBands & (1u << band)) == 0)
+            snapshot->numBaseRateSections += cascade.getNumSections(band);
+
+        for (int s = 0; s < cascade.getNumSections(band); ++s)
+            snapshot->sections[static_cast<size_t>(snapshot->numSections++)] = cascade.getSection(band, s);
+    }
+
+    responseSnapshots.publish(*snapshot);
+
+    publishedBands = bands;
+    publishedNumBands = numBands;
+    publishedRevision = revision;
+    publishedSampleRate = currentSampleRate;
+    publishedOversampledBands = oversampledBands;
+}
+
 FilterBase* FilterChain::getFilter(size_t index)
 {
-    if (index < filters.size())
-        return filters[index].get();
-    return nullptr;
+    if (index >= numFilters)
+        return nullptr;
+
+    return getBandFilter(bandOrder[index]);
 }
 
 void FilterChain::updateAllCoefficients(double sampleRate)
 {
-    for (auto& filter : filters)
+    forEachFilter([&](auto& filter)
     {
-        if (filter)
-            filter->updateCoefficients(sampleRate);
-    }
+        const auto band = static_cast<size_t>(filter.getCascadeBand());
+        const bool oversampled = (oversampledBands & (1u << band)) != 0;
+        invalidateCoefficientUpdates(filter.getCascadeBand());
+        filter.updateCoefficients(oversampled ? sampleRate * selectiveFactor : sampleRate);
+
+        designedParameters[band] = filter.getDesignParameters();
+        designedValid[band] = true;
+    });
 }
 
-std::unique_ptr<FilterBase> FilterChain::createFilter(FilterType type)
+FilterBase& FilterChain::emplaceFilter(BandFilter& slot, FilterType type)
+{
+    auto& filter = constructFilter(slot, type);
+    filter.setDesignMethod(designMethod);
+    filter.setCutResponse(cutResponse);
+    return filter;
+}
+
+FilterBase& FilterChain::constructFilter(BandFilter& slot, FilterType type)
 {
     switch (type)
     {
         case FilterType::LowPass:
-            return std::make_unique<LowPassFilter>();
+            return slot.emplace<LowPassFilter>();
         case FilterType::HighPass:
-            return std::make_unique<HighPassFilter>();
+            return slot.emplace<HighPassFilter>();
         case FilterType::Bell:
-            return std::make_unique<BellFilter>();
+            return slot.emplace<BellFilter>();
         case FilterType::LowShelf:
-            return std::make_unique<LowShelfFilter>();
+            return slot.emplace<LowShelfFilter>();
         case FilterType::HighShelf:
-            return std::make_unique<HighShelfFilter>();
+            return slot.emplace<HighShelfFilter>();
         case FilterType::Notch:
-            return std::make_unique<NotchFilter>();
+            return slot.emplace<NotchFilter>();
         case FilterType::BandPass:
         default:
             // BandPass da implementare se necessario
-            return std::make_unique<BellFilter>(); // Default
+            return slot.emplace<BellFilter>(); // Default
     }
 }
 
 void FilterChain::removeAllFilters()
 {
-    filters.clear();
+    for (int band = 0; band < BiquadCascade::maxBands; ++band)
+    {
+        ++pendingGenerations[static_cast<size_t>(band)];
+        invalidateCoefficientUpdates(band);
+        crossfader.finish(band);
+    }
+
+    bandFilters.fill(std::monostate {});
+    numFilters = 0;
+    oversampledBands = 0;
+    cascade.reset();
+    svf.reset();
+    svfSyncedBands = 0;
+}
+
+void FilterChain::setSelectiveOversampling(int factor)
+{
+    factor = juce::jmax(1, factor);
+    if (factor == selectiveFactor)
+        return;
+
+    finishFilterChanges();
+    selectiveFactor = factor;
+
+    // Le bande che entrano o escono dal segmento vengono riprogettate da
+    // updateOversampledBands, quelle che restano cambiano frequenza
+    const auto previous = oversampledBands;
+    updateOversampledBands();
+
+    for (int band = 0; band < BiquadCascade::maxBands; ++band)
+    {
+        if ((previous & oversampledBands & (1u << band)) != 0)
+        {
+            if (auto* filter = getBandFilter(band))
+                filter->prepare(getBandSampleRate(band), currentSamplesPerBlock);
+
+            designCoefficientsInline(band);
+        }
+    }
+}
+
+void FilterChain::updateOversampledBands()
+{
+    const float threshold = selectiveOversamplingThreshold * 0.5f * static_cast<float>(currentSampleRate);
+    unsigned int changed = 0;
+
+    forEachFilter([&](const auto& filter)
+    {
+        const auto band = filter.getCascadeBand();
+        const auto bit = 1u << band;
+
+        // Una banda in dissolvenza resta nel suo segmento fino al consolidamento
+        if (crossfader.isActive(band))
+            return;
+
+        const bool oversampled = (oversampledBands & bit) != 0;
+        const bool wanted = selectiveFactor > 1
+                         && filter.getFrequency() > (oversampled ? threshold * selectiveOversamplingHysteresis : threshold);
+
+        if (wanted != oversampled)
+            changed |= bit;
+    });
+
+    if (changed == 0)
+        return;
+
+    oversampledBands ^= changed;
+
+    // Le bande spostate vengono riprogettate alla nuova frequenza; l'ordine
+    // delle posizioni di saturazione è cambiato
+    for (int band = 0; band < BiquadCascade::maxBands; ++band)
+    {
+        if ((changed & (1u << band)) == 0)
+            continue;
+
+        if (auto* filter = getBandFilter(band))
+            filter->prepare(getBandSampleRate(band), currentSamplesPerBlock);
+
+        designCoefficientsInline(band);
+    }
+
+    resetSaturationStates();
+}
+
+int FilterChain::getSegmentBands(Segment segment, std::array<int, BiquadCascade::maxBands>& bands) const
+{
+    int numBands = 0;
+    forEachEnabledFilter(segment, [&](const auto& filter) { bands[static_cast<size_t>(numBands++)] = filter.getCascadeBand(); });
+    return numBands;
+}
+
+void FilterChain::setDesignMethod(BiquadDesign::Method newMethod)
+{
+    if (newMethod == designMethod)
+        return;
+
+    finishFilterChanges();
+
+    designMethod = newMethod;
+    forEachFilter([&](auto& filter) { filter.setDesignMethod(designMethod); });
+    updateAllCoefficients(currentSampleRate);
+}
+
+void FilterChain::setCutResponse(BiquadDesign::CutResponse newResponse)
+{
+    if (newResponse == cutResponse)
+        return;
+
+    finishFilterChanges();
+
+    cutResponse = newResponse;
+    forEachFilter([&](auto& filter) { filter.setCutResponse(cutResponse); });
+    updateAllCoefficients(currentSampleRate);
+}
+
+void FilterChain::setTopology(Topology newTopology)
+{
+    if (newTopology == topology)
+        return;
+
+    // Dissolvenze e rampe a passi appartengono al motore biquad
+    finishFilterChanges();
+    topology = newTopology;
+
+    // Lo stato del motore che subentra è obsoleto
+    if (topology == Topology::svf)
+    {
+        svf.reset();
+        svfSyncedBands = 0;
+    }
+    else
+    {
+        cascade.reset();
+        parallelActive = false;
+    }
+
+    resetSaturationStates();
+}
+
+void FilterChain::syncSvfBands(const int* bands, int numBands)
+{
+    for (int i = 0; i < numBands; ++i)
+    {
+        const auto band = bands[i];
+        const auto bit = 1u << band;
+        const auto revision = cascade.getBandRevision(band);
+
+        // Una banda che cambia frequenza di progetto salta: i parametri delle
+        // due frequenze non sono confrontabili
+        const bool synced = (svfSyncedBands & bit) != 0 && ((svfOversampledBands ^ oversampledBands) & bit) == 0;
+        if (synced && revision == svfRevisions[static_cast<size_t>(band)])
+            continue;
+
+        std::array<BiquadCoefficients, BiquadCascade::maxSectionsPerBand> sections;
+        const int numSections = cascade.getNumSections(band);
+        for (int s = 0; s < numSections; ++s)
+            sections[static_cast<size_t>(s)] = cascade.getSection(band, s);
+
+        const auto rampSamples = synced ? juce::roundToInt(svfSmoothingSeconds * getBandSampleRate(band)) : 0;
+        svf.setTargets(band, sections.data(), numSections, rampSamples);
+
+        svfRevisions[static_cast<size_t>(band)] = revision;
+        svfSyncedBands |= bit;
+        svfOversampledBands = (svfOversampledBands & ~bit) | (oversampledBands & bit);
+    }
+}
+
+void FilterChain::setExecutionMode(ExecutionMode newMode)
+{
+    executionMode = newMode;
+}
+
+unsigned int FilterChain::getEnabledBandMask() const
+{
+    unsigned int mask = 0;
+
+    forEachFilter([&](const auto& filter)
+    {
+        if (filter.isEnabled())
+            mask |= 1u << filter.getCascadeBand();
+    });
+
+    return mask;
+}
+
+unsigned int FilterChain::getSaturationMask() const
+{
+    // Bit i: saturazione dopo la i-esima banda attiva, nell'ordine di processamento
+    unsigned int mask = 0;
+    int position = 0;
+
+    forEachEnabledFilter(Segment::whole, [&](const auto& filter)
+    {
+        if (saturationPlacement == SaturationPlacement::everyBand
+            || (saturationPlacement == SaturationPlacement::gainBands && filter.getGain() != 0.0f))
+            mask |= 1u << position;
+
+        ++position;
+    });
+
+    if (saturationPlacement == SaturationPlacement::chainOutput && position > 0)
+        mask = 1u << (position - 1);
+
+    return mask;
+}
+
+bool FilterChain::updateParallelForm()
+{
+    while (designWorker.fetch(parallelResult))
+    {
+        // Una richiesta alla volta: il risultato è sempre quello in volo
+        parallelInFlight = false;
+
+        if (parallelResult.generation == parallelGeneration)
+            applyParallelForm(parallelResult);
+    }
+
+    // Catena cambiata: la nuova forma parte appena il worker è libero,
+    // intanto resta in uso quella caricata
+    const auto mask = getEnabledBandMask();
+    const auto revision = cascade.getRevision();
+
+    if (!parallelInFlight && (!parallelRequested || mask != parallelRequestedMask || revision != parallelRequestedRevision))
+        requestParallelForm(mask, revision);
+
+    return parallelVerified;
+}
+
+void FilterChain::requestParallelForm(unsigned int mask, unsigned int revision)
+{
+    // Il prodotto delle funzioni di trasferimento non dipende dall'ordine
+    // delle bande: basta raccogliere le sezioni delle bande attive
+    parallelRequest.generation = parallelGeneration;
+    parallelRequest.sampleRate = currentSampleRate;
+    parallelRequest.numSections = 0;
+
+    for (int band = 0; band < BiquadCascade::maxBands; ++band)
+    {
+        if ((mask & (1u << band)) == 0)
+            continue;
+
+        for (int section = 0; section < cascade.getNumSections(band); ++section)
+            parallelRequest.sections[static_cast<size_t>(parallelRequest.numSections++)] = cascade.getSection(band, section);
+    }
+
+    parallelRequestedMask = mask;
+    parallelRequestedRevision = revision;
+
+    if (asyncDesign && designWorker.isRunning())
+    {
+        // Coda piena: si riprova al blocco successivo
+        parallelInFlight = designWorker.post(parallelRequest);
+        parallelRequested = parallelInFlight;
+    }
+    else
+    {
+        DesignWorker::designParallelForm(parallelRequest, parallelResult);
+        applyParallelForm(parallelResult);
+        parallelRequested = true;
+    }
+}
+
+void FilterChain::applyParallelForm(const DesignWorker::ParallelResult& result)
+{
+    // Una forma che non passa la verifica non viene caricata: la catena va in serie
+    parallelVerified = result.verified;
+    if (!parallelVerified)
+        return;
+
+    parallelBank.load(result.coefficients);
+    parallelBandMask = parallelRequestedMask;
+}
+
+void FilterChain::invalidateParallelForm()
+{
+    // Un risultato ancora in volo verrà scartato
+    ++parallelGeneration;
+    parallelRequested = false;
+    parallelVerified = false;
 }
@@ -2,27 +2,200 @@
 
 #include "FilterBase.h"
 #include "FilterTypes.h"
+#include "BiquadCascade.h"
+#include "SvfCascade.h"
+#include "ParallelFilterBank.h"
+#include "BandCrossfader.h"
+#include "DesignWorker.h"
+#include "ResponseSnapshot.h"
 #include <juce_audio_basics/juce_audio_basics.h>
-#include <vector>
-#include <memory>
+#include <array>
+#include <type_traits>
+#include <variant>
 
 //==============================================================================
 /**
  * Manager per la catena di filtri.
  * Gestisce un numero variabile di filtri e processa l'audio attraverso tutti.
+ *
+ * I filtri vivono in uno std::variant sui tipi concreti (final), uno per slot
+ * del motore a cascata: le chiamate per banda (risposta in frequenza,
+ * aggiornamento coefficienti) vengono risolte a compile time con std::visit
+ * invece che tramite la vtable, e gli indirizzi dei filtri restano stabili.
+ *
+ * I coefficienti vengono progettati dal DesignWorker (updateFilterCoefficients):
+ * il thread audio copia nel motore solo le sezioni pronte. In rendering
+ * offline o con setAsyncDesign(false) il progetto avviene in linea.
+ * Con setCoefficientSmoothing(true) una modifica di frequenza, gain o Q non
+ * salta ai nuovi coefficienti: il worker progetta anche i passi intermedi
+ * (sui parametri interpolati, al più 1/3 di ottava e 1.5 dB per passo:
+ * DesignWorker::getRampLength) e il thread audio ne carica uno ogni
+ * rampStepSamples campioni, senza progettare nulla.
+ *
+ * I cambi di tipo o di slope possono essere programmati (scheduleFilterChange):
+ * la banda sostitutiva viene progettata dal DesignWorker e subentra con una
+ * dissolvenza di BandCrossfader, senza click.
+ *
+ * Con Topology::svf le stesse sezioni vengono eseguite da SvfCascade, che
+ * interpola i parametri a ogni campione: rampe a passi e dissolvenze non
+ * servono più.
+ *
+ * Fuori dal thread audio la catena non va letta direttamente: i coefficienti
+ * attivi vengono pubblicati come copie immutabili (publishResponseSnapshot)
+ * e letti con readResponseSnapshot.
  */
 class FilterChain
 {
 public:
+    /**
+     * Modalità di esecuzione della catena.
+     * - cascade: le bande vengono processate in serie, sezione per sezione,
+     *   con la saturazione dopo ogni banda.
+     * - parallel: la funzione di trasferimento complessiva viene espansa in
+     *   fratti semplici (ParallelFilterBank) e le sezioni indipendenti girano
+     *   in parallelo nelle lane SIMD; la saturazione viene applicata una volta
+     *   sola in uscita. Conversione e verifica della risposta girano sul
+     *   DesignWorker: finché la prima forma non è pronta, o se la conversione
+     *   non è possibile o la verifica fallisce, la catena resta in serie. Ai
+     *   cambi (rampe comprese) resta in uso l'ultima forma pubblicata fino
+     *   all'arrivo di quella nuova.
+     * - fused: come cascade (stesso risultato), ma il buffer viene percorso
+     *   una volta sola: ogni tile di campioni attraversa tutte le bande e la
+     *   saturazione mentre è in cache.
+     */
+    enum class ExecutionMode
+    {
+        cascade = 0,
+        parallel,
+        fused
+    };
+
+    /**
+     * Dove viene applicata la saturazione analogica (solo sui canali filtrati).
+     * - everyBand: dopo ogni banda attiva.
+     * - chainOutput: una volta sola, dopo l'ultima banda attiva.
+     * - gainBands: dopo le bande attive con gain diverso da zero.
+     * La forma parallela satura sempre una volta in uscita, se almeno una
+     * banda lo richiede.
+     */
+    enum class SaturationPlacement
+    {
+        everyBand = 0,
+        chainOutput,
+        gainBands
+    };
+
+    /**
+     * Parte della catena da processare con il sovracampionamento selettivo
+     * (setSelectiveOversampling): tutta, le bande a frequenza base o quelle
+     * sovracampionate. Nell'ordine di processamento le bande a frequenza base
+     * vengono prima di quelle sovracampionate, ciascun gruppo nel proprio
+     * ordine.
+     */
+    enum class Segment
+    {
+        whole = 0,
+        baseRate,
+        oversampled
+    };
+
+    /**
+     * Struttura dei filtri che processa l'audio.
+     * - biquad: BiquadCascade in forma trasposta diretta II, con tutte le
+     *   modalità di esecuzione; le modifiche arrivano per blocco (o a passi
+     *   con setCoefficientSmoothing) e i cambi di tipo in dissolvenza.
+     * - svf: SvfCascade (TPT SVF) con le stesse sezioni progettate; ogni
+     *   modifica di frequenza, gain o Q, e anche di tipo o slope, viene
+     *   interpolata a ogni campione per svfSmoothingSeconds. Le bande
+     *   girano in serie: la modalità di esecuzione non conta.
+     */
+    enum class Topology
+    {
+        biquad = 0,
+        svf
+    };
+
     FilterChain() = default;
+    ~FilterChain();
     
     /**
      * Aggiunge un filtro alla catena.
      * @param filterType Il tipo di filtro da aggiungere
-     * @return Puntatore al filtro aggiunto
+     * @return Puntatore al filtro aggiunto, nullptr se tutti gli slot
+     *         del motore a cascata sono occupati
      */
     FilterBase* addFilter(FilterType filterType);
     
+    /**
+     * Cambia il tipo di un filtro sul posto.
+     * Il nuovo filtro viene costruito nello stesso slot (nessuna allocazione),
+     * eredita parametri, banda del motore e stato dei filtri, e riceve subito
+     * i coefficienti. Gli altri filtri non vengono toccati.
+     * @param index L'indice del filtro (nell'ordine di processamento)
+     * @param filterType Il nuovo tipo
+     * @return Puntatore al nuovo filtro, nullptr se l'indice non è valido
+     */
+    FilterBase* setFilterType(size_t index, FilterType filterType);
+
+    /**
+     * Programma un cambio di tipo/slope senza click: la banda sostitutiva viene
+     * progettata in background e, nei blocchi successivi, subentra con una
+     * dissolvenza. Fino al consolidamento il filtro resta quello corrente e
+     * isFilterChangePending restituisce true.
+     * Se il worker non è attivo, o con Topology::svf (che interpola anche
+     * il cambio di tipo), il cambio viene applicato subito.
+     * @param index L'indice del filtro (nell'ordine di processamento)
+     * @param parameters Tipo e parametri del filtro sostitutivo
+     * @return false se l'indice non è valido, se una transizione è già in
+     *         corso o se la coda del worker è piena (riprovare al blocco dopo)
+     */
+    bool scheduleFilterChange(size_t index, const BiquadDesign::BandParameters& parameters);
+
+    /**
+     * Aggiorna i coefficienti del filtro dopo una modifica dei parametri.
+     * Con il progetto asincrono la richiesta va al DesignWorker e le nuove
+     * sezioni entrano nel motore a un blocco successivo; altrimenti (o se il
+     * worker non è attivo) vengono progettate subito.
+     * @param index L'indice del filtro (nell'ordine di processamento)
+     */
+    void updateFilterCoefficients(size_t index);
+
+    /**
+     * Sceglie tra progetto dei coefficienti in background (default) e in
+     * linea. Da disattivare nel rendering offline, dove il risultato deve
+     * essere deterministico: le richieste in sospeso vengono progettate subito.
+     */
+    void setAsyncDesign(bool shouldDesignAsync);
+    bool isAsyncDesign() const { return asyncDesign; }
+
+    /**
+     * Attiva le rampe di coefficienti per le modifiche di frequenza, gain e Q
+     * (non per i cambi di tipo o slope, che usano la dissolvenza). Una
+     * modifica che arriva durante una rampa riparte dal passo caricato: la
+     * rampa in corso si ferma lì finché arriva quella nuova, così i parametri
+     * non saltano mai più di un passo. Disattivandola le rampe in corso
+     * saltano al progetto finale.
+     * Con Topology::svf le rampe a passi non vengono usate.
+     */
+    void setCoefficientSmoothing(bool shouldSmooth);
+    bool isCoefficientSmoothing() const { return coefficientSmoothing; }
+
+    /** Campioni per cui ogni passo di una rampa resta caricato. */
+    static constexpr int rampStepSamples = 32;
+
+    /**
+     * Indica se il filtro ha un cambio programmato non ancora consolidato.
+     */
+    bool isFilterChangePending(size_t index) const;
+
+    /**
+     * Consolida subito tutti i cambi programmati (progettando in linea quelli
+     * ancora in attesa del worker) e gli aggiornamenti dei coefficienti. Da
+     * chiamare quando la catena non viene processata (es. fase lineare) o a
+     * processamento fermo.
+     */
+    void finishFilterChanges();
+
     /**
      * Rimuove un filtro dalla catena.
      * @param index L'indice del filtro da rimuovere
@@ -31,9 +204,17 @@ public:
     
     /**
      * Processa un blocco di audio attraverso tutti i filtri.
+     * In modalità cascade il motore viene eseguito direttamente, banda per
+     * banda, seguito dallo stadio di saturazione di ogni banda; in modalità
+     * parallel viene usata la forma parallela, se disponibile; in modalità
+     * fused bande e saturazione vengono eseguite a tile in un solo passaggio.
+     * Con il sovracampionamento selettivo il segmento baseRate va processato
+     * per primo, alla frequenza della catena, e il segmento oversampled poi
+     * sugli stessi campioni sovracampionati; la forma parallela non è usata.
      * @param buffer Il buffer audio da processare
+     * @param segment Le bande da processare
      */
-    void processBlock(juce::AudioBuffer<float>& buffer);
+    void processBlock(juce::AudioBuffer<float>& buffer, Segment segment = Segment::whole);
     
     /**
      * Prepara la catena per la riproduzione.
@@ -51,16 +232,35 @@ public:
      * @return Il guadagno totale in dB
      */
     float getTotalFrequencyResponse(float frequency) const;
+
+    /**
+     * Thread audio (o processamento fermo): pubblica una copia dei
+     * coefficienti attivi se sono cambiati dall'ultima pubblicazione.
+     * Non alloca e non blocca; costa un confronto quando nulla è cambiato.
+     */
+    void publishResponseSnapshot();
+
+    /**
+     * Qualsiasi thread: acquisisce l'ultima copia pubblicata dei coefficienti.
+     * getTotalFrequencyResponse sulla copia è snapshot->getResponseDb.
+     */
+    ResponseSnapshotPublisher::Reader readResponseSnapshot() const { return responseSnapshots.read(); }
+
+    /**
+     * Qualsiasi thread: versione dell'ultima copia pubblicata.
+     */
+    unsigned int getResponseSnapshotVersion() const { return responseSnapshots.getVersion(); }
     
     /**
-     * Ottiene un filtro specifico.
+     * Ottiene un filtro specifico (nell'ordine di processamento).
+     * Il puntatore resta valido finché il filtro non viene rimosso.
      */
     FilterBase* getFilter(size_t index);
     
     /**
      * Ottiene il numero di filtri nella catena.
      */
-    size_t getNumFilters() const { return filters.size(); }
+    size_t getNumFilters() const { return numFilters; }
     
     /**
      * Aggiorna i coefficienti di tutti i filtri.
@@ -71,11 +271,267 @@ public:
      * Rimuove tutti i filtri dalla catena.
      */
     void removeAllFilters();
-    
+
+    /**
+     * Sovracampionamento selettivo: con factor > 1 le bande la cui frequenza
+     * (centro o taglio) supera selectiveOversamplingThreshold di Nyquist
+     * vengono progettate a factor volte la frequenza della catena e
+     * processate nel segmento oversampled. Le bande vengono riclassificate a
+     * ogni blocco, con isteresi; una banda che cambia segmento viene
+     * riprogettata subito. Con factor 1 tutte le bande sono a frequenza base.
+     */
+    void setSelectiveOversampling(int factor);
+    int getSelectiveOversamplingFactor() const { return selectiveFactor; }
+
+    /** Bande sovracampionate, un bit per slot del motore a cascata. */
+    unsigned int getOversampledBandMask() const { return oversampledBands; }
+
+    /** Frequenza di progetto di una banda (slot del motore a cascata). */
+    double getBandSampleRate(int band) const
+    {
+        return (oversampledBands & (1u << band)) != 0 ? currentSampleRate * selectiveFactor : currentSampleRate;
+    }
+
+    /** Frazione di Nyquist sopra cui una banda viene sovracampionata. */
+    static constexpr float selectiveOversamplingThreshold = 0.25f;
+
+    /** La banda torna a frequenza base sotto questa frazione della soglia. */
+    static constexpr float selectiveOversamplingHysteresis = 0.8f;
+
+    /**
+     * Imposta il metodo di progetto dei coefficienti (BiquadDesign::Method)
+     * per tutti i filtri, anche quelli creati in seguito, e riprogetta subito
+     * tutte le bande. I cambi programmati in corso vengono consolidati prima.
+     */
+    void setDesignMethod(BiquadDesign::Method newMethod);
+    BiquadDesign::Method getDesignMethod() const { return designMethod; }
+
+    /**
+     * Come setDesignMethod, per la risposta dei passa-basso/passa-alto
+     * (BiquadDesign::CutResponse). Il numero di sezioni delle bande può
+     * cambiare: il passaggio non è in dissolvenza.
+     */
+    void setCutResponse(BiquadDesign::CutResponse newResponse);
+    BiquadDesign::CutResponse getCutResponse() const { return cutResponse; }
+
+    /**
+     * Imposta la topologia dei filtri. I cambi programmati e le rampe in
+     * corso vengono consolidati prima; il motore che subentra parte da stato
+     * nullo.
+     */
+    void setTopology(Topology newTopology);
+    Topology getTopology() const { return topology; }
+
+    /** Durata dell'interpolazione per campione della topologia svf. */
+    static constexpr double svfSmoothingSeconds = 0.02;
+
+    /**
+     * Imposta la modalità di esecuzione della catena.
+     */
+    void setExecutionMode(ExecutionMode newMode);
+    ExecutionMode getExecutionMode() const { return executionMode; }
+
+    /**
+     * Imposta dove viene applicata la saturazione.
+     */
+    void setSaturationPlacement(SaturationPlacement newPlacement) { saturationPlacement = newPlacement; }
+    SaturationPlacement getSaturationPlacement() const { return saturationPlacement; }
+
+    /**
+     * Imposta l'antialiasing della saturazione (AnalogSaturation::Antialiasing).
+     */
+    void setSaturationAntialiasing(AnalogSaturation::Antialiasing newAntialiasing);
+    AnalogSaturation::Antialiasing getSaturationAntialiasing() const { return saturationAntialiasing; }
+
+    /**
+     * Indica se l'ultimo blocco è stato processato in forma parallela.
+     */
+    bool isParallelFormActive() const { return parallelActive; }
+
 private:
-    std::vector<std::unique_ptr<FilterBase>> filters;
+    using BandFilter = std::variant<std::monostate,
+                                    LowPassFilter,
+                                    HighPassFilter,
+                                    BellFilter,
+                                    LowShelfFilter,
+                                    HighShelfFilter,
+                                    NotchFilter>;
+
+    // Filtri indicizzati per slot di banda del motore, e ordine di processamento
+    std::array<BandFilter, BiquadCascade::maxBands> bandFilters;
+    std::array<int, BiquadCascade::maxBands> bandOrder {};
+    size_t numFilters = 0;
+
+    BiquadCascade cascade;
     double currentSampleRate = 44100.0;
     int currentSamplesPerBlock = 512;
+
+    // Cambi di tipo/slope programmati, per slot di banda
+    BandCrossfader crossfader;
+    DesignWorker designWorker;
+    std::array<BiquadDesign::BandParameters, BiquadCascade::maxBands> pendingChanges {};
+    std::array<unsigned int, BiquadCascade::maxBands> pendingGenerations {};
+
+    // Aggiornamenti dei coefficienti progettati in background, per slot di banda
+    std::array<unsigned int, BiquadCascade::maxBands> designGenerations {};
+    std::array<bool, BiquadCascade::maxBands> designInFlight {};
+    std::array<bool, BiquadCascade::maxBands> designQueued {};
+    bool asyncDesign = true;
+
+    // Rampe di coefficienti in corso, per slot di banda
+    struct CoefficientRamp
+    {
+        std::array<BiquadDesign::SectionArray, DesignWorker::maxRampLength> steps;
+        BiquadDesign::BandParameters from, to;
+        int numSections = 0;
+        int numSteps = 0;
+        int position = 0;       // prossimo passo da caricare
+        int countdown = 0;      // campioni rimasti del passo caricato
+        bool held = false;      // fermata in attesa della rampa che la sostituisce
+
+        bool isActive() const { return position < numSteps; }
+
+        /** Parametri del passo caricato (from prima del primo passo). */
+        BiquadDesign::BandParameters getCurrentParameters() const
+        {
+            return BiquadDesign::interpolate(from, to, static_cast<float>(position) / static_cast<float>(numSteps));
+        }
+    };
+
+    std::array<CoefficientRamp, BiquadCascade::maxBands> ramps;
+    DesignWorker::Result inlineResult;
+
+    // Parametri dell'ultimo progetto richiesto: punto di partenza della rampa
+    std::array<BiquadDesign::BandParameters, BiquadCascade::maxBands> designedParameters {};
+    std::array<bool, BiquadCascade::maxBands> designedValid {};
+    bool coefficientSmoothing = false;
+
+    // Copie dei coefficienti per le letture fuori dal thread audio
+    ResponseSnapshotPublisher responseSnapshots;
+    std::array<int, BiquadCascade::maxBands> publishedBands {};
+    int publishedNumBands = -1;
+    unsigned int publishedRevision = 0;
+    double publishedSampleRate = 0.0;
+
+    BiquadDesign::Method designMethod = BiquadDesign::Method::bilinear;
+    BiquadDesign::CutResponse cutResponse = BiquadDesign::CutResponse::butterworth;
+    int selectiveFactor = 1;
+    unsigned int oversampledBands = 0;
+    unsigned int publishedOversampledBands = 0;
+    ExecutionMode executionMode = ExecutionMode::cascade;
+    Topology topology = Topology::biquad;
+
+    // Motore SVF: segue i coefficienti di cascade per revisione di banda.
+    // Le bande fuori da svfSyncedBands (nuove, dopo prepare o un cambio di
+    // frequenza di progetto) saltano ai coefficienti senza interpolare.
+    SvfCascade svf;
+    std::array<unsigned int, BiquadCascade::maxBands> svfRevisions {};
+    unsigned int svfSyncedBands = 0;
+    unsigned int svfOversampledBands = 0;
+
+    SaturationPlacement saturationPlacement = SaturationPlacement::everyBand;
+
+    // Memoria dell'antialiasing per posizione di saturazione (la forma parallela usa la prima)
+    AnalogSaturation::Antialiasing saturationAntialiasing = AnalogSaturation::Antialiasing::none;
+    std::array<AnalogSaturation::State, BiquadCascade::maxBands> saturationStates;
+    // Forma parallela: progettata dal DesignWorker per bande attive e
+    // revisione del motore, caricata nel banco quando arriva
+    ParallelFilterBank parallelBank;
+    DesignWorker::ParallelRequest parallelRequest;
+    DesignWorker::ParallelResult parallelResult;
+    unsigned int parallelGeneration = 0;
+    unsigned int parallelRequestedRevision = 0;
+    unsigned int parallelRequestedMask = 0;
+    unsigned int parallelBandMask = 0;      // bande della forma caricata
+    bool parallelRequested = false;
+    bool parallelInFlight = false;
+    bool parallelVerified = false;
+    bool parallelActive = false;
     
-    std::unique_ptr<FilterBase> createFilter(FilterType type);
+    FilterBase& emplaceFilter(BandFilter& slot, FilterType type);
+    static FilterBase& constructFilter(BandFilter& slot, FilterType type);
+
+    FilterBase* getBandFilter(int band);
+    void collectDesignResults();
+    void commitFilterChange(int band);
+    void startCoefficientUpdate(int band);
+    DesignWorker::Request makeUpdateRequest(int band);
+    void applyDesignResult(const DesignWorker::Result& result);
+    void designCoefficientsInline(int band);
+    void invalidateCoefficientUpdates(int band);
+    void flushCoefficientUpdates();
+    void finishCoefficientRamp(int band);
+    int advanceCoefficientRamps(const int* bands, int numBands, int maxSamples);
+    BiquadDesign::BandParameters getDesignParameters(int band);
+
+    /**
+     * Chiama fn con il tipo concreto di ogni filtro, nell'ordine di processamento.
+     */
+    template <typename Function>
+    void forEachFilter(Function&& fn) const
+    {
+        for (size_t i = 0; i < numFilters; ++i)
+        {
+            std::visit([&fn](const auto& filter)
+            {
+                if constexpr (!std::is_same_v<std::decay_t<decltype(filter)>, std::monostate>)
+                    fn(filter);
+            }, bandFilters[static_cast<size_t>(bandOrder[i])]);
+        }
+    }
+
+    template <typename Function>
+    void forEachFilter(Function&& fn)
+    {
+        for (size_t i = 0; i < numFilters; ++i)
+        {
+            std::visit([&fn](auto& filter)
+            {
+                if constexpr (!std::is_same_v<std::decay_t<decltype(filter)>, std::monostate>)
+                    fn(filter);
+            }, bandFilters[static_cast<size_t>(bandOrder[i])]);
+        }
+    }
+    /**
+     * Chiama fn con i filtri abilitati del segmento, nell'ordine di
+     * processamento del segmento (per whole: prima quelli a frequenza base).
+     */
+    template <typename Function>
+    void forEachEnabledFilter(Segment segment, Function&& fn) const
+    {
+        const auto visit = [&](bool oversampled)
+        {
+            forEachFilter([&](const auto& filter)
+            {
+                if (filter.isEnabled() && ((oversampledBands >> filter.getCascadeBand()) & 1u) == (oversampled ? 1u : 0u))
+                    fn(filter);
+            });
+        };
+
+        if (segment != Segment::oversampled)
+            visit(false);
+        if (segment != Segment::baseRate)
+            visit(true);
+    }
+
+    int getSegmentBands(Segment segment, std::array<int, BiquadCascade::maxBands>& bands) const;
+    void updateOversampledBands();
+    void syncSvfBands(const int* bands, int numBands);
+
+    unsigned int getEnabledBandMask() const;
+    unsigned int getSaturationMask() const;
+    void resetSaturationStates();
+
+    /** Contesto di saturateTile: le posizioni del segmento partono da firstPosition. */
+    struct TileContext
+    {
+        FilterChain* chain = nullptr;
+        int firstPosition = 0;
+    };
+
+    static void saturateTile(void* context, int position, float* samples, int numChannels, int numFrames);
+    bool updateParallelForm();
+    void requestParallelForm(unsigned int mask, unsigned int revision);
+    void applyParallelForm(const DesignWorker::ParallelResult& result);
+    void invalidateParallelForm();
 };
@@ -0,0 +1,462 @@
+#include "HighOrderDesign.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cmath>
+#include <complex>
+#include <limits>
+
+namespace
+{
+    using BiquadDesign::CutResponse;
+    using BiquadDesign::Method;
+    using Complex = std::complex<double>;
+
+    constexpr double pi = juce::MathConstants<double>::pi;
+    constexpr double butterworthQ = 0.70710678118654752;
+
+    /** Ordine nominale dello slope: 6 dB/ottava per ordine. */
+    int getNominalOrder(int slope)
+    {
+        switch (slope)
+        {
+            case 0: return 1;
+            case 1: return 2;
+            case 2: return 4;
+            case 3: return 8;
+            case 4: return 16;
+            default: return 2;
+        }
+    }
+
+    /** Q della k-esima coppia di poli (k = 1 la più risonante) di un Butterworth di ordine order. */
+    double butterworthPoleQ(int order, int k)
+    {
+        return 1.0 / (2.0 * std::cos(static_cast<double>(2 * k - 1) * pi / static_cast<double>(2 * order)));
+    }
+
+    /** s = K (1 - z^-1) / (1 + z^-1), con K che porta 1 rad/s a frequency. */
+    double bilinearConstant(double sampleRate, float frequency)
+    {
+        return 1.0 / std::tan(pi * juce::jlimit(1.0e-6, 0.4999, static_cast<double>(frequency) / sampleRate));
+    }
+
+    /**
+     * Sezione analogica (b2 s² + b1 s + b0) / (a2 s² + a1 s + a0) con taglio
+     * a 1 rad/s, portata in digitale con la bilineare precompensata: il
+     * taglio cade esattamente a frequency.
+     */
+    BiquadCoefficients bilinear(double b2, double b1, double b0, double a2, double a1, double a0,
+                                double sampleRate, float frequency)
+    {
+        const double k = bilinearConstant(sampleRate, frequency);
+        const double kk = k * k;
+        const double a0inv = 1.0 / (a2 * kk + a1 * k + a0);
+
+        return { static_cast<float>((b2 * kk + b1 * k + b0) * a0inv),
+                 static_cast<float>(2.0 * (b0 - b2 * kk) * a0inv),
+                 static_cast<float>((b2 * kk - b1 * k + b0) * a0inv),
+                 static_cast<float>(2.0 * (a0 - a2 * kk) * a0inv),
+                 static_cast<float>((a2 * kk - a1 * k + a0) * a0inv) };
+    }
+
+    /** Come bilinear, per (b1 s + b0) / (a1 s + a0). */
+    BiquadCoefficients bilinearFirstOrder(double b1, double b0, double a1, double a0, double sampleRate, float frequency)
+    {
+        const double k = bilinearConstant(sampleRate, frequency);
+        const double a0inv = 1.0 / (a1 * k + a0);
+
+        return { static_cast<float>((b1 * k + b0) * a0inv), static_cast<float>((b0 - b1 * k) * a0inv), 0.0f,
+                 static_cast<float>((a0 - a1 * k) * a0inv), 0.0f };
+    }
+
+    /** Sezione digitale normalizzata per a0 (coefficienti in double). */
+    BiquadCoefficients normalise(double b0, double b1, double b2, double a0, double a1, double a2)
+    {
+        const double a0inv = 1.0 / a0;
+        return { static_cast<float>(b0 * a0inv), static_cast<float>(b1 * a0inv), static_cast<float>(b2 * a0inv),
+                 static_cast<float>(a1 * a0inv), static_cast<float>(a2 * a0inv) };
+    }
+
+    /**
+     * Radice in z del fattore (s - r) dopo la trasformazione passa-banda:
+     * (1 - r) z² - 2 c0 z + (1 + r) = 0, ramo "+". Poli e zeri della stessa
+     * sezione analogica hanno lo stesso argomento e quindi lo stesso ramo.
+     */
+    Complex bandpassRoot(Complex r, double c0)
+    {
+        return (c0 + std::sqrt(c0 * c0 - 1.0 + r * r)) / (1.0 - r);
+    }
+
+    /**
+     * Rete di sicurezza per l'arrotondamento in float: le sezioni restano nel
+     * triangolo di stabilità |a2| < 1, |a1| < 1 + a2. Con il limite di banda
+     * di peak non dovrebbe mai intervenire (lo verifica HighOrderDesignTests).
+     */
+    BiquadCoefficients stabilise(BiquadCoefficients c)
+    {
+        constexpr float margin = HighOrderDesign::stabilityMargin;
+        c.a2 = juce::jlimit(-1.0f + margin, 1.0f - margin, c.a2);
+
+        const float limit = (1.0f + c.a2) * (1.0f - margin);
+        c.a1 = juce::jlimit(-limit, limit, c.a1);
+        return c;
+    }
+
+    /** Biquad con zeri zero, zero* e poli pole, pole*, guadagno unitario in reference (±1). */
+    BiquadCoefficients fromRoots(Complex zero, Complex pole, double reference)
+    {
+        const double b1 = -2.0 * zero.real();
+        const double b2 = std::norm(zero);
+        const double a1 = -2.0 * pole.real();
+        const double a2 = std::norm(pole);
+        const double scale = (1.0 + a1 * reference + a2) / (1.0 + b1 * reference + b2);
+
+        return stabilise({ static_cast<float>(scale), static_cast<float>(scale * b1), static_cast<float>(scale * b2),
+                           static_cast<float>(a1), static_cast<float>(a2) });
+    }
+
+    //==========================================================================
+    // Funzioni ellittiche di Jacobi con le trasformazioni di Landen (Orfanidis)
+
+    constexpr int maxLandenSteps = 8;
+
+    struct Landen
+    {
+        double modulus = 0.0;
+        std::array<double, maxLandenSteps> sequence {};
+        int steps = 0;
+    };
+
+    /** Moduli discendenti k_n = (k_{n-1} / (1 + k'_{n-1}))², fino a precisione di macchina. */
+    Landen landen(double k)
+    {
+        Landen result;
+        result.modulus = k;
+
+        while (result.steps < maxLandenSteps && k > 1.0e-15)
+        {
+            k = k / (1.0 + std::sqrt(1.0 - k * k));
+            k *= k;
+            result.sequence[static_cast<size_t>(result.steps++)] = k;
+        }
+
+        return result;
+    }
+
+    /** Risale la sequenza di Landen da w = cos o sin(u π/2) (modulo nullo). */
+    Complex ascend(const Landen& landenSequence, Complex w)
+    {
+        for (int n = landenSequence.steps - 1; n >= 0; --n)
+        {
+            const double v = landenSequence.sequence[static_cast<size_t>(n)];
+            w = (1.0 + v) * w / (1.0 + v * w * w);
+        }
+
+        return w;
+    }
+
+    /** cd(u K, k): u normalizzato al quarto di periodo K. */
+    Complex cde(Complex u, const Landen& landenSequence)
+    {
+        return ascend(landenSequence, std::cos(u * (0.5 * pi)));
+    }
+
+    /** sn(u K, k). */
+    Complex sne(Complex u, const Landen& landenSequence)
+    {
+        return ascend(landenSequence, std::sin(u * (0.5 * pi)));
+    }
+
+    /**
+     * asne(j y, k) / j per y reale: con argomento immaginario puro la
+     * discesa di Landen resta immaginaria e l'inversa è reale.
+     */
+    double asneImaginary(double y, const Landen& landenSequence)
+    {
+        double previous = landenSequence.modulus;
+        for (int n = 0; n < landenSequence.steps; ++n)
+        {
+            const double v = landenSequence.sequence[static_cast<size_t>(n)];
+            y = y / (1.0 + std::sqrt(1.0 + y * y * previous * previous)) * 2.0 / (1.0 + v);
+            previous = v;
+        }
+
+        return 2.0 / pi * std::asinh(y);
+    }
+
+    /** Integrale ellittico completo K(k) con la media aritmetico-geometrica. */
+    double ellipticK(double k)
+    {
+        double a = 1.0;
+        double g = std::sqrt(1.0 - k * k);
+
+        for (int i = 0; i < 16 && std::abs(a - g) > 1.0e-15 * a; ++i)
+        {
+            const double mean = 0.5 * (a + g);
+            g = std::sqrt(a * g);
+            a = mean;
+        }
+
+        return pi / (2.0 * a);
+    }
+
+    /** Rapporto K'(k) / K(k). */
+    double periodRatio(double k)
+    {
+        return ellipticK(std::sqrt(1.0 - k * k)) / ellipticK(k);
+    }
+
+    /**
+     * Selettività k che risolve l'equazione del grado N K'(k)/K(k) = K'(k1)/K(k1),
+     * dal nomio q = exp(-π K'/K).
+     */
+    double solveDegreeEquation(int order, double k1)
+    {
+        const double q = std::exp(-pi * periodRatio(k1) / static_cast<double>(order));
+        double numerator = 1.0;
+        double denominator = 1.0;
+
+        for (int m = 1; m <= 7; ++m)
+        {
+            numerator += std::pow(q, m * (m + 1));
+            denominator += 2.0 * std::pow(q, m * m);
+        }
+
+        return 4.0 * std::sqrt(q) * juce::square(numerator / denominator);
+    }
+
+    /** ε della banda passante e della banda oscura. */
+    double passbandEpsilon() { return std::sqrt(std::pow(10.0, 0.1 * HighOrderDesign::ellipticPassbandRippleDb) - 1.0); }
+    double stopbandEpsilon(double stopbandDb) { return std::sqrt(std::pow(10.0, 0.1 * stopbandDb) - 1.0); }
+}
+
+int HighOrderDesign::getMinimumEllipticOrder(double stopbandDb)
+{
+    // Selettività: bordo della banda oscura a un'ottava dal taglio
+    const double k = 0.5;
+    const double k1 = passbandEpsilon() / stopbandEpsilon(stopbandDb);
+    const double order = periodRatio(k1) / periodRatio(k);
+
+    // Margine per gli arrotondamenti quando l'ordine esatto è intero
+    return juce::jmax(1, static_cast<int>(std::ceil(order - 1.0e-9)));
+}
+
+int HighOrderDesign::getCutOrder(int slope, BiquadDesign::CutResponse response)
+{
+    const int nominal = getNominalOrder(slope);
+
+    // Fino a 12 dB/ottava le tre risposte coincidono (salvo LR2)
+    if (response == CutResponse::elliptic && nominal > 2)
+        return getMinimumEllipticOrder(6.0 * nominal);
+
+    return nominal;
+}
+
+int HighOrderDesign::getCutSections(int slope, BiquadDesign::CutResponse response)
+{
+    return juce::jmin(BiquadCascade::maxSectionsPerBand, (getCutOrder(slope, response) + 1) / 2);
+}
+
+int HighOrderDesign::getBellOrder(int slope)
+{
+    static constexpr std::array<int, 5> orders { 1, 2, 3, 4, 6 };
+    return orders[static_cast<size_t>(juce::jlimit(0, 4, slope))];
+}
+
+int HighOrderDesign::getShelfOrder(int slope)
+{
+    return juce::jmin(2 * BiquadCascade::maxSectionsPerBand, getNominalOrder(slope));
+}
+
+int HighOrderDesign::peak(int order, double sampleRate, float frequency, float q, float gainDb,
+                          BiquadDesign::SectionArray& sections)
+{
+    const double omega0 = 2.0 * pi * juce::jlimit(1.0e-6, 0.4999, static_cast<double>(frequency) / sampleRate);
+    const double c0 = std::cos(omega0);
+    const double n = static_cast<double>(order);
+
+    // Prototipo |H(jΩ)|² = (G² + (Ω/β)^2N) / (1 + (Ω/β)^2N), riferimento
+    // unitario e gain G^2 = A^4 al centro. Con il gain di banda GB² = G
+    // (metà gain in dB) ε = √G = A, quindi β = WB / A^(1/N), definito anche
+    // a gain nullo. WB = sin ω0 / 2Q riproduce il biquad RBJ a ordine 1.
+    const double A = std::pow(10.0, static_cast<double>(gainDb) / 40.0);
+    const double bandwidth = std::sin(omega0) / (2.0 * static_cast<double>(q));
+    const double g = std::pow(A, 2.0 / n);
+    double beta = bandwidth / std::pow(A, 1.0 / n);
+
+    // Una radice di raggio r nel prototipo cade a circa (1 ∓ cos ω0) / r da
+    // z = ±1, e ogni biquad ne ha due: |1 ∓ p|² deve restare sopra
+    // l'arrotondamento dei coefficienti in float, oltre al margine di
+    // stabilità. I Bell più larghi vicino a continua o a Nyquist si
+    // restringono quanto basta; l'ordine 1 è il biquad RBJ e non serve.
+    if (order > 1)
+    {
+        const double minimumDistance = 2.0 * std::sqrt(static_cast<double>(stabilityMargin));
+        const double edge = juce::jmin(std::sin(0.5 * omega0), std::cos(0.5 * omega0));
+        const double maxRadius = 2.0 * edge * edge / minimumDistance;
+        beta *= juce::jmin(1.0, maxRadius / (beta * juce::jmax(1.0, g)));
+    }
+
+    // Normalizzazione dove la sezione vale 1, lontano dal centro
+    const double reference = c0 > 0.0 ? -1.0 : 1.0;
+    int section = 0;
+
+    // Sezione del primo ordine (s + gβ) / (s + β): già un biquad
+    if (order % 2 != 0)
+        sections[static_cast<size_t>(section++)] = stabilise(normalise(1.0 + g * beta, -2.0 * c0, 1.0 - g * beta,
+                                                                       1.0 + beta, -2.0 * c0, 1.0 - beta));
+
+    // Coppia i: poli β (-s_i ± j c_i), zeri g volte più lontani; due biquad
+    for (int i = order / 2; i >= 1; --i)
+    {
+        const double phi = static_cast<double>(2 * i - 1) * pi / (2.0 * n);
+        const Complex pole = beta * Complex(-std::sin(phi), std::cos(phi));
+        const Complex zero = g * pole;
+
+        const auto poleUpper = bandpassRoot(pole, c0);
+        const auto zeroUpper = bandpassRoot(zero, c0);
+
+        // L'altra radice di ciascun fattore: prodotto delle radici (1 + r) / (1 - r)
+        const auto poleLower = (1.0 + pole) / ((1.0 - pole) * poleUpper);
+        const auto zeroLower = (1.0 + zero) / ((1.0 - zero) * zeroUpper);
+
+        sections[static_cast<size_t>(section++)] = fromRoots(zeroUpper, poleUpper, reference);
+        sections[static_cast<size_t>(section++)] = fromRoots(zeroLower, poleLower, reference);
+    }
+
+    return section;
+}
+
+int HighOrderDesign::shelf(bool highShelf, int order, double sampleRate, float frequency, float q, float gainDb,
+                           BiquadDesign::SectionArray& sections)
+{
+    const double n = static_cast<double>(order);
+    const double A = std::pow(10.0, static_cast<double>(gainDb) / 40.0);
+    const double beta = 1.0 / std::pow(A, 1.0 / n);
+    const double g = std::pow(A, 2.0 / n);
+    int section = 0;
+
+    // (s + gβ) / (s + β): gain G^(1/N) in continua (low) o, con s -> 1/s, a Nyquist (high)
+    if (order % 2 != 0)
+        sections[static_cast<size_t>(section++)] = highShelf ? bilinearFirstOrder(g * beta, 1.0, beta, 1.0, sampleRate, frequency)
+                                                             : bilinearFirstOrder(1.0, g * beta, 1.0, beta, sampleRate, frequency);
+
+    for (int i = order / 2; i >= 1; --i)
+    {
+        const double phi = static_cast<double>(2 * i - 1) * pi / (2.0 * n);
+        const double damping = 2.0 * std::sin(phi) * (i == 1 ? butterworthQ / static_cast<double>(q) : 1.0);
+        const double zeroSquared = g * g * beta * beta;
+        const double poleSquared = beta * beta;
+
+        sections[static_cast<size_t>(section++)] =
+            highShelf ? bilinear(zeroSquared, damping * g * beta, 1.0, poleSquared, damping * beta, 1.0, sampleRate, frequency)
+                      : bilinear(1.0, damping * g * beta, zeroSquared, 1.0, damping * beta, poleSquared, sampleRate, frequency);
+    }
+
+    return section;
+}
+
+int HighOrderDesign::butterworth(bool highPass, int order, double sampleRate, float frequency, float q,
+                                 BiquadDesign::Method method, BiquadDesign::SectionArray& sections)
+{
+    const bool matched = method == Method::matched;
+    int section = 0;
+
+    if (order % 2 != 0)
+    {
+        if (highPass)
+            sections[static_cast<size_t>(section++)] = (matched ? BiquadDesign::matchedFirstOrderHighPass
+                                                                : BiquadDesign::firstOrderHighPass)(sampleRate, frequency);
+        else
+            sections[static_cast<size_t>(section++)] = (matched ? BiquadDesign::matchedFirstOrderLowPass
+                                                                : BiquadDesign::firstOrderLowPass)(sampleRate, frequency);
+    }
+
+    // Q crescente: k = 1 è la coppia più vicina all'asse immaginario
+    const auto design = highPass ? (matched ? BiquadDesign::matchedHighPass : BiquadDesign::highPass)
+                                 : (matched ? BiquadDesign::matchedLowPass : BiquadDesign::lowPass);
+    const double resonance = static_cast<double>(q) / butterworthQ;
+
+    for (int k = order / 2; k >= 1; --k)
+    {
+        const double poleQ = butterworthPoleQ(order, k) * (k == 1 ? resonance : 1.0);
+        sections[static_cast<size_t>(section++)] = design(sampleRate, frequency, static_cast<float>(poleQ));
+    }
+
+    return section;
+}
+
+int HighOrderDesign::linkwitzRiley(bool highPass, int order, double sampleRate, float frequency, float q,
+                                   BiquadDesign::Method method, BiquadDesign::SectionArray& sections)
+{
+    // LR2: due poli reali coincidenti, cioè un biquad a Q = 0.5
+    if (order <= 2)
+    {
+        const auto design = highPass ? (method == Method::matched ? BiquadDesign::matchedHighPass : BiquadDesign::highPass)
+                                     : (method == Method::matched ? BiquadDesign::matchedLowPass : BiquadDesign::lowPass);
+        sections[0] = design(sampleRate, frequency, static_cast<float>(0.5 * static_cast<double>(q) / butterworthQ));
+        return 1;
+    }
+
+    // Le due metà interleaved, così l'ordine di Q crescente resta
+    BiquadDesign::SectionArray half;
+    const int numHalf = butterworth(highPass, order / 2, sampleRate, frequency, q, method, half);
+
+    for (int i = 0; i < numHalf; ++i)
+    {
+        sections[static_cast<size_t>(2 * i)] = half[static_cast<size_t>(i)];
+        sections[static_cast<size_t>(2 * i + 1)] = half[static_cast<size_t>(i)];
+    }
+
+    return 2 * numHalf;
+}
+
+int HighOrderDesign::elliptic(bool highPass, int order, float stopbandDb, double sampleRate, float frequency,
+                              BiquadDesign::SectionArray& sections)
+{
+    const double epsilonPass = passbandEpsilon();
+    const double k1 = epsilonPass / stopbandEpsilon(static_cast<double>(stopbandDb));
+    const auto selectivity = landen(solveDegreeEquation(order, k1));
+    const double k = selectivity.modulus;
+
+    // Spostamento immaginario dei poli rispetto agli zeri
+    const double v0 = asneImaginary(1.0 / epsilonPass, landen(k1)) / static_cast<double>(order);
+
+    int section = 0;
+
+    // Polo reale per ordine dispari: p0 = j sn(j v0 K, k)
+    if (order % 2 != 0)
+    {
+        const double pole = -(Complex(0.0, 1.0) * sne(Complex(0.0, v0), selectivity)).real();
+
+        sections[static_cast<size_t>(section++)] = highPass ? bilinearFirstOrder(pole, 0.0, pole, 1.0, sampleRate, frequency)
+                                                            : bilinearFirstOrder(0.0, pole, 1.0, pole, sampleRate, frequency);
+    }
+
+    // Coppie di poli e zeri; i = order / 2 è la coppia meno risonante
+    for (int i = order / 2; i >= 1; --i)
+    {
+        const double u = static_cast<double>(2 * i - 1) / static_cast<double>(order);
+        const double zero = 1.0 / (k * cde(Complex(u, 0.0), selectivity).real());
+        const auto pole = Complex(0.0, 1.0) * cde(Complex(u, -v0), selectivity);
+
+        const double zeroSquared = zero * zero;
+        const double poleSquared = std::norm(pole);
+        const double damping = -2.0 * pole.real();
+        const double gain = poleSquared / zeroSquared;
+
+        // Passa-alto per s -> 1/s: stesse sezioni, coefficienti invertiti
+        sections[static_cast<size_t>(section++)] =
+            highPass ? bilinear(gain * zeroSquared, 0.0, gain, poleSquared, damping, 1.0, sampleRate, frequency)
+                     : bilinear(gain, 0.0, gain * zeroSquared, 1.0, damping, poleSquared, sampleRate, frequency);
+    }
+
+    // A ordine pari il prototipo parte da -ripple in continua
+    if (order % 2 == 0 && section > 0)
+    {
+        const auto scale = static_cast<float>(1.0 / std::sqrt(1.0 + epsilonPass * epsilonPass));
+        auto& first = sections[0];
+        first = { first.b0 * scale, first.b1 * scale, first.b2 * scale, first.a1, first.a2 };
+    }
+
+    return section;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "BiquadDesign.h"
+#include <limits>
+
+//==============================================================================
+/**
+ * Progetti di ordine alto scomposti in sezioni biquad (e al più una sezione
+ * del primo ordine), senza allocazioni: si possono chiamare dal thread audio
+ * come le funzioni di BiquadDesign.
+ *
+ * Le sezioni escono in ordine di Q crescente: le più risonanti per ultime,
+ * a vantaggio dell'headroom interno della cascata.
+ */
+namespace HighOrderDesign
+{
+    /** Ordine del passa-basso/passa-alto per slope e risposta. */
+    int getCutOrder(int slope, BiquadDesign::CutResponse response);
+
+    /** Sezioni (biquad più eventuale primo ordine) di un taglio di quell'ordine. */
+    int getCutSections(int slope, BiquadDesign::CutResponse response);
+
+    /**
+     * Butterworth di ordine order: poli sul cerchio, tutte le sezioni alla
+     * frequenza di taglio con Q_k = 1 / (2 cos((2k - 1) π / 2N)). q scala la
+     * sezione più risonante (q = 1/√2 è il Butterworth esatto); a ordine 2
+     * coincide con il biquad singolo. Con Method::matched ogni sezione è
+     * progettata con matchedLowPass/HighPass.
+     */
+    int butterworth(bool highPass, int order, double sampleRate, float frequency, float q,
+                    BiquadDesign::Method method, BiquadDesign::SectionArray& sections);
+
+    /**
+     * Linkwitz-Riley di ordine order (pari): Butterworth di ordine order / 2
+     * al quadrato, -6 dB al taglio e somma piatta tra passa-basso e
+     * passa-alto. LR2 è un biquad a Q = 0.5.
+     */
+    int linkwitzRiley(bool highPass, int order, double sampleRate, float frequency, float q,
+                      BiquadDesign::Method method, BiquadDesign::SectionArray& sections);
+
+    /**
+     * Ellittico (Cauer) di ordine order con ripple in banda passante
+     * ellipticPassbandRippleDb e attenuazione stopbandDb in banda oscura,
+     * bordo della banda passante alla frequenza di taglio. Poli e zeri dalle
+     * funzioni ellittiche di Jacobi (Orfanidis, "Lecture Notes on Elliptic
+     * Filter Design"), poi bilineare precompensata al taglio. Guadagno
+     * unitario in continua (a Nyquist per il passa-alto) per ogni sezione;
+     * a ordine pari la banda passante oscilla tra 0 e -ripple.
+     */
+    int elliptic(bool highPass, int order, float stopbandDb, double sampleRate, float frequency,
+                 BiquadDesign::SectionArray& sections);
+
+    /**
+     * Ordine del prototipo Butterworth dei Bell (una sezione per ordine) e
+     * degli shelf (ordine nominale dello slope, due per sezione).
+     */
+    int getBellOrder(int slope);
+    int getShelfOrder(int slope);
+
+    /**
+     * Bell di ordine order (Orfanidis, "High-Order Digital Parametric
+     * Equalizer Design"): prototipo Butterworth shelving in banda base,
+     * portato al centro con la trasformazione passa-banda bilineare
+     * s = (1 - 2 cos ω0 z^-1 + z^-2) / (1 - z^-2). Il gain al centro è
+     * esatto a ogni ordine e i punti a metà gain (in dB) restano quelli del
+     * biquad RBJ con lo stesso Q, che è il caso order = 1: l'ordine rende
+     * solo più ripidi i fianchi (salvo i Bell più larghi agli estremi,
+     * vedi stabilityMargin). Ogni sezione analogica di secondo ordine
+     * diventa due biquad dalle radici in forma chiusa (nessuna iterazione,
+     * sezioni indipendenti), con guadagno unitario in continua o a Nyquist.
+     */
+    int peak(int order, double sampleRate, float frequency, float q, float gainDb,
+             BiquadDesign::SectionArray& sections);
+
+    /**
+     * Shelf Butterworth di ordine order, metà gain (in dB) alla frequenza:
+     * stesso prototipo del Bell, con la bilineare precompensata (ω0 = 0)
+     * o passa-alto. A ordine 2 coincide con lo shelf RBJ, Q compreso: q
+     * scala lo smorzamento della coppia più risonante. A ordine 1 è lo
+     * shelf del primo ordine e q non conta.
+     */
+    int shelf(bool highShelf, int order, double sampleRate, float frequency, float q, float gainDb,
+              BiquadDesign::SectionArray& sections);
+
+    /**
+     * Margine del triangolo di stabilità dei Bell: i progetti ne restano
+     * dentro (|a2| < 1 - margine, |a1| < (1 + a2)(1 - margine)) anche
+     * vicino a continua e a Nyquist, dove peak restringe i Bell più larghi
+     * perché i poli vicini a z = ±1 restino rappresentabili in float.
+     */
+    constexpr float stabilityMargin = 4.0f * std::numeric_limits<float>::epsilon();
+
+    /** Ripple in banda passante dei tagli ellittici (dB). */
+    constexpr double ellipticPassbandRippleDb = 0.1;
+
+    /**
+     * Ordine ellittico minimo che a un'ottava dal taglio attenua quanto lo
+     * slope nominale (stopbandDb), con il ripple in banda passante sopra.
+     */
+    int getMinimumEllipticOrder(double stopbandDb);
+}
@@ -0,0 +1,193 @@
+#include "KernelDispatch.h"
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <cpuid.h>
+ #endif
+#endif
+
+namespace KernelDispatch
+{
+    namespace
+    {
+        // Bit di XCR0: stato SSE (1) e AVX (2) per i registri YMM; opmask (5),
+        // metà alta di ZMM0-15 (6) e ZMM16-31 (7) per AVX-512
+        constexpr std::uint64_t ymmStateMask = 0x06;
+        constexpr std::uint64_t zmmStateMask = 0xe6;
+
+        /**
+         * Registri estesi che il sistema operativo salva nel cambio di
+         * contesto (XCR0). CPUID dice solo cosa sa fare la CPU: senza il
+         * supporto del sistema le istruzioni AVX sono illegali.
+         * @return 0 se XGETBV non è disponibile (OSXSAVE spento)
+         */
+        std::uint64_t getEnabledRegisterStates()
+        {
+           #if JUCE_INTEL
+            constexpr unsigned int osxsaveBit = 1u << 27; // CPUID.1:ECX
+
+           #if JUCE_MSVC
+            int info[4] {};
+            __cpuid(info, 1);
+            if ((static_cast<unsigned int>(info[2]) & osxsaveBit) == 0)
+                return 0;
+
+            return static_cast<std::uint64_t>(_xgetbv(0));
+           #else
+            unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+            if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0 || (ecx & osxsaveBit) == 0)
+                return 0;
+
+            unsigned int low = 0, high = 0;
+            __asm__ volatile ("xgetbv" : "=a" (low), "=d" (high) : "c" (0));
+            return (static_cast<std::uint64_t>(high) << 32) | low;
+           #endif
+           #else
+            return 0;
+           #endif
+        }
+
+        bool osSavesRegisters(std::uint64_t stateMask)
+        {
+            return (getEnabledRegisterStates() & stateMask) == stateMask;
+        }
+
+        struct Registry
+        {
+            std::array<KernelTable, numIsas> tables;
+            std::array<bool, numIsas> available {};
+
+            Registry()
+            {
+                using Fill = bool (*)(KernelTable&);
+                const std::array<Fill, numIsas> fill { fillScalarKernels, fillSse41Kernels,
+                                                       fillAvx2Kernels, fillAvx512Kernels };
+
+                for (int i = 0; i < numIsas; ++i)
+                {
+                    auto& table = tables[static_cast<size_t>(i)];
+                    table.isa = static_cast<Isa>(i);
+                    available[static_cast<size_t>(i)] = fill[static_cast<size_t>(i)](table)
+                                                     && cpuSupports(table.isa);
+                }
+
+                jassert(available[0]);
+            }
+
+            static bool cpuSupports(Isa isa)
+            {
+                switch (isa)
+                {
+                    case Isa::scalar: return true;
+                    case Isa::sse41:  return juce::SystemStats::hasSSE41();
+                    case Isa::avx2:   return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3()
+                                          && osSavesRegisters(ymmStateMask);
+                    case Isa::avx512: return juce::SystemStats::hasAVX512F() && juce::SystemStats::hasAVX2()
+                                          && juce::SystemStats::hasFMA3() && osSavesRegisters(zmmStateMask);
+                }
+
+                return false;
+            }
+        };
+
+        Registry& getRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        constexpr int noForcedIsa = -1;
+
+        std::atomic<int> forcedIsa { noForcedIsa };
+        std::atomic<const KernelTable*> activeTable { nullptr };
+
+        int getForcedIsaFromEnvironment()
+        {
+            const auto name = juce::SystemStats::getEnvironmentVariable("ANALOGEQ_FORCE_ISA", {}).trim().toLowerCase();
+
+            for (int i = 0; i < numIsas; ++i)
+                if (name == getIsaName(static_cast<Isa>(i)))
+                    return i;
+
+            return noForcedIsa;
+        }
+
+        /** La ISA richiesta se supportata, altrimenti la migliore al di sotto. */
+        Isa getBestSupportedUpTo(Isa requested)
+        {
+            for (int i = static_cast<int>(requested); i > 0; --i)
+                if (isSupported(static_cast<Isa>(i)))
+                    return static_cast<Isa>(i);
+
+            return Isa::scalar;
+        }
+    }
+
+    bool isSupported(Isa isa)
+    {
+        const auto index = static_cast<int>(isa);
+        return juce::isPositiveAndBelow(index, numIsas) && getRegistry().available[static_cast<size_t>(index)];
+    }
+
+    Isa detectIsa()
+    {
+        return getBestSupportedUpTo(Isa::avx512);
+    }
+
+    void setForcedIsa(Isa isa)
+    {
+        forcedIsa.store(static_cast<int>(isa));
+    }
+
+    void clearForcedIsa()
+    {
+        forcedIsa.store(noForcedIsa);
+    }
+
+    Isa selectKernels()
+    {
+        static const int environmentIsa = getForcedIsaFromEnvironment();
+
+        int requested = forcedIsa.load();
+        if (requested == noForcedIsa)
+            requested = environmentIsa;
+
+        const auto isa = requested == noForcedIsa ? detectIsa()
+                                                  : getBestSupportedUpTo(static_cast<Isa>(requested));
+
+        activeTable.store(&getRegistry().tables[static_cast<size_t>(isa)]);
+        return isa;
+    }
+
+    const KernelTable& getKernels()
+    {
+        if (const auto* table = activeTable.load())
+            return *table;
+
+        return getRegistry().tables[static_cast<size_t>(detectIsa())];
+    }
+
+    const KernelTable* getKernels(Isa isa)
+    {
+        return isSupported(isa) ? &getRegistry().tables[static_cast<size_t>(isa)] : nullptr;
+    }
+
+    const char* getIsaName(Isa isa)
+    {
+        switch (isa)
+        {
+            case Isa::scalar: return "scalar";
+            case Isa::sse41:  return "sse41";
+            case Isa::avx2:   return "avx2";
+            case Isa::avx512: return "avx512";
+        }
+
+        return "unknown";
+    }
+}
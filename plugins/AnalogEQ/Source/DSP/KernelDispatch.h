@@ -0,0 +1,134 @@
+#pragma once
+
+#include "BiquadKernels.h"
+
+//==============================================================================
+/**
+ * Selezione a runtime dei kernel DSP per il set di istruzioni della CPU.
+ *
+ * Il plugin viene compilato una volta sola con i flag base; le versioni
+ * SSE4.1, AVX2 (+FMA) e AVX-512 dei kernel vivono in TU separate
+ * (Kernels*.cpp) compilate con i rispettivi flag, e prepareToPlay sceglie la
+ * tabella migliore supportata dalla CPU (CPUID, tramite juce::SystemStats)
+ * e abilitata dal sistema operativo (XCR0: stato YMM per AVX2, anche
+ * opmask e ZMM per AVX-512).
+ *
+ * Confronto tra i percorsi: la cascata di biquad usa la stessa aritmetica
+ * (senza FMA) in ogni ISA ed è identica bit per bit (la tabella scalar
+ * disattiva anche BlockStateSpace, quindi sui blocchi dove quel motore
+ * subentra vale la sua tolleranza); prodotto scalare e
+ * somma dei quadrati cambiano l'ordine delle somme (e usano FMA da AVX2),
+ * quindi coincidono entro l'arrotondamento (errore relativo ~1e-6).
+ * Saturazione, conversioni in dB ed exp2/log2/sin/cos usano le
+ * approssimazioni di FastMath, identiche bit per bit in ogni ISA; il loro
+ * errore rispetto a libm è verificato per ogni ISA da Tests/MathAccuracyTests.
+ *
+ * Modalità di test: setForcedIsa (o la variabile d'ambiente
+ * ANALOGEQ_FORCE_ISA = scalar | sse41 | avx2 | avx512) forza una ISA alla
+ * successiva selectKernels; getKernels(Isa) dà accesso diretto a ogni
+ * tabella per confrontarle sugli stessi dati (Tests/KernelDispatchTests).
+ */
+namespace KernelDispatch
+{
+    /** Soglia della saturazione analogica (AnalogSaturation). */
+    constexpr float saturationThreshold = 0.8f;
+
+    /** Magnitudine minima convertita da magnitudesToDecibels (-140 dB). */
+    constexpr float minDecibelMagnitude = 1.0e-7f;
+
+    enum class Isa
+    {
+        scalar = 0,
+        sse41,
+        avx2,
+        avx512
+    };
+
+    constexpr int numIsas = 4;
+
+    struct KernelTable
+    {
+        Isa isa = Isa::scalar;
+
+        /** Tutte le sezioni di una banda, come BiquadKernels::processStereo / processMono / processStereoFrames. */
+        void (*biquadStereo)(const BiquadKernels::SectionRange& range, float* left, float* right, int numSamples) = nullptr;
+        void (*biquadMono)(const BiquadKernels::SectionRange& range, int channel, float* data, int numSamples) = nullptr;
+        void (*biquadStereoFrames)(const BiquadKernels::SectionRange& range, float* frames, int count) = nullptr;
+
+        /** Somma di a[i] * b[i] (FIR a fase lineare). */
+        float (*dotProduct)(const float* a, const float* b, int numValues) = nullptr;
+
+        /** Somma dei quadrati (RMS). */
+        float (*sumOfSquares)(const float* data, int numValues) = nullptr;
+
+        /** Saturazione analogica in-place: tanh(x / saturationThreshold) * saturationThreshold. */
+        void (*saturate)(float* data, int numValues) = nullptr;
+
+        /**
+         * La stessa saturazione con antialiasing del primo o del secondo ordine
+         * (FastMath::softClipAdaa1 / softClipAdaa2), in-place.
+         * @param stride Distanza tra campioni di un canale (2 per frame stereo interleaved)
+         * @param history Gli ultimi 2 * stride ingressi, aggiornati (AnalogSaturation::State)
+         */
+        void (*saturateAdaa1)(float* data, int numValues, int stride, float* history) = nullptr;
+        void (*saturateAdaa2)(float* data, int numValues, int stride, float* history) = nullptr;
+
+        /** 20 log10 delle magnitudini, limitato a [minDb, maxDb] (analizzatore di spettro). */
+        void (*magnitudesToDecibels)(const float* magnitudes, float* decibels, int numValues,
+                                     float minDb, float maxDb) = nullptr;
+
+        /** Guadagni lineari da dB. */
+        void (*decibelsToGains)(const float* decibels, float* gains, int numValues) = nullptr;
+
+        /** 2^x e log2(x) (x > 0) per valore. */
+        void (*exp2)(const float* input, float* output, int numValues) = nullptr;
+        void (*log2)(const float* input, float* output, int numValues) = nullptr;
+
+        /** sin(x) e cos(x) per valore, |x| < 8192 pi. */
+        void (*sinCos)(const float* input, float* sines, float* cosines, int numValues) = nullptr;
+    };
+
+    /**
+     * Indica se la ISA è compilata nel binario e supportata dalla CPU.
+     */
+    bool isSupported(Isa isa);
+
+    /**
+     * La ISA migliore supportata (ignora la ISA forzata).
+     */
+    Isa detectIsa();
+
+    /**
+     * Forza una ISA (modalità di test). Se non è supportata viene usata la
+     * migliore supportata al di sotto. Ha effetto alla prossima selectKernels.
+     */
+    void setForcedIsa(Isa isa);
+    void clearForcedIsa();
+
+    /**
+     * Sceglie la tabella attiva: la ISA forzata se presente, altrimenti la
+     * migliore per la CPU. Da chiamare in prepareToPlay.
+     * @return La ISA selezionata
+     */
+    Isa selectKernels();
+
+    /**
+     * La tabella attiva (quella della CPU se selectKernels non è ancora
+     * stata chiamata).
+     */
+    const KernelTable& getKernels();
+
+    /**
+     * La tabella di una ISA specifica, o nullptr se non è supportata.
+     */
+    const KernelTable* getKernels(Isa isa);
+
+    const char* getIsaName(Isa isa);
+
+    // Implementate da ogni Kernels*.cpp: riempiono gli slot specifici della
+    // loro ISA e restituiscono false se la TU è stata compilata senza di essa.
+    bool fillScalarKernels(KernelTable& table);
+    bool fillSse41Kernels(KernelTable& table);
+    bool fillAvx2Kernels(KernelTable& table);
+    bool fillAvx512Kernels(KernelTable& table);
+}
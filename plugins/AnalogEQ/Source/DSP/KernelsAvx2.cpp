@@ -0,0 +1,127 @@
+// Kernel AVX2 + FMA (compilata con -mavx2 -mfma -ffp-contract=off, vedi
+// CMakeLists.txt: la contrazione resta disattivata perché la cascata di
+// biquad deve restare identica bit per bit alle altre ISA; le FMA del
+// prodotto scalare sono esplicite).
+#define ANALOGEQ_KERNEL_TARGET avx2
+#include "KernelDispatch.h"
+#include "BiquadKernelsWide.h"
+#include "FastMath.h"
+
+#if ANALOGEQ_BIQUAD_AVX2 && (defined(__FMA__) || defined(_MSC_VER))
+namespace
+{
+    using BiquadKernels::SectionRange;
+    using StereoLanes = BiquadKernels::WideLanes::Avx2;
+
+    void biquadStereo(const SectionRange& range, float* left, float* right, int numSamples)
+    {
+        BiquadKernels::dispatchSectionCount(range.numSections, [&](auto sections)
+        {
+            BiquadKernels::processStereoWide<StereoLanes, decltype(sections)::value>(range, left, right, numSamples);
+        });
+    }
+
+    void biquadMono(const SectionRange& range, int channel, float* data, int numSamples)
+    {
+        BiquadKernels::dispatchSectionCount(range.numSections, [&](auto sections)
+        {
+            BiquadKernels::processMonoWide<decltype(sections)::value>(range, channel, data, numSamples);
+        });
+    }
+
+    void biquadStereoFrames(const SectionRange& range, float* frames, int count)
+    {
+        BiquadKernels::dispatchSectionCount(range.numSections, [&](auto sections)
+        {
+            BiquadKernels::processStereoFramesWide<StereoLanes, decltype(sections)::value>(range, frames, count);
+        });
+    }
+
+    float horizontalSum(__m256 v)
+    {
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+        return _mm_cvtss_f32(sum);
+    }
+
+    float dotProduct(const float* a, const float* b, int numValues)
+    {
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+        int i = 0;
+
+        for (; i + 32 <= numValues; i += 32)
+        {
+            acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+            acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), acc2);
+            acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), acc3);
+        }
+
+        for (; i + 8 <= numValues; i += 8)
+            acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+
+        float sum = horizontalSum(_mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3)));
+
+        for (; i < numValues; ++i)
+            sum += a[i] * b[i];
+
+        return sum;
+    }
+
+    float sumOfSquares(const float* data, int numValues)
+    {
+        return dotProduct(data, data, numValues);
+    }
+
+    using MathLanes = FastMath::Lanes::Avx2;
+
+    void saturate(float* data, int numValues)
+    {
+        FastMath::softClip<MathLanes>(data, numValues, 1.0f / KernelDispatch::saturationThreshold,
+                                      KernelDispatch::saturationThreshold);
+    }
+
+    void saturateAdaa1(float* data, int numValues, int stride, float* history)
+    {
+        FastMath::softClipAdaa1<MathLanes>(data, numValues, stride, history, 1.0f / KernelDispatch::saturationThreshold,
+                                           KernelDispatch::saturationThreshold);
+    }
+
+    void saturateAdaa2(float* data, int numValues, int stride, float* history)
+    {
+        FastMath::softClipAdaa2<MathLanes>(data, numValues, stride, history, 1.0f / KernelDispatch::saturationThreshold,
+                                           KernelDispatch::saturationThreshold);
+    }
+
+    void magnitudesToDecibels(const float* magnitudes, float* decibels, int numValues, float minDb, float maxDb)
+    {
+        FastMath::magnitudesToDecibels<MathLanes>(magnitudes, decibels, numValues,
+                                                  KernelDispatch::minDecibelMagnitude, minDb, maxDb);
+    }
+}
+
+bool KernelDispatch::fillAvx2Kernels(KernelTable& table)
+{
+    table.biquadStereo = biquadStereo;
+    table.biquadMono = biquadMono;
+    table.biquadStereoFrames = biquadStereoFrames;
+    table.dotProduct = dotProduct;
+    table.sumOfSquares = sumOfSquares;
+    table.saturate = saturate;
+    table.saturateAdaa1 = saturateAdaa1;
+    table.saturateAdaa2 = saturateAdaa2;
+    table.magnitudesToDecibels = magnitudesToDecibels;
+    table.decibelsToGains = FastMath::decibelsToGains<MathLanes>;
+    table.exp2 = FastMath::exp2<MathLanes>;
+    table.log2 = FastMath::log2<MathLanes>;
+    table.sinCos = FastMath::sinCos<MathLanes>;
+    return true;
+}
+#else
+bool KernelDispatch::fillAvx2Kernels(KernelTable&)
+{
+    return false;
+}
+#endif
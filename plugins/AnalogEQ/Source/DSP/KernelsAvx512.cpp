@@ -0,0 +1,130 @@
+// Kernel AVX-512F (compilata con -mavx512f -mavx2 -mfma -ffp-contract=off,
+// vedi CMakeLists.txt). La cascata stereo avanza entrambi i canali di una
+// banda da 8 sezioni in un solo registro; il mono usa i registri a 256 bit.
+#define ANALOGEQ_KERNEL_TARGET avx512
+#include "KernelDispatch.h"
+#include "BiquadKernelsWide.h"
+#include "FastMath.h"
+
+#if ANALOGEQ_BIQUAD_AVX512 && (defined(__FMA__) || defined(_MSC_VER))
+namespace
+{
+    using BiquadKernels::SectionRange;
+    using StereoLanes = BiquadKernels::WideLanes::Avx512Stereo;
+
+    void biquadStereo(const SectionRange& range, float* left, float* right, int numSamples)
+    {
+        BiquadKernels::dispatchSectionCount(range.numSections, [&](auto sections)
+        {
+            BiquadKernels::processStereoWide<StereoLanes, decltype(sections)::value>(range, left, right, numSamples);
+        });
+    }
+
+    void biquadMono(const SectionRange& range, int channel, float* data, int numSamples)
+    {
+        BiquadKernels::dispatchSectionCount(range.numSections, [&](auto sections)
+        {
+            BiquadKernels::processMonoWide<decltype(sections)::value>(range, channel, data, numSamples);
+        });
+    }
+
+    void biquadStereoFrames(const SectionRange& range, float* frames, int count)
+    {
+        BiquadKernels::dispatchSectionCount(range.numSections, [&](auto sections)
+        {
+            BiquadKernels::processStereoFramesWide<StereoLanes, decltype(sections)::value>(range, frames, count);
+        });
+    }
+
+    float horizontalSum(__m512 v)
+    {
+        v = _mm512_add_ps(v, _mm512_maskz_shuffle_f32x4(0xffff, v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+        v = _mm512_add_ps(v, _mm512_maskz_shuffle_f32x4(0xffff, v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        __m128 sum = _mm512_maskz_extractf32x4_ps(0x0f, v, 0);
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+        return _mm_cvtss_f32(sum);
+    }
+
+    // La coda usa un load mascherato invece del ciclo scalare
+    float dotProduct(const float* a, const float* b, int numValues)
+    {
+        __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+        __m512 acc2 = _mm512_setzero_ps(), acc3 = _mm512_setzero_ps();
+        int i = 0;
+
+        for (; i + 64 <= numValues; i += 64)
+        {
+            acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+            acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), acc1);
+            acc2 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 32), _mm512_loadu_ps(b + i + 32), acc2);
+            acc3 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 48), _mm512_loadu_ps(b + i + 48), acc3);
+        }
+
+        for (; i + 16 <= numValues; i += 16)
+            acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+
+        if (i < numValues)
+        {
+            const auto tail = static_cast<__mmask16>((1u << (numValues - i)) - 1u);
+            acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, a + i), _mm512_maskz_loadu_ps(tail, b + i), acc1);
+        }
+
+        return horizontalSum(_mm512_add_ps(_mm512_add_ps(acc0, acc1), _mm512_add_ps(acc2, acc3)));
+    }
+
+    float sumOfSquares(const float* data, int numValues)
+    {
+        return dotProduct(data, data, numValues);
+    }
+
+    using MathLanes = FastMath::Lanes::Avx512;
+
+    void saturate(float* data, int numValues)
+    {
+        FastMath::softClip<MathLanes>(data, numValues, 1.0f / KernelDispatch::saturationThreshold,
+                                      KernelDispatch::saturationThreshold);
+    }
+
+    void saturateAdaa1(float* data, int numValues, int stride, float* history)
+    {
+        FastMath::softClipAdaa1<MathLanes>(data, numValues, stride, history, 1.0f / KernelDispatch::saturationThreshold,
+                                           KernelDispatch::saturationThreshold);
+    }
+
+    void saturateAdaa2(float* data, int numValues, int stride, float* history)
+    {
+        FastMath::softClipAdaa2<MathLanes>(data, numValues, stride, history, 1.0f / KernelDispatch::saturationThreshold,
+                                           KernelDispatch::saturationThreshold);
+    }
+
+    void magnitudesToDecibels(const float* magnitudes, float* decibels, int numValues, float minDb, float maxDb)
+    {
+        FastMath::magnitudesToDecibels<MathLanes>(magnitudes, decibels, numValues,
+                                                  KernelDispatch::minDecibelMagnitude, minDb, maxDb);
+    }
+}
+
+bool KernelDispatch::fillAvx512Kernels(KernelTable& table)
+{
+    table.biquadStereo = biquadStereo;
+    table.biquadMono = biquadMono;
+    table.biquadStereoFrames = biquadStereoFrames;
+    table.dotProduct = dotProduct;
+    table.sumOfSquares = sumOfSquares;
+    table.saturate = saturate;
+    table.saturateAdaa1 = saturateAdaa1;
+    table.saturateAdaa2 = saturateAdaa2;
+    table.magnitudesToDecibels = magnitudesToDecibels;
+    table.decibelsToGains = FastMath::decibelsToGains<MathLanes>;
+    table.exp2 = FastMath::exp2<MathLanes>;
+    table.log2 = FastMath::log2<MathLanes>;
+    table.sinCos = FastMath::sinCos<MathLanes>;
+    return true;
+}
+#else
+bool KernelDispatch::fillAvx512Kernels(KernelTable&)
+{
+    return false;
+}
+#endif
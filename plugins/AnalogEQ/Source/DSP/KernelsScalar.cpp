@@ -0,0 +1,98 @@
+// Kernel senza SIMD: riferimento per il confronto tra le ISA e ultima
+// risorsa sulle CPU senza SSE4.1.
+// Come tutte le Kernels*.cpp include solo header senza funzioni inline
+// esterne ai namespace di target (niente JUCE né <cmath>), così nessuna
+// funzione compilata con flag diversi può finire nel codice base al link.
+#define ANALOGEQ_KERNEL_TARGET scalar
+#define ANALOGEQ_KERNEL_FORCE_SCALAR 1
+#include "KernelDispatch.h"
+#include "FastMath.h"
+
+namespace
+{
+    using BiquadKernels::SectionRange;
+
+    void biquadStereo(const SectionRange& range, float* left, float* right, int numSamples)
+    {
+        BiquadKernels::dispatchSectionCount(range.numSections, [&](auto sections)
+        {
+            BiquadKernels::processStereo<decltype(sections)::value>(range, left, right, numSamples);
+        });
+    }
+
+    void biquadMono(const SectionRange& range, int channel, float* data, int numSamples)
+    {
+        BiquadKernels::dispatchSectionCount(range.numSections, [&](auto sections)
+        {
+            BiquadKernels::processMono<decltype(sections)::value>(range, channel, data, numSamples);
+        });
+    }
+
+    void biquadStereoFrames(const SectionRange& range, float* frames, int count)
+    {
+        BiquadKernels::dispatchSectionCount(range.numSections, [&](auto sections)
+        {
+            BiquadKernels::processStereoFrames<decltype(sections)::value>(range, frames, count);
+        });
+    }
+
+    float dotProduct(const float* a, const float* b, int numValues)
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < numValues; ++i)
+            sum += a[i] * b[i];
+        return sum;
+    }
+
+    float sumOfSquares(const float* data, int numValues)
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < numValues; ++i)
+            sum += data[i] * data[i];
+        return sum;
+    }
+
+    using MathLanes = FastMath::Lanes::Scalar;
+
+    void saturate(float* data, int numValues)
+    {
+        FastMath::softClip<MathLanes>(data, numValues, 1.0f / KernelDispatch::saturationThreshold,
+                                      KernelDispatch::saturationThreshold);
+    }
+
+    void saturateAdaa1(float* data, int numValues, int stride, float* history)
+    {
+        FastMath::softClipAdaa1<MathLanes>(data, numValues, stride, history, 1.0f / KernelDispatch::saturationThreshold,
+                                           KernelDispatch::saturationThreshold);
+    }
+
+    void saturateAdaa2(float* data, int numValues, int stride, float* history)
+    {
+        FastMath::softClipAdaa2<MathLanes>(data, numValues, stride, history, 1.0f / KernelDispatch::saturationThreshold,
+                                           KernelDispatch::saturationThreshold);
+    }
+
+    void magnitudesToDecibels(const float* magnitudes, float* decibels, int numValues, float minDb, float maxDb)
+    {
+        FastMath::magnitudesToDecibels<MathLanes>(magnitudes, decibels, numValues,
+                                                  KernelDispatch::minDecibelMagnitude, minDb, maxDb);
+    }
+}
+
+bool KernelDispatch::fillScalarKernels(KernelTable& table)
+{
+    table.biquadStereo = biquadStereo;
+    table.biquadMono = biquadMono;
+    table.biquadStereoFrames = biquadStereoFrames;
+    table.dotProduct = dotProduct;
+    table.sumOfSquares = sumOfSquares;
+    table.saturate = saturate;
+    table.saturateAdaa1 = saturateAdaa1;
+    table.saturateAdaa2 = saturateAdaa2;
+    table.magnitudesToDecibels = magnitudesToDecibels;
+    table.decibelsToGains = FastMath::decibelsToGains<MathLanes>;
+    table.exp2 = FastMath::exp2<MathLanes>;
+    table.log2 = FastMath::log2<MathLanes>;
+    table.sinCos = FastMath::sinCos<MathLanes>;
+    return true;
+}
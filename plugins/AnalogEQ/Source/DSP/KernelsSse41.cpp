@@ -0,0 +1,121 @@
+// Kernel SSE4.1 (compilata con -msse4.1, vedi CMakeLists.txt).
+#define ANALOGEQ_KERNEL_TARGET sse41
+#include "KernelDispatch.h"
+#include "FastMath.h"
+
+#if ANALOGEQ_BIQUAD_SSE2 && (defined(__SSE4_1__) || defined(_MSC_VER))
+namespace
+{
+    using BiquadKernels::SectionRange;
+
+    void biquadStereo(const SectionRange& range, float* left, float* right, int numSamples)
+    {
+        BiquadKernels::dispatchSectionCount(range.numSections, [&](auto sections)
+        {
+            BiquadKernels::processStereo<decltype(sections)::value>(range, left, right, numSamples);
+        });
+    }
+
+    void biquadMono(const SectionRange& range, int channel, float* data, int numSamples)
+    {
+        BiquadKernels::dispatchSectionCount(range.numSections, [&](auto sections)
+        {
+            BiquadKernels::processMono<decltype(sections)::value>(range, channel, data, numSamples);
+        });
+    }
+
+    void biquadStereoFrames(const SectionRange& range, float* frames, int count)
+    {
+        BiquadKernels::dispatchSectionCount(range.numSections, [&](auto sections)
+        {
+            BiquadKernels::processStereoFrames<decltype(sections)::value>(range, frames, count);
+        });
+    }
+
+    float horizontalSum(__m128 v)
+    {
+        v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        v = _mm_add_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+        return _mm_cvtss_f32(v);
+    }
+
+    // Quattro accumulatori indipendenti: la latenza della somma non limita il ciclo
+    float dotProduct(const float* a, const float* b, int numValues)
+    {
+        __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps(), acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+        int i = 0;
+
+        for (; i + 16 <= numValues; i += 16)
+        {
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+            acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(a + i + 8), _mm_loadu_ps(b + i + 8)));
+            acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(a + i + 12), _mm_loadu_ps(b + i + 12)));
+        }
+
+        for (; i + 4 <= numValues; i += 4)
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+
+        float sum = horizontalSum(_mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3)));
+
+        for (; i < numValues; ++i)
+            sum += a[i] * b[i];
+
+        return sum;
+    }
+
+    float sumOfSquares(const float* data, int numValues)
+    {
+        return dotProduct(data, data, numValues);
+    }
+
+    using MathLanes = FastMath::Lanes::Sse2;
+
+    void saturate(float* data, int numValues)
+    {
+        FastMath::softClip<MathLanes>(data, numValues, 1.0f / KernelDispatch::saturationThreshold,
+                                      KernelDispatch::saturationThreshold);
+    }
+
+    void saturateAdaa1(float* data, int numValues, int stride, float* history)
+    {
+        FastMath::softClipAdaa1<MathLanes>(data, numValues, stride, history, 1.0f / KernelDispatch::saturationThreshold,
+                                           KernelDispatch::saturationThreshold);
+    }
+
+    void saturateAdaa2(float* data, int numValues, int stride, float* history)
+    {
+        FastMath::softClipAdaa2<MathLanes>(data, numValues, stride, history, 1.0f / KernelDispatch::saturationThreshold,
+                                           KernelDispatch::saturationThreshold);
+    }
+
+    void magnitudesToDecibels(const float* magnitudes, float* decibels, int numValues, float minDb, float maxDb)
+    {
+        FastMath::magnitudesToDecibels<MathLanes>(magnitudes, decibels, numValues,
+                                                  KernelDispatch::minDecibelMagnitude, minDb, maxDb);
+    }
+}
+
+bool KernelDispatch::fillSse41Kernels(KernelTable& table)
+{
+    table.biquadStereo = biquadStereo;
+    table.biquadMono = biquadMono;
+    table.biquadStereoFrames = biquadStereoFrames;
+    table.dotProduct = dotProduct;
+    table.sumOfSquares = sumOfSquares;
+    table.saturate = saturate;
+    table.saturateAdaa1 = saturateAdaa1;
+    table.saturateAdaa2 = saturateAdaa2;
+    table.magnitudesToDecibels = magnitudesToDecibels;
+    table.decibelsToGains = FastMath::decibelsToGains<MathLanes>;
+    table.exp2 = FastMath::exp2<MathLanes>;
+    table.log2 = FastMath::log2<MathLanes>;
+    table.sinCos = FastMath::sinCos<MathLanes>;
+    return true;
+}
+#else
+bool KernelDispatch::fillSse41Kernels(KernelTable&)
+{
+    return false;
+}
+#endif
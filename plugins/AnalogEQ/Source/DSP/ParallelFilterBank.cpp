@@ -0,0 +1,382 @@
+#include "ParallelFilterBank.h"
+#include "BiquadKernels.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <complex>
+
+namespace
+{
+    using Complex = std::complex<double>;
+
+    /**
+     * Sezione della cascata con i poli espliciti.
+     * I poli troppo vicini all'origine vengono considerati nulli: il loro
+     * contributo finisce nella parte FIR invece di produrre residui enormi
+     * che si cancellano a vicenda.
+     */
+    struct PoleSection
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0;
+        double a1 = 0.0, a2 = 0.0;
+        Complex p, q;
+        int numPoles = 0;
+
+        Complex evaluate(Complex w) const
+        {
+            return (b0 + w * (b1 + w * b2)) / (1.0 + w * (a1 + w * a2));
+        }
+
+        int getExcessDegree() const
+        {
+            const int numeratorDegree = b2 != 0.0 ? 2 : (b1 != 0.0 ? 1 : 0);
+            return juce::jmax(0, numeratorDegree - numPoles);
+        }
+    };
+
+    constexpr double minPoleMagnitude = 1.0e-3;
+    constexpr double minPoleDistance = 1.0e-7;
+
+    PoleSection makePoleSection(const BiquadCoefficients& c)
+    {
+        PoleSection section;
+        section.b0 = static_cast<double>(c.b0);
+        section.b1 = static_cast<double>(c.b1);
+        section.b2 = static_cast<double>(c.b2);
+
+        // Radici di z^2 + a1 z + a2
+        const auto ca1 = static_cast<double>(c.a1);
+        const auto ca2 = static_cast<double>(c.a2);
+        const auto disc = std::sqrt(Complex(ca1 * ca1 - 4.0 * ca2));
+        std::array<Complex, 2> roots { 0.5 * (-ca1 + disc), 0.5 * (-ca1 - disc) };
+
+        for (const auto& root : roots)
+        {
+            if (std::abs(root) < minPoleMagnitude)
+                continue;
+
+            (section.numPoles == 0 ? section.p : section.q) = root;
+            ++section.numPoles;
+        }
+
+        // Coppie complesse coniugate hanno lo stesso modulo: restano insieme
+        if (section.numPoles == 1 && section.p.imag() != 0.0)
+            section.numPoles = 0;
+
+        if (section.numPoles == 2)
+        {
+            section.a1 = ca1;
+            section.a2 = ca2;
+        }
+        else if (section.numPoles == 1)
+        {
+            section.p = section.p.real();
+            section.a1 = -section.p.real();
+        }
+
+        return section;
+    }
+}
+
+ParallelFilterBank::ParallelFilterBank()
+{
+    reset();
+}
+
+void ParallelFilterBank::reset()
+{
+    for (auto& channel : w1)
+        channel.fill(0.0f);
+    for (auto& channel : w2)
+        channel.fill(0.0f);
+    for (auto& channel : firHistory)
+        channel.fill(0.0f);
+}
+
+bool ParallelFilterBank::design(const BiquadCoefficients* sections, int numSections, Coefficients& result)
+{
+    std::array<PoleSection, maxSections> cascadeSections;
+    numSections = juce::jlimit(0, maxSections, numSections);
+    int firOrder = 0;
+
+    auto& beta0 = result.beta0;
+    auto& beta1 = result.beta1;
+    auto& a1 = result.a1;
+    auto& a2 = result.a2;
+    result.valid = false;
+
+    for (int k = 0; k < numSections; ++k)
+    {
+        auto& section = cascadeSections[static_cast<size_t>(k)];
+        section = makePoleSection(sections[k]);
+        firOrder += section.getExcessDegree();
+    }
+
+    if (firOrder >= maxFirTaps)
+        return false;
+
+    // I fratti semplici richiedono poli distinti
+    auto isRepeated = [](Complex x, Complex y) { return std::abs(x - y) < minPoleDistance; };
+
+    for (int k = 0; k < numSections; ++k)
+    {
+        const auto& sk = cascadeSections[static_cast<size_t>(k)];
+        if (sk.numPoles == 2 && isRepeated(sk.p, sk.q))
+            return false;
+
+        for (int j = k + 1; j < numSections; ++j)
+        {
+            const auto& sj = cascadeSections[static_cast<size_t>(j)];
+            for (int pk = 0; pk < sk.numPoles; ++pk)
+                for (int pj = 0; pj < sj.numPoles; ++pj)
+                    if (isRepeated(pk == 0 ? sk.p : sk.q, pj == 0 ? sj.p : sj.q))
+                        return false;
+        }
+    }
+
+    // Residuo del polo "pole" della sezione k: (1 - pole w) H(w) valutato in w = 1 / pole
+    auto residue = [&](int k, Complex pole)
+    {
+        const auto w = 1.0 / pole;
+        const auto& sk = cascadeSections[static_cast<size_t>(k)];
+        auto r = sk.b0 + w * (sk.b1 + w * sk.b2);
+
+        if (sk.numPoles == 2)
+            r /= (1.0 - (pole == sk.p ? sk.q : sk.p) * w);
+
+        for (int j = 0; j < numSections; ++j)
+            if (j != k)
+                r *= cascadeSections[static_cast<size_t>(j)].evaluate(w);
+
+        return r;
+    };
+
+    // Risposta all'impulso dei primi firOrder + 1 campioni, da cui si ricava la
+    // parte FIR sottraendo il contributo delle sezioni parallele
+    std::array<double, maxFirTaps> impulse {};
+    impulse[0] = 1.0;
+
+    for (int k = 0; k < numSections; ++k)
+    {
+        const auto& sk = cascadeSections[static_cast<size_t>(k)];
+        double z1 = 0.0, z2 = 0.0;
+
+        for (int n = 0; n <= firOrder; ++n)
+        {
+            const auto input = impulse[static_cast<size_t>(n)];
+            const auto output = sk.b0 * input + z1;
+            z1 = sk.b1 * input - sk.a1 * output + z2;
+            z2 = sk.b2 * input - sk.a2 * output;
+            impulse[static_cast<size_t>(n)] = output;
+        }
+    }
+
+    int numParallel = 0;
+
+    for (int k = 0; k < numSections; ++k)
+    {
+        const auto& sk = cascadeSections[static_cast<size_t>(k)];
+        if (sk.numPoles == 0)
+            continue;
+
+        const auto idx = static_cast<size_t>(numParallel++);
+
+        if (sk.numPoles == 2)
+        {
+            const auto rp = residue(k, sk.p);
+            const auto rq = residue(k, sk.q);
+            beta0[idx] = static_cast<float>((rp + rq).real());
+            beta1[idx] = static_cast<float>(-(rp * sk.q + rq * sk.p).real());
+
+            auto pn = Complex(1.0), qn = Complex(1.0);
+            for (int n = 0; n <= firOrder; ++n, pn *= sk.p, qn *= sk.q)
+                impulse[static_cast<size_t>(n)] -= (rp * pn + rq * qn).real();
+        }
+        else
+        {
+            const auto rp = residue(k, sk.p);
+            beta0[idx] = static_cast<float>(rp.real());
+            beta1[idx] = 0.0f;
+
+            auto pn = 1.0;
+            for (int n = 0; n <= firOrder; ++n, pn *= sk.p.real())
+                impulse[static_cast<size_t>(n)] -= rp.real() * pn;
+        }
+
+        a1[idx] = static_cast<float>(sk.a1);
+        a2[idx] = static_cast<float>(sk.a2);
+    }
+
+    for (int k = numParallel; k < paddedSections; ++k)
+    {
+        const auto idx = static_cast<size_t>(k);
+        beta0[idx] = beta1[idx] = a1[idx] = a2[idx] = 0.0f;
+    }
+
+    for (int n = 0; n < maxFirTaps; ++n)
+        result.firTaps[static_cast<size_t>(n)] = n <= firOrder ? static_cast<float>(impulse[static_cast<size_t>(n)]) : 0.0f;
+
+    result.numSections = numParallel;
+    result.numFirTaps = firOrder + 1;
+    result.valid = true;
+    return true;
+}
+
+float ParallelFilterBank::measureErrorDb(const Coefficients& coefficients, const BiquadCoefficients* sections,
+                                         int numSections, double sampleRate, int numPoints, float floorDb)
+{
+    constexpr double minFrequency = 20.0;
+    const double maxFrequency = juce::jmin(20000.0, sampleRate * 0.49);
+    numPoints = juce::jmax(2, numPoints);
+
+    float maxError = 0.0f;
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const double proportion = static_cast<double>(i) / static_cast<double>(numPoints - 1);
+        const double frequency = minFrequency * std::pow(maxFrequency / minFrequency, proportion);
+        const auto w = std::exp(Complex(0.0, -juce::MathConstants<double>::twoPi * frequency / sampleRate));
+
+        Complex cascade = 1.0;
+        for (int k = 0; k < numSections; ++k)
+        {
+            const auto& c = sections[k];
+            cascade *= (static_cast<double>(c.b0) + w * (static_cast<double>(c.b1) + w * static_cast<double>(c.b2)))
+                     / (1.0 + w * (static_cast<double>(c.a1) + w * static_cast<double>(c.a2)));
+        }
+
+        const float expectedDb = juce::jmax(floorDb, juce::Decibels::gainToDecibels(static_cast<float>(std::abs(cascade))));
+        const float parallelDb = juce::jmax(floorDb, coefficients.getResponseDb(static_cast<float>(frequency), sampleRate));
+        maxError = juce::jmax(maxError, std::abs(expectedDb - parallelDb));
+    }
+
+    return maxError;
+}
+
+void ParallelFilterBank::load(const Coefficients& newCoefficients)
+{
+    // Lo stato dipende solo dai poli e dall'ingresso: resta valido finché
+    // la struttura non cambia
+    if (newCoefficients.numSections != coefficients.numSections || newCoefficients.numFirTaps != coefficients.numFirTaps)
+        reset();
+
+    coefficients = newCoefficients;
+}
+
+bool ParallelFilterBank::build(const BiquadCoefficients* sections, int numSections)
+{
+    Coefficients result;
+    design(sections, numSections, result);
+    load(result);
+    return result.valid;
+}
+
+void ParallelFilterBank::process(float* const* channels, int numChannels, int numSamples)
+{
+    if (!coefficients.valid)
+        return;
+
+    const auto& beta0 = coefficients.beta0;
+    const auto& beta1 = coefficients.beta1;
+    const auto& a1 = coefficients.a1;
+    const auto& a2 = coefficients.a2;
+    const auto& firTaps = coefficients.firTaps;
+    const int numFirTaps = coefficients.numFirTaps;
+    const int numGroups = (coefficients.numSections + laneWidth - 1) / laneWidth;
+
+    for (int ch = 0; ch < juce::jmin(numChannels, maxChannels); ++ch)
+    {
+        auto* data = channels[ch];
+        auto* s1 = w1[static_cast<size_t>(ch)].data();
+        auto* s2 = w2[static_cast<size_t>(ch)].data();
+        auto* history = firHistory[static_cast<size_t>(ch)].data();
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            const float x = data[n];
+
+            // Parte FIR: history contiene x[n-1], x[n-2], ...
+            float fir = firTaps[0] * x;
+            for (int j = numFirTaps - 1; j > 0; --j)
+            {
+                fir += firTaps[static_cast<size_t>(j)] * history[j - 1];
+                history[j] = history[j - 1];
+            }
+            history[0] = x;
+
+           #if ANALOGEQ_BIQUAD_SSE2
+            const __m128 vx = _mm_set1_ps(x);
+            __m128 acc = _mm_setzero_ps();
+
+            for (int g = 0; g < numGroups; ++g)
+            {
+                const int o = g * laneWidth;
+                const __m128 prev1 = _mm_load_ps(s1 + o);
+                const __m128 prev2 = _mm_load_ps(s2 + o);
+                const __m128 w = _mm_sub_ps(_mm_sub_ps(vx, _mm_mul_ps(_mm_load_ps(a1.data() + o), prev1)),
+                                            _mm_mul_ps(_mm_load_ps(a2.data() + o), prev2));
+                acc = _mm_add_ps(acc, _mm_add_ps(_mm_mul_ps(_mm_load_ps(beta0.data() + o), w),
+                                                 _mm_mul_ps(_mm_load_ps(beta1.data() + o), prev1)));
+                _mm_store_ps(s2 + o, prev1);
+                _mm_store_ps(s1 + o, w);
+            }
+
+            const __m128 high = _mm_movehl_ps(acc, acc);
+            const __m128 pairSum = _mm_add_ps(acc, high);
+            const __m128 sum = _mm_add_ss(pairSum, _mm_shuffle_ps(pairSum, pairSum, 1));
+            data[n] = fir + _mm_cvtss_f32(sum);
+           #elif ANALOGEQ_BIQUAD_NEON
+            const float32x4_t vx = vdupq_n_f32(x);
+            float32x4_t acc = vdupq_n_f32(0.0f);
+
+            for (int g = 0; g < numGroups; ++g)
+            {
+                const int o = g * laneWidth;
+                const float32x4_t prev1 = vld1q_f32(s1 + o);
+                const float32x4_t prev2 = vld1q_f32(s2 + o);
+                const float32x4_t w = vsubq_f32(vsubq_f32(vx, vmulq_f32(vld1q_f32(a1.data() + o), prev1)),
+                                                vmulq_f32(vld1q_f32(a2.data() + o), prev2));
+                acc = vaddq_f32(acc, vaddq_f32(vmulq_f32(vld1q_f32(beta0.data() + o), w),
+                                               vmulq_f32(vld1q_f32(beta1.data() + o), prev1)));
+                vst1q_f32(s2 + o, prev1);
+                vst1q_f32(s1 + o, w);
+            }
+
+            float32x2_t sum = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+            sum = vpadd_f32(sum, sum);
+            data[n] = fir + vget_lane_f32(sum, 0);
+           #else
+            float acc = 0.0f;
+
+            for (int k = 0; k < numGroups * laneWidth; ++k)
+            {
+                const float w = x - a1[static_cast<size_t>(k)] * s1[k] - a2[static_cast<size_t>(k)] * s2[k];
+                acc += beta0[static_cast<size_t>(k)] * w + beta1[static_cast<size_t>(k)] * s1[k];
+                s2[k] = s1[k];
+                s1[k] = w;
+            }
+
+            data[n] = fir + acc;
+           #endif
+        }
+    }
+}
+
+float ParallelFilterBank::Coefficients::getResponseDb(float frequency, double sampleRate) const
+{
+    if (!valid)
+        return 0.0f;
+
+    const auto w = std::exp(Complex(0.0, -juce::MathConstants<double>::twoPi * static_cast<double>(frequency) / sampleRate));
+    Complex response = 0.0;
+    for (int j = numFirTaps - 1; j >= 0; --j)
+        response = response * w + static_cast<double>(firTaps[static_cast<size_t>(j)]);
+
+    for (int k = 0; k < numSections; ++k)
+    {
+        const auto idx = static_cast<size_t>(k);
+        const auto numerator = static_cast<double>(beta0[idx]) + static_cast<double>(beta1[idx]) * w;
+        const auto denominator = 1.0 + w * (static_cast<double>(a1[idx]) + w * static_cast<double>(a2[idx]));
+        response += numerator / denominator;
+    }
+
+    return juce::Decibels::gainToDecibels(static_cast<float>(std::abs(response)));
+}
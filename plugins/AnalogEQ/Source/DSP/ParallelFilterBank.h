@@ -0,0 +1,113 @@
+#pragma once
+
+#include "BiquadCascade.h"
+#include <array>
+#include <cstddef>
+
+//==============================================================================
+/**
+ * Forma parallela (espansione in fratti semplici) di una cascata di biquad.
+ * H(z) = F(z) + somma_k (beta0_k + beta1_k z^-1) / (1 + a1_k z^-1 + a2_k z^-2)
+ *
+ * F(z) è la parte FIR: il termine diretto, più un ritardo per ogni zero in
+ * eccesso rispetto ai poli (le sezioni con poli nell'origine, come un passa
+ * basso del primo ordine a fs/4, finiscono qui).
+ *
+ * Ogni sezione parallela conserva il denominatore della sezione in cascata da
+ * cui deriva, quindi le sezioni sono indipendenti e vengono eseguite 4 alla
+ * volta nelle lane SIMD. Le sezioni usano la forma diretta II: lo stato dipende
+ * solo dai poli, quindi ricostruire i numeratori (residui) non lo altera.
+ *
+ * La conversione richiede poli distinti: cascate con sezioni identiche
+ * (poli ripetuti) non sono convertibili e restano in forma serie.
+ */
+class ParallelFilterBank
+{
+public:
+    static constexpr int laneWidth = 4;
+    static constexpr int maxSections = BiquadCascade::maxSections;
+    static constexpr int maxChannels = BiquadCascade::maxChannels;
+    static constexpr int maxFirTaps = 2 * maxSections + 1;
+
+    /**
+     * Coefficienti della forma parallela, separati dallo stato: vengono
+     * calcolati (design) fuori dal thread audio e caricati con load.
+     */
+    struct Coefficients
+    {
+        static constexpr int paddedSections = ((maxSections + laneWidth - 1) / laneWidth) * laneWidth;
+
+        alignas(64) std::array<float, paddedSections> beta0 {};
+        alignas(64) std::array<float, paddedSections> beta1 {};
+        alignas(64) std::array<float, paddedSections> a1 {};
+        alignas(64) std::array<float, paddedSections> a2 {};
+        std::array<float, maxFirTaps> firTaps {};
+
+        int numFirTaps = 1;
+        int numSections = 0;
+        bool valid = false;
+
+        /**
+         * Calcola la risposta in frequenza della forma parallela.
+         * @return Il guadagno in dB (con floor a -100 dB)
+         */
+        float getResponseDb(float frequency, double sampleRate) const;
+    };
+
+    ParallelFilterBank();
+
+    /**
+     * Converte una cascata di sezioni in forma parallela. Non tocca lo stato
+     * di nessun banco: si può chiamare da qualsiasi thread.
+     * @param sections Le sezioni in cascata, nell'ordine di processamento
+     * @param numSections Il numero di sezioni
+     * @param result I coefficienti (result.valid indica se la conversione è riuscita)
+     * @return true se la conversione è riuscita
+     */
+    static bool design(const BiquadCoefficients* sections, int numSections, Coefficients& result);
+
+    /**
+     * Errore massimo in dB tra la forma parallela e il prodotto delle sezioni
+     * in cascata, su numPoints frequenze logaritmiche tra 20 Hz e 20 kHz
+     * (o 0.49 fs). Sotto floorDb le differenze non contano.
+     */
+    static float measureErrorDb(const Coefficients& coefficients, const BiquadCoefficients* sections, int numSections,
+                                double sampleRate, int numPoints, float floorDb);
+
+    /**
+     * Carica coefficienti già calcolati (senza allocare: thread audio).
+     * Lo stato viene conservato se il numero di sezioni e di prese FIR non cambia.
+     */
+    void load(const Coefficients& newCoefficients);
+
+    /**
+     * Converte e carica in un passo solo (design + load).
+     * @return true se la conversione è riuscita
+     */
+    bool build(const BiquadCoefficients* sections, int numSections);
+
+    /**
+     * Processa in-place il buffer con tutte le sezioni in parallelo.
+     */
+    void process(float* const* channels, int numChannels, int numSamples);
+
+    void reset();
+
+    bool isValid() const { return coefficients.valid; }
+    int getNumSections() const { return coefficients.numSections; }
+
+    /** Risposta in frequenza dei coefficienti caricati, in dB. */
+    float getResponseDb(float frequency, double sampleRate) const { return coefficients.getResponseDb(frequency, sampleRate); }
+
+private:
+    static constexpr int paddedSections = Coefficients::paddedSections;
+
+    Coefficients coefficients;
+
+    // Stati forma diretta II per canale: w[n-1], w[n-2]
+    alignas(64) std::array<std::array<float, paddedSections>, maxChannels> w1;
+    alignas(64) std::array<std::array<float, paddedSections>, maxChannels> w2;
+
+    // Ingressi passati per canale della parte FIR: x[n-1], x[n-2], ...
+    std::array<std::array<float, maxFirTaps>, maxChannels> firHistory;
+};
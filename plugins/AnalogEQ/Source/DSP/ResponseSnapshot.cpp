@@ -0,0 +1,91 @@
+#include "ResponseSnapshot.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <complex>
+
+float ResponseSnapshot::getResponseDb(float frequency) const
+{
+    std::complex<double> jw = std::exp(std::complex<double>(0.0,
+        -juce::MathConstants<double>::twoPi * static_cast<double>(frequency) / sampleRate));
+    std::complex<double> jw2 = jw * jw;
+
+    float totalDb = 0.0f;
+
+    for (int s = 0; s < numSections; ++s)
+    {
+        if (s == numBaseRateSections)
+        {
+            jw = std::exp(std::complex<double>(0.0,
+                -juce::MathConstants<double>::twoPi * static_cast<double>(frequency) / oversampledSampleRate));
+            jw2 = jw * jw;
+        }
+
+        const auto& section = sections[static_cast<size_t>(s)];
+        const auto numerator = static_cast<double>(section.b0)
+                             + static_cast<double>(section.b1) * jw
+                             + static_cast<double>(section.b2) * jw2;
+        const auto denominator = 1.0
+                               + static_cast<double>(section.a1) * jw
+                               + static_cast<double>(section.a2) * jw2;
+        const auto magnitude = static_cast<float>(std::abs(numerator / denominator));
+        totalDb += juce::Decibels::gainToDecibels(magnitude);
+    }
+
+    return totalDb;
+}
+
+//==============================================================================
+ResponseSnapshotPublisher::Reader::Reader(const ResponseSnapshotPublisher& owner, int slotToRead)
+    : publisher(&owner),
+      snapshot(&owner.pool[static_cast<size_t>(slotToRead)]),
+      slot(slotToRead)
+{
+}
+
+ResponseSnapshotPublisher::Reader::Reader(Reader&& other) noexcept
+    : publisher(other.publisher), snapshot(other.snapshot), slot(other.slot)
+{
+    other.publisher = nullptr;
+}
+
+ResponseSnapshotPublisher::Reader::~Reader()
+{
+    if (publisher != nullptr)
+        publisher->readers[static_cast<size_t>(slot)].fetch_sub(1, std::memory_order_release);
+}
+
+ResponseSnapshotPublisher::Reader ResponseSnapshotPublisher::read() const
+{
+    for (;;)
+    {
+        const int slot = current.load();
+        readers[static_cast<size_t>(slot)].fetch_add(1);
+
+        // Se nel frattempo è stato pubblicato un altro slot, quello marcato
+        // potrebbe essere già in riscrittura: si riprova
+        if (current.load() == slot)
+            return Reader(*this, slot);
+
+        readers[static_cast<size_t>(slot)].fetch_sub(1, std::memory_order_release);
+    }
+}
+
+ResponseSnapshot* ResponseSnapshotPublisher::beginWrite()
+{
+    const int published = current.load(std::memory_order_relaxed);
+
+    for (int slot = 0; slot < poolSize; ++slot)
+        if (slot != published && readers[static_cast<size_t>(slot)].load() == 0)
+            return &pool[static_cast<size_t>(slot)];
+
+    return nullptr;
+}
+
+void ResponseSnapshotPublisher::publish(ResponseSnapshot& snapshot)
+{
+    const auto slot = static_cast<int>(&snapshot - pool.data());
+    jassert(juce::isPositiveAndBelow(slot, poolSize));
+
+    snapshot.version = publishedVersion.load(std::memory_order_relaxed) + 1;
+    current.store(slot);
+    publishedVersion.store(snapshot.version, std::memory_order_release);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "BiquadCascade.h"
+#include <array>
+#include <atomic>
+
+//==============================================================================
+/**
+ * Copia immutabile dei coefficienti attivi della catena, per le letture
+ * fuori dal thread audio (curva di risposta, job in background).
+ * Contiene le sezioni delle bande abilitate, nell'ordine di processamento.
+ */
+struct ResponseSnapshot
+{
+    unsigned int version = 0;
+    double sampleRate = 44100.0;
+    int numSections = 0;
+    std::array<BiquadCoefficients, BiquadCascade::maxSections> sections;
+
+    // Sovracampionamento selettivo: le sezioni dopo le prime numBaseRateSections
+    // sono progettate a oversampledSampleRate
+    int numBaseRateSections = 0;
+    double oversampledSampleRate = 44100.0;
+
+    /**
+     * Calcola la risposta in frequenza delle sezioni.
+     * @return La somma in dB delle risposte (0 dB senza sezioni)
+     */
+    float getResponseDb(float frequency) const;
+};
+
+//==============================================================================
+/**
+ * Pubblicazione lock-free di ResponseSnapshot (schema RCU con contatori di
+ * lettori per slot).
+ * Un solo scrittore (il thread audio) scrive in uno slot del pool che non è
+ * quello pubblicato e non ha lettori, poi lo pubblica; i lettori, su qualsiasi
+ * thread, marcano lo slot pubblicato e verificano che lo sia ancora.
+ * Uno slot viene riusato solo quando nessun lettore lo tiene, quindi una
+ * copia letta non cambia mai. Nessuna allocazione, nessun lock: se tutti gli
+ * slot liberi sono occupati dai lettori, lo scrittore salta la pubblicazione.
+ */
+class ResponseSnapshotPublisher
+{
+public:
+    static constexpr int poolSize = 4;
+
+    /**
+     * Accesso in lettura alla copia pubblicata: la copia resta valida e
+     * invariata finché il Reader esiste. Da tenere solo per la durata della
+     * lettura (uno slot tenuto a lungo riduce quelli a disposizione dello
+     * scrittore).
+     */
+    class Reader
+    {
+    public:
+        Reader(Reader&& other) noexcept;
+        ~Reader();
+
+        const ResponseSnapshot& operator*() const { return *snapshot; }
+        const ResponseSnapshot* operator->() const { return snapshot; }
+
+    private:
+        friend class ResponseSnapshotPublisher;
+        Reader(const ResponseSnapshotPublisher& owner, int slot);
+
+        const ResponseSnapshotPublisher* publisher = nullptr;
+        const ResponseSnapshot* snapshot = nullptr;
+        int slot = -1;
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        Reader& operator=(Reader&&) = delete;
+    };
+
+    /**
+     * Qualsiasi thread: acquisisce la copia pubblicata più recente.
+     */
+    Reader read() const;
+
+    /**
+     * Versione della copia pubblicata (cambia a ogni pubblicazione).
+     */
+    unsigned int getVersion() const { return publishedVersion.load(std::memory_order_acquire); }
+
+    /**
+     * Scrittore: restituisce uno slot libero da riempire, o nullptr se tutti
+     * gli slot non pubblicati hanno lettori (riprovare più tardi).
+     */
+    ResponseSnapshot* beginWrite();
+
+    /**
+     * Scrittore: pubblica lo slot ottenuto da beginWrite.
+     */
+    void publish(ResponseSnapshot& snapshot);
+
+private:
+    std::array<ResponseSnapshot, poolSize> pool;
+    mutable std::array<std::atomic<int>, poolSize> readers {};
+    std::atomic<int> current { 0 };
+    std::atomic<unsigned int> publishedVersion { 0 };
+};
@@ -0,0 +1,366 @@
+#include "SvfCascade.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cmath>
+
+namespace
+{
+    inline void snapToZero(float& value)
+    {
+        if (!(value < -1.0e-8f || value > 1.0e-8f))
+            value = 0.0f;
+    }
+
+    /** Un canale: una lane scalare, campioni consecutivi. */
+    struct MonoLanes
+    {
+        using Vec = float;
+        static constexpr int width = 1;
+        static Vec load(const float* p) { return *p; }
+        static void store(float* p, Vec v) { *p = v; }
+        static Vec broadcast(float x) { return x; }
+        static Vec add(Vec a, Vec b) { return a + b; }
+        static Vec sub(Vec a, Vec b) { return a - b; }
+        static Vec mul(Vec a, Vec b) { return a * b; }
+    };
+
+    /** Frame stereo interleaved: L e R nelle prime due lane, come processStereoFrames. */
+    struct StereoLanes
+    {
+        static constexpr int width = 2;
+
+       #if ANALOGEQ_BIQUAD_SSE2
+        using Vec = __m128;
+        static Vec load(const float* p) { return BiquadKernels::loadPair(p); }
+        static void store(float* p, Vec v) { BiquadKernels::storePair(p, v); }
+        static Vec broadcast(float x) { return _mm_set1_ps(x); }
+        static Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+        static Vec sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+        static Vec mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+       #elif ANALOGEQ_BIQUAD_NEON
+        using Vec = float32x2_t;
+        static Vec load(const float* p) { return vld1_f32(p); }
+        static void store(float* p, Vec v) { vst1_f32(p, v); }
+        static Vec broadcast(float x) { return vdup_n_f32(x); }
+        static Vec add(Vec a, Vec b) { return vadd_f32(a, b); }
+        static Vec sub(Vec a, Vec b) { return vsub_f32(a, b); }
+        static Vec mul(Vec a, Vec b) { return vmul_f32(a, b); }
+       #else
+        struct Vec { float l, r; };
+        static Vec load(const float* p) { return { p[0], p[1] }; }
+        static void store(float* p, Vec v) { p[0] = v.l; p[1] = v.r; }
+        static Vec broadcast(float x) { return { x, x }; }
+        static Vec add(Vec a, Vec b) { return { a.l + b.l, a.r + b.r }; }
+        static Vec sub(Vec a, Vec b) { return { a.l - b.l, a.r - b.r }; }
+        static Vec mul(Vec a, Vec b) { return { a.l * b.l, a.r * b.r }; }
+       #endif
+    };
+
+    /** Coefficienti della ricorsione al campione n del tile. */
+    struct Recursion
+    {
+        float a1, a2, a3, m0, m1, m2;
+    };
+
+    /**
+     * Una sezione SVF su count frame (Simper, "Linear Trap Integrated SVF"):
+     * v3 = x - ic2, v1 = a1 ic1 + a2 v3, v2 = ic2 + a2 ic1 + a3 v3,
+     * ic1 = 2 v1 - ic1, ic2 = 2 v2 - ic2, y = m0 x + m1 v1 + m2 v2.
+     */
+    template <typename Lanes, typename CoefficientsAt>
+    inline void processSection(float* frames, int count, float* state1, float* state2, CoefficientsAt&& coefficientsAt)
+    {
+        using Vec = typename Lanes::Vec;
+        Vec ic1 = Lanes::load(state1);
+        Vec ic2 = Lanes::load(state2);
+
+        for (int n = 0; n < count; ++n)
+        {
+            const Recursion c = coefficientsAt(n);
+            float* frame = frames + Lanes::width * n;
+
+            const Vec v0 = Lanes::load(frame);
+            const Vec v3 = Lanes::sub(v0, ic2);
+            const Vec v1 = Lanes::add(Lanes::mul(Lanes::broadcast(c.a1), ic1), Lanes::mul(Lanes::broadcast(c.a2), v3));
+            const Vec v2 = Lanes::add(ic2, Lanes::add(Lanes::mul(Lanes::broadcast(c.a2), ic1),
+                                                      Lanes::mul(Lanes::broadcast(c.a3), v3)));
+            ic1 = Lanes::sub(Lanes::add(v1, v1), ic1);
+            ic2 = Lanes::sub(Lanes::add(v2, v2), ic2);
+
+            const Vec output = Lanes::add(Lanes::mul(Lanes::broadcast(c.m0), v0),
+                                          Lanes::add(Lanes::mul(Lanes::broadcast(c.m1), v1),
+                                                     Lanes::mul(Lanes::broadcast(c.m2), v2)));
+            Lanes::store(frame, output);
+        }
+
+        Lanes::store(state1, ic1);
+        Lanes::store(state2, ic2);
+    }
+}
+
+SvfCascade::SvfCascade()
+{
+    for (int idx = 0; idx < maxSections; ++idx)
+    {
+        setCurrent(idx, {});
+        steps[static_cast<size_t>(idx)] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+        targets[static_cast<size_t>(idx)] = {};
+    }
+
+    s1.fill(0.0f);
+    s2.fill(0.0f);
+    numSections.fill(1);
+    targetSections.fill(1);
+}
+
+SvfCascade::Parameters SvfCascade::fromBiquad(const BiquadCoefficients& coefficients)
+{
+    // Con la bilineare s = (1 - z^-1) / (g (1 + z^-1)) il denominatore
+    // s² + k s + 1 diventa, normalizzato per n = 1 + k g + g²,
+    // 1 + 2 (g² - 1) / n z^-1 + (1 - k g + g²) / n z^-2: da qui g e k.
+    // Il numeratore m0 s² + (m0 k + m1) s + (m0 + m2) si ricava dai valori
+    // in z = 1, z = -1 e dalla differenza b0 - b2.
+    constexpr double minimumMargin = 1.0e-9;
+
+    const auto b0 = static_cast<double>(coefficients.b0);
+    const auto b1 = static_cast<double>(coefficients.b1);
+    const auto b2 = static_cast<double>(coefficients.b2);
+    const auto a1 = static_cast<double>(coefficients.a1);
+    const auto a2 = static_cast<double>(coefficients.a2);
+
+    const auto atDc = juce::jmax(minimumMargin, 1.0 + a1 + a2);
+    const auto atNyquist = juce::jmax(minimumMargin, 1.0 - a1 + a2);
+
+    const auto sg = std::sqrt(atDc / atNyquist);
+    const auto sk = juce::jmax(0.0, 2.0 * (1.0 - a2) / (sg * atNyquist));
+    const auto norm = 4.0 / atNyquist;
+
+    const auto highPass = norm * (b0 - b1 + b2) * 0.25;
+    const auto bandPass = norm * (b0 - b2) / (2.0 * sg);
+    const auto lowPass = norm * (b0 + b1 + b2) / (4.0 * sg * sg);
+
+    return { static_cast<float>(sg), static_cast<float>(sk), static_cast<float>(highPass),
+             static_cast<float>(bandPass - sk * highPass), static_cast<float>(lowPass - highPass) };
+}
+
+void SvfCascade::setCurrent(int idx, const Parameters& parameters)
+{
+    const auto i = static_cast<size_t>(idx);
+    g[i] = parameters.g;
+    k[i] = parameters.k;
+    m0[i] = parameters.m0;
+    m1[i] = parameters.m1;
+    m2[i] = parameters.m2;
+    updateRecursion(idx);
+}
+
+void SvfCascade::updateRecursion(int idx)
+{
+    const auto i = static_cast<size_t>(idx);
+    c1[i] = 1.0f / (1.0f + g[i] * (g[i] + k[i]));
+    c2[i] = g[i] * c1[i];
+    c3[i] = g[i] * c2[i];
+}
+
+void SvfCascade::setTargets(int band, const BiquadCoefficients* sections, int newNumSections, int rampSamples)
+{
+    jassert(juce::isPositiveAndBelow(band, maxBands));
+    const auto b = static_cast<size_t>(band);
+    newNumSections = juce::jlimit(1, maxSectionsPerBand, newNumSections);
+
+    // Le sezioni nuove partono dall'identità, quelle in più vi arrivano
+    const int active = numSections[b];
+    const int total = juce::jmax(active, newNumSections);
+
+    for (int section = 0; section < total; ++section)
+    {
+        const int idx = index(band, section);
+        targets[static_cast<size_t>(idx)] = section < newNumSections ? fromBiquad(sections[section]) : Parameters {};
+
+        if (section >= active)
+        {
+            setCurrent(idx, {});
+            resetSection(idx);
+        }
+    }
+
+    numSections[b] = total;
+    targetSections[b] = newNumSections;
+
+    if (rampSamples <= 0)
+    {
+        finishRamp(band);
+        return;
+    }
+
+    const float scale = 1.0f / static_cast<float>(rampSamples);
+    for (int section = 0; section < total; ++section)
+    {
+        const auto i = static_cast<size_t>(index(band, section));
+        const auto& target = targets[i];
+        steps[i] = { (target.g - g[i]) * scale, (target.k - k[i]) * scale, (target.m0 - m0[i]) * scale,
+                     (target.m1 - m1[i]) * scale, (target.m2 - m2[i]) * scale };
+    }
+
+    remaining[b] = rampSamples;
+}
+
+void SvfCascade::finishRamp(int band)
+{
+    const auto b = static_cast<size_t>(band);
+
+    for (int section = 0; section < numSections[b]; ++section)
+    {
+        const int idx = index(band, section);
+        if (section < targetSections[b])
+        {
+            setCurrent(idx, targets[static_cast<size_t>(idx)]);
+        }
+        else
+        {
+            setCurrent(idx, {});
+            resetSection(idx);
+        }
+    }
+
+    numSections[b] = targetSections[b];
+    remaining[b] = 0;
+}
+
+void SvfCascade::advanceRamp(int band, int count)
+{
+    const auto b = static_cast<size_t>(band);
+    remaining[b] -= count;
+
+    if (remaining[b] <= 0)
+    {
+        finishRamp(band);
+        return;
+    }
+
+    const auto samples = static_cast<float>(count);
+    for (int section = 0; section < numSections[b]; ++section)
+    {
+        const auto i = static_cast<size_t>(index(band, section));
+        const auto& step = steps[i];
+        g[i] += step.g * samples;
+        k[i] += step.k * samples;
+        m0[i] += step.m0 * samples;
+        m1[i] += step.m1 * samples;
+        m2[i] += step.m2 * samples;
+    }
+}
+
+void SvfCascade::resetSection(int idx)
+{
+    for (int ch = 0; ch < maxChannels; ++ch)
+    {
+        s1[static_cast<size_t>(idx * maxChannels + ch)] = 0.0f;
+        s2[static_cast<size_t>(idx * maxChannels + ch)] = 0.0f;
+    }
+}
+
+void SvfCascade::resetBand(int band)
+{
+    for (int section = 0; section < maxSectionsPerBand; ++section)
+        resetSection(index(band, section));
+}
+
+void SvfCascade::reset()
+{
+    s1.fill(0.0f);
+    s2.fill(0.0f);
+}
+
+void SvfCascade::processTile(int band, float* frames, int numChannels, int count, bool smoothing)
+{
+    for (int section = 0; section < numSections[static_cast<size_t>(band)]; ++section)
+    {
+        const int idx = index(band, section);
+        const auto i = static_cast<size_t>(idx);
+        float* state1 = s1.data() + idx * maxChannels;
+        float* state2 = s2.data() + idx * maxChannels;
+
+        if (!smoothing)
+        {
+            const Recursion fixed { c1[i], c2[i], c3[i], m0[i], m1[i], m2[i] };
+            const auto at = [&fixed](int) { return fixed; };
+
+            if (numChannels == 2)
+                processSection<StereoLanes>(frames, count, state1, state2, at);
+            else
+                processSection<MonoLanes>(frames, count, state1, state2, at);
+
+            continue;
+        }
+
+        // Parametri interpolati campione per campione: il ciclo (a lunghezza
+        // fissa, senza dipendenze tra campioni) viene vettorizzato, divisione
+        // compresa. I campioni oltre count non vengono usati.
+        alignas(64) float a1[tileSize], a2[tileSize], a3[tileSize];
+        alignas(64) float w0[tileSize], w1[tileSize], w2[tileSize];
+        const auto& step = steps[i];
+        const float g0 = g[i], k0 = k[i], w00 = m0[i], w10 = m1[i], w20 = m2[i];
+
+        for (int n = 0; n < tileSize; ++n)
+        {
+            const auto t = static_cast<float>(n + 1);
+            const float gn = g0 + step.g * t;
+            const float kn = k0 + step.k * t;
+            a1[n] = 1.0f / (1.0f + gn * (gn + kn));
+            a2[n] = gn * a1[n];
+            a3[n] = gn * a2[n];
+            w0[n] = w00 + step.m0 * t;
+            w1[n] = w10 + step.m1 * t;
+            w2[n] = w20 + step.m2 * t;
+        }
+
+        const auto at = [&](int n) { return Recursion { a1[n], a2[n], a3[n], w0[n], w1[n], w2[n] }; };
+
+        if (numChannels == 2)
+            processSection<StereoLanes>(frames, count, state1, state2, at);
+        else
+            processSection<MonoLanes>(frames, count, state1, state2, at);
+    }
+}
+
+void SvfCascade::processBand(int band, float* const* channels, int numChannels, int numSamples)
+{
+    jassert(juce::isPositiveAndBelow(band, maxBands));
+    numChannels = juce::jmin(numChannels, maxChannels);
+    if (numChannels == 0)
+        return;
+
+    const auto b = static_cast<size_t>(band);
+    alignas(16) float frames[maxChannels * tileSize];
+
+    for (int start = 0; start < numSamples;)
+    {
+        // Un tile non scavalca la fine dell'interpolazione
+        const bool smoothing = remaining[b] > 0;
+        int count = juce::jmin(tileSize, numSamples - start);
+        if (smoothing)
+            count = juce::jmin(count, remaining[b]);
+
+        if (numChannels == 2)
+        {
+            BiquadKernels::interleaveTile(channels[0] + start, channels[1] + start, frames, count);
+            processTile(band, frames, 2, count, smoothing);
+            BiquadKernels::deinterleaveTile(frames, channels[0] + start, channels[1] + start, count);
+        }
+        else
+        {
+            processTile(band, channels[0] + start, 1, count, smoothing);
+        }
+
+        if (smoothing)
+            advanceRamp(band, count);
+
+        start += count;
+    }
+
+    for (int s = index(band, 0) * maxChannels; s < index(band, numSections[b]) * maxChannels; ++s)
+    {
+        snapToZero(s1[static_cast<size_t>(s)]);
+        snapToZero(s2[static_cast<size_t>(s)]);
+    }
+}
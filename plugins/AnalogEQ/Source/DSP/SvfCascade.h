@@ -0,0 +1,119 @@
+#pragma once
+
+#include "BiquadCascade.h"
+#include <array>
+
+//==============================================================================
+/**
+ * Motore a cascata di filtri a variabili di stato con trasformazione che
+ * preserva la topologia (TPT SVF, forma di Simper/Zavalishin), con lo
+ * stesso layout a slot di BiquadCascade.
+ *
+ * Ogni sezione biquad progettata (qualsiasi tipo di banda e metodo) viene
+ * convertita nei parametri equivalenti dell'SVF: g = tan(ω/2) del polo, lo
+ * smorzamento k e le tre miscele delle uscite passa-alto, passa-banda e
+ * passa-basso. A coefficienti fermi la risposta è la stessa della biquad.
+ *
+ * I nuovi coefficienti non sostituiscono quelli attivi: g, k e miscele
+ * vengono interpolati linearmente a ogni campione (setTargets), e i
+ * coefficienti della ricorsione ricalcolati con una sola divisione per
+ * sezione e campione, vettorizzata sui campioni del tile. Con g > 0 e
+ * k >= 0 lungo tutto il percorso il filtro resta stabile anche sotto
+ * modulazione veloce, dove la forma diretta genera transitori.
+ *
+ * Le sezioni che una banda guadagna partono dall'identità (passa-tutto
+ * piatto), quelle che perde vi arrivano alla fine dell'interpolazione.
+ * I due canali di un frame stereo avanzano insieme nelle lane SIMD.
+ * Nessuna allocazione dopo la costruzione.
+ */
+class SvfCascade
+{
+public:
+    static constexpr int maxBands = BiquadCascade::maxBands;
+    static constexpr int maxSectionsPerBand = BiquadCascade::maxSectionsPerBand;
+    static constexpr int maxSections = BiquadCascade::maxSections;
+    static constexpr int maxChannels = BiquadCascade::maxChannels;
+
+    /**
+     * Parametri di una sezione: l'uscita è m0 * ingresso + m1 * passa-banda
+     * + m2 * passa-basso (passa-banda non normalizzato, s / (s² + k s + 1)).
+     */
+    struct Parameters
+    {
+        float g = 1.0f;
+        float k = 2.0f;
+        float m0 = 1.0f;
+        float m1 = 0.0f;
+        float m2 = 0.0f;
+    };
+
+    SvfCascade();
+
+    /**
+     * Parametri SVF con la stessa funzione di trasferimento della sezione
+     * (poli stabili; quelli sul bordo vengono portati appena dentro).
+     */
+    static Parameters fromBiquad(const BiquadCoefficients& coefficients);
+
+    /**
+     * Nuovi coefficienti di una banda, raggiunti in rampSamples campioni
+     * (0: subito). Una interpolazione in corso riparte dai valori correnti.
+     */
+    void setTargets(int band, const BiquadCoefficients* sections, int numSections, int rampSamples);
+
+    /** Indica se la banda sta ancora interpolando. */
+    bool isSmoothing(int band) const { return remaining[static_cast<size_t>(band)] > 0; }
+
+    /** Sezioni processate (durante l'interpolazione anche quelle in uscita). */
+    int getNumSections(int band) const { return numSections[static_cast<size_t>(band)]; }
+
+    /** Parametri correnti di una sezione (durante l'interpolazione, quelli raggiunti). */
+    Parameters getParameters(int band, int section) const
+    {
+        const auto i = static_cast<size_t>(index(band, section));
+        return { g[i], k[i], m0[i], m1[i], m2[i] };
+    }
+
+    void resetBand(int band);
+    void reset();
+
+    /**
+     * Processa in-place la banda sui primi numChannels canali.
+     */
+    void processBand(int band, float* const* channels, int numChannels, int numSamples);
+
+    /** Frame per tile: i coefficienti interpolati di un tile restano in L1. */
+    static constexpr int tileSize = 64;
+
+private:
+    static int index(int band, int section) { return band * maxSectionsPerBand + section; }
+
+    void setCurrent(int idx, const Parameters& parameters);
+    void updateRecursion(int idx);
+    void finishRamp(int band);
+    void advanceRamp(int band, int count);
+    void processTile(int band, float* frames, int numChannels, int count, bool smoothing);
+    void resetSection(int idx);
+
+    // Parametri correnti, incrementi per campione e destinazione, per sezione
+    alignas(64) std::array<float, maxSections> g;
+    alignas(64) std::array<float, maxSections> k;
+    alignas(64) std::array<float, maxSections> m0;
+    alignas(64) std::array<float, maxSections> m1;
+    alignas(64) std::array<float, maxSections> m2;
+    std::array<Parameters, maxSections> steps;
+    std::array<Parameters, maxSections> targets;
+
+    // Coefficienti della ricorsione a parametri fermi
+    alignas(64) std::array<float, maxSections> c1;
+    alignas(64) std::array<float, maxSections> c2;
+    alignas(64) std::array<float, maxSections> c3;
+
+    // Stati degli integratori interleaved per canale: [sezione][canale]
+    alignas(64) std::array<float, maxSections * maxChannels> s1;
+    alignas(64) std::array<float, maxSections * maxChannels> s2;
+
+    std::array<int, maxBands> numSections;
+    std::array<int, maxBands> targetSections;
+    std::array<int, maxBands> remaining {};
+};
@@ -7,15 +7,14 @@ AudioPluginAudioProcessorEditor::AudioPluginAudioProcessorEditor(AudioPluginAudi
     // Setup look and feel
     setLookAndFeel(&modernLookAndFeel);
     
-    // Crea il componente della curva di frequenza (con APVTS per interattività e processor per spectrum)
+    // Crea il componente della curva di frequenza (parametri e spectrum dal processor)
     frequencyResponseCurve = std::make_unique<FrequencyResponseCurve>(
-        processorRef.getFilterChain(), 
-        processorRef.getAPVTS(),
+        processorRef.getFilterChain(),
         processorRef);
     addAndMakeVisible(frequencyResponseCurve.get());
     
     // Create filter control panel
-    filterControlPanel = std::make_unique<FilterControlPanel>(processorRef.getAPVTS());
+    filterControlPanel = std::make_unique<FilterControlPanel>(processorRef.getParameterTable());
     addAndMakeVisible(filterControlPanel.get());
     
     // Connect filter selection to control panel
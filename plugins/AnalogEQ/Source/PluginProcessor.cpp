@@ -1,25 +1,37 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include "Utils/ParameterHelper.h"
+#include "DSP/KernelDispatch.h"
+#include <algorithm>
 #include <cmath>
 
+using ParameterHelper::BandParameter;
+using ParameterHelper::GlobalParameter;
+
+namespace
+{
+    // Parametri di banda che richiedono una nuova progettazione dei coefficienti
+    // (i parametri dyn_* vengono letti a ogni blocco dal detector)
+    constexpr BandParameter bandDesignParameters[] { BandParameter::enabled, BandParameter::type, BandParameter::freq,
+                                                     BandParameter::gain, BandParameter::q, BandParameter::slope };
+}
+
 //==============================================================================
 AudioPluginAudioProcessor::AudioPluginAudioProcessor()
     : AudioProcessor(BusesProperties()
                     .withInput("Input", juce::AudioChannelSet::stereo(), true)
                     .withInput("Sidechain", juce::AudioChannelSet::stereo(), false)
                     .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts(*this, nullptr, "Parameters", ParameterHelper::createParameterLayout(maxNumFilters))
+      apvts(*this, nullptr, "Parameters", ParameterHelper::createParameterLayout(maxNumFilters)),
+      parameterTable(apvts, maxNumFilters)
 {
     // Inizializza i filtri
-    filterInstances.fill(nullptr);
     currentFilterTypes.fill(FilterType::Bell);
     
     // Crea i filtri iniziali (tutti disabilitati tranne il primo)
     for (int i = 0; i < maxNumFilters; ++i)
     {
         auto* filter = filterChain.addFilter(FilterType::Bell);
-        filterInstances[i] = filter;
         currentFilterTypes[i] = FilterType::Bell;
         
         if (filter)
@@ -31,27 +43,47 @@ AudioPluginAudioProcessor::AudioPluginAudioProcessor()
         }
     }
 
+    filterChain.publishResponseSnapshot();
+
     for (auto& line : naturalPhaseDelayLines)
         line.assign(maxNaturalPhaseDelaySamples, 0.0f);
 
+    // Kernel, storia e buffer di progettazione alla dimensione massima: il
+    // cambio di qualità cambia solo il numero di tap attivi
     linearPhaseKernel.assign(static_cast<size_t>(maxLinearPhaseKernelSize), 0.0f);
     linearPhaseKernel[static_cast<size_t>(currentLinearPhaseLatencySamples)] = 1.0f;
+    linearPhaseKernelSize = currentLinearPhaseKernelSize;
     for (auto& history : linearPhaseHistory)
-        history.assign(static_cast<size_t>(maxLinearPhaseKernelSize), 0.0f);
-
-    const auto nan = std::numeric_limits<float>::quiet_NaN();
-    previousFreq.fill(nan);
-    previousGain.fill(nan);
-    previousQ.fill(nan);
-    previousSlope.fill(nan);
-    previousEnabled.fill(nan);
-    previousType.fill(nan);
+        history.assign(static_cast<size_t>(2 * maxLinearPhaseKernelSize), 0.0f);
+
+    linearPhaseFFTBuffer.assign(static_cast<size_t>(2 << linearPhaseFFTOrder), 0.0f);
+    linearPhaseMagnitudes.assign(static_cast<size_t>((1 << (linearPhaseFFTOrder - 1)) + 1), 0.0f);
+    linearPhaseWindowPhases.assign(static_cast<size_t>(maxLinearPhaseKernelSize), 0.0f);
+    linearPhaseWindowSines.assign(static_cast<size_t>(maxLinearPhaseKernelSize), 0.0f);
+    linearPhaseWindowCosines.assign(static_cast<size_t>(maxLinearPhaseKernelSize), 0.0f);
+
     dynamicBaseGain.fill(0.0f);
     dynamicCurrentOffset.fill(0.0f);
+    dynamicAppliedOffset.fill(0.0f);
+
+    for (int i = 0; i < maxNumFilters; ++i)
+    {
+        auto& listener = bandChangeListeners[static_cast<size_t>(i)];
+        listener.dirtyBands = &dirtyBands;
+        listener.bandBit = 1u << i;
+
+        for (const auto parameter : bandDesignParameters)
+            apvts.addParameterListener(ParameterHelper::getParameterID(i, ParameterHelper::getBandParameterKey(parameter)),
+                                       &listener);
+    }
 }
 
 AudioPluginAudioProcessor::~AudioPluginAudioProcessor()
 {
+    for (int i = 0; i < maxNumFilters; ++i)
+        for (const auto parameter : bandDesignParameters)
+            apvts.removeParameterListener(ParameterHelper::getParameterID(i, ParameterHelper::getBandParameterKey(parameter)),
+                                          &bandChangeListeners[static_cast<size_t>(i)]);
 }
 
 //==============================================================================
@@ -109,11 +141,19 @@ void AudioPluginAudioProcessor::changeProgramName(int index, const juce::String&
 //==============================================================================
 void AudioPluginAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    // Prepara la catena di filtri
-    filterChain.prepare(sampleRate, samplesPerBlock);
-    
-    // Aggiorna i coefficienti dei filtri con il nuovo sample rate
-    filterChain.updateAllCoefficients(sampleRate);
+    // Kernel DSP per il set di istruzioni della CPU
+    KernelDispatch::selectKernels();
+
+    // Stadi di sovracampionamento di tutti i fattori, poi la catena di filtri
+    // alla frequenza di lavoro del fattore scelto
+    oversampler.prepare(samplesPerBlock);
+    oversampler.reset();
+    oversampler.setMode(getOversamplingOrder(), getOversamplingFilter(), getOversamplingScope());
+    updateDesignMethod();
+    updateCutResponse();
+    updateFilterTopology();
+    prepareFilterChain(sampleRate, samplesPerBlock);
+    filterChain.publishResponseSnapshot();
 
     dryBuffer.setSize(2, juce::jmax(samplesPerBlock, 1), false, false, true);
     dryBuffer.clear();
@@ -132,6 +172,84 @@ void AudioPluginAudioProcessor::prepareToPlay(double sampleRate, int samplesPerB
     // Nota: Lo spectrum analyzer verrà preparato nel FrequencyResponseCurve quando riceve i primi campioni
 }
 
+int AudioPluginAudioProcessor::getOversamplingOrder() const
+{
+    return static_cast<int>(parameterTable.getValue(GlobalParameter::oversampling));
+}
+
+ChainOversampler::Filter AudioPluginAudioProcessor::getOversamplingFilter() const
+{
+    return static_cast<int>(parameterTable.getValue(GlobalParameter::oversamplingFilter)) == 1
+        ? ChainOversampler::Filter::linearPhaseFir
+        : ChainOversampler::Filter::polyphaseIir;
+}
+
+ChainOversampler::Scope AudioPluginAudioProcessor::getOversamplingScope() const
+{
+    return static_cast<int>(parameterTable.getValue(GlobalParameter::oversamplingScope)) == 1
+        ? ChainOversampler::Scope::highBands
+        : ChainOversampler::Scope::wholeChain;
+}
+
+void AudioPluginAudioProcessor::prepareFilterChain(double sampleRate, int samplesPerBlock)
+{
+    // Coefficienti progettati alla frequenza di lavoro: con il sovracampionamento
+    // le bande vicine a Nyquist non subiscono il cramping della bilineare.
+    // In modo selettivo la catena resta alla frequenza base e solo le bande
+    // sopra soglia passano alla frequenza alta
+    const auto processingRate = oversampler.getProcessingRate(sampleRate);
+
+    filterChain.prepare(processingRate, samplesPerBlock * oversampler.getFactor());
+    filterChain.setSelectiveOversampling(oversampler.getSelectiveFactor());
+    filterChain.updateAllCoefficients(processingRate);
+    filterChain.reset();
+}
+
+void AudioPluginAudioProcessor::updateOversampling()
+{
+    if (!oversampler.setMode(getOversamplingOrder(), getOversamplingFilter(), getOversamplingScope()))
+        return;
+
+    // Nuova frequenza di lavoro: catena riprogettata (gli stadi sono già
+    // allocati) e kernel della fase lineare ricalcolato dalla nuova risposta
+    prepareFilterChain(juce::jmax(1.0, getSampleRate()), juce::jmax(1, getBlockSize()));
+    linearPhaseKernelDirty = true;
+}
+
+void AudioPluginAudioProcessor::updateDesignMethod()
+{
+    const auto method = static_cast<int>(parameterTable.getValue(GlobalParameter::filterDesign)) == 1
+        ? BiquadDesign::Method::matched
+        : BiquadDesign::Method::bilinear;
+
+    if (method == filterChain.getDesignMethod())
+        return;
+
+    // Tutte le bande riprogettate subito; la fase lineare segue la nuova risposta
+    filterChain.setDesignMethod(method);
+    linearPhaseKernelDirty = true;
+}
+
+void AudioPluginAudioProcessor::updateCutResponse()
+{
+    const auto response = static_cast<BiquadDesign::CutResponse>(
+        juce::jlimit(0, 2, static_cast<int>(parameterTable.getValue(GlobalParameter::cutResponse))));
+
+    if (response == filterChain.getCutResponse())
+        return;
+
+    filterChain.setCutResponse(response);
+    linearPhaseKernelDirty = true;
+}
+
+void AudioPluginAudioProcessor::updateFilterTopology()
+{
+    // Stessi coefficienti in entrambe le topologie: la risposta non cambia
+    filterChain.setTopology(static_cast<int>(parameterTable.getValue(GlobalParameter::filterTopology)) == 1
+                                ? FilterChain::Topology::svf
+                                : FilterChain::Topology::biquad);
+}
+
 void AudioPluginAudioProcessor::releaseResources()
 {
     filterChain.reset();
@@ -167,8 +285,7 @@ void AudioPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     auto mainInput = getBusBuffer(buffer, true, 0);
     juce::AudioBuffer<float> emptySidechain;
     auto sidechainInput = (getBusCount(true) > 1) ? getBusBuffer(buffer, true, 1) : emptySidechain;
-    const auto* sidechainEnabledParam = apvts.getRawParameterValue("sidechain_enabled");
-    const bool sidechainEnabled = (sidechainEnabledParam != nullptr && sidechainEnabledParam->load() > 0.5f);
+    const bool sidechainEnabled = parameterTable.getValue(GlobalParameter::sidechainEnabled) > 0.5f;
     sidechainEnabledForUI.store(sidechainEnabled);
 
     // Cattura audio per spectrum analyzer (solo canale sinistro)
@@ -180,10 +297,35 @@ void AudioPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         pushToFifo(sidechainAudioFifo, sidechainAudioFifoBuffer, sidechainInput.getReadPointer(0), numSamples);
 
     // Aggiorna i parametri dei filtri
+    updateOversampling();
+    updateDesignMethod();
+    updateCutResponse();
+    updateFilterTopology();
     updateDynamicGain(sidechainInput, mainInput);
     updateFiltersFromParameters();
     updatePhaseModeAndLatency();
 
+    switch (static_cast<int>(parameterTable.getValue(GlobalParameter::engineMode)))
+    {
+        case 1: filterChain.setExecutionMode(FilterChain::ExecutionMode::parallel); break;
+        case 2: filterChain.setExecutionMode(FilterChain::ExecutionMode::fused); break;
+        default: filterChain.setExecutionMode(FilterChain::ExecutionMode::cascade); break;
+    }
+
+    switch (static_cast<int>(parameterTable.getValue(GlobalParameter::saturationPlacement)))
+    {
+        case 1: filterChain.setSaturationPlacement(FilterChain::SaturationPlacement::chainOutput); break;
+        case 2: filterChain.setSaturationPlacement(FilterChain::SaturationPlacement::gainBands); break;
+        default: filterChain.setSaturationPlacement(FilterChain::SaturationPlacement::everyBand); break;
+    }
+
+    switch (static_cast<int>(parameterTable.getValue(GlobalParameter::saturationAntialiasing)))
+    {
+        case 1: filterChain.setSaturationAntialiasing(AnalogSaturation::Antialiasing::firstOrder); break;
+        case 2: filterChain.setSaturationAntialiasing(AnalogSaturation::Antialiasing::secondOrder); break;
+        default: filterChain.setSaturationAntialiasing(AnalogSaturation::Antialiasing::none); break;
+    }
+
     dryBuffer.makeCopyOf(buffer, true);
 
     // Calculate input RMS for gain matching
@@ -199,17 +341,19 @@ void AudioPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     }
     else
     {
-        // Minimum/Natural phase use IIR chain directly.
-        filterChain.processBlock(buffer);
+        // Minimum/Natural phase use IIR chain directly (oversampled if enabled).
+        oversampler.process(buffer, filterChain);
         processPhaseModel(buffer, dryBuffer);
     }
 
+    // Coefficienti per la curva dell'editor (nessuna lettura diretta della catena)
+    filterChain.publishResponseSnapshot();
+
     // Calculate output RMS after filtering
     outputRMS = calculateRMS(buffer);
 
     // Apply auto-gain (gain matching)
-    auto autoGainParam = apvts.getRawParameterValue("auto_gain");
-    if (autoGainParam && autoGainParam->load() > 0.5f)
+    if (parameterTable.getValue(GlobalParameter::autoGain) > 0.5f)
     {
         // Avoid division by zero and extreme gains
         if (outputRMS > 0.0001f && inputRMS > 0.0001f)
@@ -225,12 +369,7 @@ void AudioPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     }
 
     // Applica output gain
-    auto outputGain = apvts.getRawParameterValue("output_gain");
-    if (outputGain != nullptr)
-    {
-        float gain = juce::Decibels::decibelsToGain(outputGain->load());
-        buffer.applyGain(gain);
-    }
+    buffer.applyGain(juce::Decibels::decibelsToGain(parameterTable.getValue(GlobalParameter::outputGain)));
     
     // Update meter level (calculate peak for meter display)
     float peak = buffer.getMagnitude(0, numSamples);
@@ -291,164 +430,114 @@ void AudioPluginAudioProcessor::setStateInformation(const void* data, int sizeIn
 //==============================================================================
 void AudioPluginAudioProcessor::updateFiltersFromParameters()
 {
-    bool filterStateChanged = false;
+    // Coefficienti progettati in background, tranne nel rendering offline
+    // (risultato deterministico) e in fase lineare, dove il kernel FIR viene
+    // ricostruito subito dalla catena
+    filterChain.setAsyncDesign(!isNonRealtime() && currentPhaseMode != PhaseMode::linear);
 
-    auto hasChanged = [](float previous, float current)
-    {
-        return std::isnan(previous) || std::abs(previous - current) > 0.0001f;
-    };
+    // Rampe di coefficienti sulle modifiche dei parametri; in fase lineare il
+    // kernel FIR viene ricostruito comunque dai coefficienti finali
+    filterChain.setCoefficientSmoothing(parameterTable.getValue(GlobalParameter::coefficientSmoothing) > 0.5f
+                                        && currentPhaseMode != PhaseMode::linear);
+
+    // In fase lineare la catena IIR non viene processata: i cambi programmati
+    // non avanzerebbero, quindi vengono consolidati subito
+    if (currentPhaseMode == PhaseMode::linear)
+        filterChain.finishFilterChanges();
+
+    // Bande modificate dai listener APVTS dall'ultimo blocco, più quelle il
+    // cui offset dinamico si è spostato e quelle rimandate per un cambio in
+    // corso: le altre non vengono toccate
+    const auto parameterDirty = dirtyBands.exchange(0, std::memory_order_acquire);
+    const auto previouslyDeferred = deferredBands;
+    const auto dirty = parameterDirty | dynamicDirtyBands | previouslyDeferred;
+    dynamicDirtyBands = 0;
+    deferredBands = 0;
+
+    if (dirty == 0)
+        return;
+
+    bool deferredApplied = false;
 
     for (int i = 0; i < maxNumFilters; ++i)
     {
-        juce::String prefix = "filter" + juce::String(i) + "_";
-        
-        auto* filter = filterInstances[i];
-        if (!filter)
+        if ((dirty & (1u << i)) == 0)
             continue;
-        
-        // Aggiorna enabled
-        auto enabledParam = apvts.getRawParameterValue(prefix + "enabled");
-        if (enabledParam)
+
+        const auto index = static_cast<size_t>(i);
+
+        // Durante un cambio di tipo/slope la banda resta quella corrente:
+        // i nuovi valori vengono applicati dopo il consolidamento
+        if (filterChain.isFilterChangePending(index))
         {
-            const auto enabledValue = enabledParam->load();
-            if (hasChanged(previousEnabled[i], enabledValue))
-            {
-                previousEnabled[i] = enabledValue;
-                filterStateChanged = true;
-            }
-            filter->setEnabled(enabledParam->load() > 0.5f);
+            deferredBands |= 1u << i;
+            continue;
         }
 
-        // Aggiorna tipo (ricrea il filtro solo se cambiato)
-        auto typeParam = apvts.getRawParameterValue(prefix + "type");
-        if (typeParam)
-        {
-            const auto typeValue = typeParam->load();
-            if (hasChanged(previousType[i], typeValue))
-            {
-                previousType[i] = typeValue;
-                filterStateChanged = true;
-            }
+        const auto* filter = filterChain.getFilter(index);
+        if (filter == nullptr)
+            continue;
 
-            FilterType newType = getFilterTypeFromChoice(static_cast<int>(typeValue));
+        const auto newType = getFilterTypeFromChoice(static_cast<int>(parameterTable.getValue(i, BandParameter::type)));
+        const auto newSlope = static_cast<int>(parameterTable.getValue(i, BandParameter::slope));
 
-            // Ricrea solo se il tipo è cambiato
-            if (newType != currentFilterTypes[i])
+        if (newType != currentFilterTypes[index] || newSlope != filter->getSlope())
+        {
+            // Cambio strutturale: la banda sostitutiva viene progettata in
+            // background e subentra con una dissolvenza
+            const BiquadDesign::BandParameters replacement {
+                newType,
+                parameterTable.getValue(i, BandParameter::freq),
+                parameterTable.getValue(i, BandParameter::gain) + dynamicCurrentOffset[index],
+                parameterTable.getValue(i, BandParameter::q),
+                newSlope
+            };
+
+            if (currentPhaseMode != PhaseMode::linear && filter->isEnabled())
             {
-                // Rimuovi tutti i filtri e ricreali
-                filterChain.removeAllFilters();
-
-                // Ricrea tutti i filtri con i tipi corretti
-                for (int j = 0; j < maxNumFilters; ++j)
-                {
-                    juce::String jPrefix = "filter" + juce::String(j) + "_";
-                    auto jTypeParam = apvts.getRawParameterValue(jPrefix + "type");
-                    FilterType jType = currentFilterTypes[j];
-
-                    if (jTypeParam)
-                        jType = getFilterTypeFromChoice(static_cast<int>(jTypeParam->load()));
-
-                    currentFilterTypes[j] = jType;
-                    filterInstances[j] = filterChain.addFilter(jType);
-
-                    // Ripristina parametri da APVTS per tutti i filtri
-                    auto jFreqParam = apvts.getRawParameterValue(jPrefix + "freq");
-                    auto jGainParam = apvts.getRawParameterValue(jPrefix + "gain");
-                    auto jQParam = apvts.getRawParameterValue(jPrefix + "q");
-                    auto jEnabledParam = apvts.getRawParameterValue(jPrefix + "enabled");
-                    auto jSlopeParam = apvts.getRawParameterValue(jPrefix + "slope");
-
-                    if (filterInstances[j])
-                    {
-                        if (jFreqParam) filterInstances[j]->setFrequency(jFreqParam->load());
-                        if (jGainParam)
-                        {
-                            const auto baseGain = jGainParam->load();
-                            dynamicBaseGain[j] = baseGain;
-                            filterInstances[j]->setGain(baseGain + dynamicCurrentOffset[j]);
-                        }
-                        if (jQParam) filterInstances[j]->setQ(jQParam->load());
-                        if (jSlopeParam) filterInstances[j]->setSlope(static_cast<int>(jSlopeParam->load()));
-                        if (jEnabledParam) filterInstances[j]->setEnabled(jEnabledParam->load() > 0.5f);
-                        filterInstances[j]->updateCoefficients(getSampleRate());
-
-                        if (jFreqParam) previousFreq[j] = jFreqParam->load();
-                        if (jGainParam) previousGain[j] = jGainParam->load();
-                        if (jQParam) previousQ[j] = jQParam->load();
-                        if (jSlopeParam) previousSlope[j] = jSlopeParam->load();
-                        if (jEnabledParam) previousEnabled[j] = jEnabledParam->load();
-                        if (jTypeParam) previousType[j] = jTypeParam->load();
-                    }
-                }
-
-                // Aggiorna il puntatore corrente e salta aggiornamento singolo
-                // (tutti i parametri sono già stati applicati nel loop sopra)
-                filter = filterInstances[i];
-                filterStateChanged = true;
+                if (filterChain.scheduleFilterChange(index, replacement))
+                    currentFilterTypes[index] = newType;
+
+                // Riapplica i parametri quando il cambio è consolidato (o riprova)
+                deferredBands |= 1u << i;
                 continue;
             }
-        }
-
-        // Leggi tutti i parametri prima di aggiornare i coefficienti (una sola volta)
-        auto freqParam = apvts.getRawParameterValue(prefix + "freq");
-        auto gainParam = apvts.getRawParameterValue(prefix + "gain");
-        auto qParam = apvts.getRawParameterValue(prefix + "q");
-        auto slopeParam = apvts.getRawParameterValue(prefix + "slope");
 
-        if (freqParam)
-        {
-            const auto value = freqParam->load();
-            if (hasChanged(previousFreq[i], value))
-            {
-                previousFreq[i] = value;
-                filterStateChanged = true;
-            }
-            filter->setFrequency(value);
-        }
-        if (gainParam)
-        {
-            const auto value = gainParam->load();
-            if (hasChanged(previousGain[i], value))
-            {
-                previousGain[i] = value;
-                filterStateChanged = true;
-            }
-            dynamicBaseGain[i] = value;
-            filter->setGain(value + dynamicCurrentOffset[i]);
-        }
-        if (qParam)
-        {
-            const auto value = qParam->load();
-            if (hasChanged(previousQ[i], value))
-            {
-                previousQ[i] = value;
-                filterStateChanged = true;
-            }
-            filter->setQ(value);
-        }
-        if (slopeParam)
-        {
-            const auto value = slopeParam->load();
-            if (hasChanged(previousSlope[i], value))
-            {
-                previousSlope[i] = value;
-                filterStateChanged = true;
-            }
-            filter->setSlope(static_cast<int>(value));
+            // Banda spenta o catena non processata: nessuna dissolvenza necessaria
+            filterChain.setFilterType(index, newType);
+            currentFilterTypes[index] = newType;
         }
 
-        filter->updateCoefficients(getSampleRate());
+        applyBandParameters(i);
+        deferredApplied |= (previouslyDeferred & (1u << i)) != 0;
     }
 
-    if (filterStateChanged)
+    if (parameterDirty != 0 || deferredApplied)
         linearPhaseKernelDirty = true;
 }
 
+void AudioPluginAudioProcessor::applyBandParameters(int band)
+{
+    const auto index = static_cast<size_t>(band);
+    auto* filter = filterChain.getFilter(index);
+    if (filter == nullptr)
+        return;
+
+    filter->setEnabled(parameterTable.getValue(band, BandParameter::enabled) > 0.5f);
+    filter->setFrequency(parameterTable.getValue(band, BandParameter::freq));
+    filter->setQ(parameterTable.getValue(band, BandParameter::q));
+    filter->setSlope(static_cast<int>(parameterTable.getValue(band, BandParameter::slope)));
+    dynamicBaseGain[index] = parameterTable.getValue(band, BandParameter::gain);
+
+    dynamicAppliedOffset[index] = dynamicCurrentOffset[index];
+    filter->setGain(dynamicBaseGain[index] + dynamicAppliedOffset[index]);
+    filterChain.updateFilterCoefficients(index);
+}
+
 void AudioPluginAudioProcessor::updateDynamicGain(const juce::AudioBuffer<float>& sidechainBuffer,
                                                   const juce::AudioBuffer<float>& inputBuffer)
 {
-    const auto* sidechainEnabledParam = apvts.getRawParameterValue("sidechain_enabled");
-    const bool sidechainEnabled = (sidechainEnabledParam != nullptr && sidechainEnabledParam->load() > 0.5f);
+    const bool sidechainEnabled = parameterTable.getValue(GlobalParameter::sidechainEnabled) > 0.5f;
 
     const juce::AudioBuffer<float>* detectorBuffer = &inputBuffer;
     if (sidechainEnabled && sidechainBuffer.getNumChannels() > 0 && sidechainBuffer.getNumSamples() > 0)
@@ -459,19 +548,24 @@ void AudioPluginAudioProcessor::updateDynamicGain(const juce::AudioBuffer<float>
     const int numSamples = juce::jmax(1, detectorBuffer->getNumSamples());
     constexpr float fallbackReleaseCoeff = 0.08f;
 
+    // Decadimenti e^(-N / tau) di attack e release di tutte le bande in un
+    // solo passaggio vettoriale, come 2^(-N log2(e) / tau)
+    constexpr float log2e = 1.44269504f;
+    std::array<float, 2 * maxNumFilters> envelopeDecays;
+
+    for (int i = 0; i < maxNumFilters; ++i)
+    {
+        const float attackMs = juce::jmax(1.0f, parameterTable.getValue(i, BandParameter::dynAttackMs));
+        const float releaseMs = juce::jmax(5.0f, parameterTable.getValue(i, BandParameter::dynReleaseMs));
+        envelopeDecays[static_cast<size_t>(2 * i)] = -static_cast<float>(numSamples) * log2e / (attackMs * 0.001f * sr);
+        envelopeDecays[static_cast<size_t>(2 * i + 1)] = -static_cast<float>(numSamples) * log2e / (releaseMs * 0.001f * sr);
+    }
+
+    KernelDispatch::getKernels().exp2(envelopeDecays.data(), envelopeDecays.data(), 2 * maxNumFilters);
+
     for (int i = 0; i < maxNumFilters; ++i)
     {
-        const juce::String prefix = "filter" + juce::String(i) + "_";
-        const auto* enabledParam = apvts.getRawParameterValue(prefix + "enabled");
-        const auto* thresholdParam = apvts.getRawParameterValue(prefix + "dyn_threshold");
-        const auto* dynGainParam = apvts.getRawParameterValue(prefix + "dyn_gain");
-        const auto* attackParam = apvts.getRawParameterValue(prefix + "dyn_attack_ms");
-        const auto* releaseParam = apvts.getRawParameterValue(prefix + "dyn_release_ms");
-        const auto* modeParam = apvts.getRawParameterValue(prefix + "dyn_mode");
-        const auto* detectorQParam = apvts.getRawParameterValue(prefix + "dyn_detector_q");
-
-        if (!enabledParam || !thresholdParam || !dynGainParam || !attackParam || !releaseParam || !modeParam || !detectorQParam
-            || enabledParam->load() < 0.5f)
+        if (parameterTable.getValue(i, BandParameter::enabled) < 0.5f)
         {
             auto& currentOffset = dynamicCurrentOffset[static_cast<size_t>(i)];
             const auto before = currentOffset;
@@ -481,7 +575,7 @@ void AudioPluginAudioProcessor::updateDynamicGain(const juce::AudioBuffer<float>
             continue;
         }
 
-        const float amountDb = juce::jmax(0.0f, dynGainParam->load());
+        const float amountDb = juce::jmax(0.0f, parameterTable.getValue(i, BandParameter::dynGain));
         if (amountDb <= 0.0001f)
         {
             auto& currentOffset = dynamicCurrentOffset[static_cast<size_t>(i)];
@@ -492,16 +586,15 @@ void AudioPluginAudioProcessor::updateDynamicGain(const juce::AudioBuffer<float>
             continue;
         }
 
-        const float thresholdDb = thresholdParam->load();
-        const auto* freqParam = apvts.getRawParameterValue(prefix + "freq");
-        const float freq = juce::jmax(20.0f, freqParam != nullptr ? freqParam->load() : 1000.0f);
-        const float detectorQ = juce::jmax(0.3f, detectorQParam->load());
+        const float thresholdDb = parameterTable.getValue(i, BandParameter::dynThreshold);
+        const float freq = juce::jmax(20.0f, parameterTable.getValue(i, BandParameter::freq));
+        const float detectorQ = juce::jmax(0.3f, parameterTable.getValue(i, BandParameter::dynDetectorQ));
         const float detectorDb = calculateBandLevelDb(*detectorBuffer, freq, detectorQ);
         const float overDb = juce::jmax(0.0f, detectorDb - thresholdDb);
         const float overNorm = juce::jlimit(0.0f, 1.0f, overDb / 24.0f);
         const float baseGain = dynamicBaseGain[static_cast<size_t>(i)];
 
-        const int mode = static_cast<int>(modeParam->load());
+        const int mode = static_cast<int>(parameterTable.getValue(i, BandParameter::dynMode));
         float direction = (baseGain >= 0.0f) ? -1.0f : 1.0f; // Auto
         if (mode == 1)
             direction = -1.0f; // Cut
@@ -511,10 +604,8 @@ void AudioPluginAudioProcessor::updateDynamicGain(const juce::AudioBuffer<float>
         const float targetOffset = direction * amountDb * overNorm;
         float& currentOffset = dynamicCurrentOffset[static_cast<size_t>(i)];
 
-        const float attackMs = juce::jmax(1.0f, attackParam->load());
-        const float releaseMs = juce::jmax(5.0f, releaseParam->load());
-        const float attackCoeff = 1.0f - std::exp(-static_cast<float>(numSamples) / (attackMs * 0.001f * sr));
-        const float releaseCoeff = 1.0f - std::exp(-static_cast<float>(numSamples) / (releaseMs * 0.001f * sr));
+        const float attackCoeff = 1.0f - envelopeDecays[static_cast<size_t>(2 * i)];
+        const float releaseCoeff = 1.0f - envelopeDecays[static_cast<size_t>(2 * i + 1)];
         const float coeff = (std::abs(targetOffset) > std::abs(currentOffset)) ? attackCoeff : releaseCoeff;
         const auto before = currentOffset;
         currentOffset += coeff * (targetOffset - currentOffset);
@@ -522,6 +613,11 @@ void AudioPluginAudioProcessor::updateDynamicGain(const juce::AudioBuffer<float>
             dynamicOffsetChanged = true;
     }
 
+    // Riprogetta solo le bande il cui offset si è spostato rispetto all'ultima progettazione
+    for (int i = 0; i < maxNumFilters; ++i)
+        if (std::abs(dynamicCurrentOffset[static_cast<size_t>(i)] - dynamicAppliedOffset[static_cast<size_t>(i)]) > dynamicOffsetToleranceDb)
+            dynamicDirtyBands |= 1u << i;
+
     if (currentPhaseMode == PhaseMode::linear && dynamicOffsetChanged)
         linearPhaseKernelDirty = true;
 }
@@ -539,33 +635,37 @@ float AudioPluginAudioProcessor::calculateBandLevelDb(const juce::AudioBuffer<fl
     const float kFloat = (static_cast<float>(numSamples) * clampedFreq) / sr;
     const int centerBin = juce::jlimit(1, numSamples / 2 - 2, static_cast<int>(std::round(kFloat)));
 
-    const int halfWidth = juce::jlimit(1, 8, static_cast<int>(std::ceil(4.0f / juce::jmax(0.3f, detectorQ))));
-    float weightedPower = 0.0f;
-    float weightSum = 0.0f;
+    constexpr int maxHalfWidth = 8;
+    const int halfWidth = juce::jlimit(1, maxHalfWidth, static_cast<int>(std::ceil(4.0f / juce::jmax(0.3f, detectorQ))));
+    const int numBins = 2 * halfWidth + 1;
+    const auto& kernels = KernelDispatch::getKernels();
 
-    const int channelCount = juce::jmin(2, buffer.getNumChannels());
-    std::vector<float> mono(static_cast<size_t>(numSamples), 0.0f);
-    for (int ch = 0; ch < channelCount; ++ch)
+    // Coefficienti di Goertzel di tutti i bin in un solo passaggio vettoriale
+    std::array<float, 2 * maxHalfWidth + 1> omegas, sines, cosines;
+    for (int offset = -halfWidth; offset <= halfWidth; ++offset)
     {
-        const float* read = buffer.getReadPointer(ch);
-        for (int i = 0; i < numSamples; ++i)
-            mono[static_cast<size_t>(i)] += read[i];
+        const int k = juce::jlimit(1, numSamples / 2 - 2, centerBin + offset);
+        omegas[static_cast<size_t>(offset + halfWidth)] = juce::MathConstants<float>::twoPi * static_cast<float>(k)
+                                                        / static_cast<float>(numSamples);
     }
 
-    const float invChannels = 1.0f / static_cast<float>(channelCount);
-    for (auto& sample : mono)
-        sample *= invChannels;
+    kernels.sinCos(omegas.data(), sines.data(), cosines.data(), numBins);
+
+    float weightedPower = 0.0f;
+    float weightSum = 0.0f;
+
+    // Somma mono calcolata nel ciclo di Goertzel (nessun buffer temporaneo)
+    const float* left = buffer.getReadPointer(0);
+    const float* right = buffer.getReadPointer(juce::jmin(1, buffer.getNumChannels() - 1));
 
     for (int offset = -halfWidth; offset <= halfWidth; ++offset)
     {
-        const int k = juce::jlimit(1, numSamples / 2 - 2, centerBin + offset);
-        const float omega = juce::MathConstants<float>::twoPi * static_cast<float>(k) / static_cast<float>(numSamples);
-        const float coeff = 2.0f * std::cos(omega);
+        const float coeff = 2.0f * cosines[static_cast<size_t>(offset + halfWidth)];
 
         float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f;
         for (int n = 0; n < numSamples; ++n)
         {
-            s0 = mono[static_cast<size_t>(n)] + coeff * s1 - s2;
+            s0 = 0.5f * (left[n] + right[n]) + coeff * s1 - s2;
             s2 = s1;
             s1 = s0;
         }
@@ -579,8 +679,7 @@ float AudioPluginAudioProcessor::calculateBandLevelDb(const juce::AudioBuffer<fl
     const float avgPower = (weightSum > 0.0f) ? (weightedPower / weightSum) : 0.0f;
     const float normalized = avgPower / static_cast<float>(numSamples * numSamples);
     const float magnitude = std::sqrt(juce::jmax(1.0e-12f, normalized));
-    const float db = 20.0f * std::log10(magnitude + 1.0e-12f);
-    return juce::jlimit(-60.0f, 12.0f, db);
+    return juce::jlimit(-60.0f, 12.0f, juce::Decibels::gainToDecibels(magnitude, -60.0f));
 }
 
 void AudioPluginAudioProcessor::pushToFifo(juce::AbstractFifo& fifo,
@@ -613,8 +712,7 @@ void AudioPluginAudioProcessor::pushToFifo(juce::AbstractFifo& fifo,
 
 void AudioPluginAudioProcessor::updatePhaseModeAndLatency()
 {
-    auto* phaseParam = apvts.getRawParameterValue("phase_mode");
-    const int modeValue = phaseParam != nullptr ? static_cast<int>(phaseParam->load()) : 0;
+    const int modeValue = static_cast<int>(parameterTable.getValue(GlobalParameter::phaseMode));
 
     switch (modeValue)
     {
@@ -624,8 +722,7 @@ void AudioPluginAudioProcessor::updatePhaseModeAndLatency()
     }
     currentPhaseModeForUI.store(modeValue);
 
-    auto* qualityParam = apvts.getRawParameterValue("linear_phase_quality");
-    const int qualityValue = qualityParam != nullptr ? static_cast<int>(qualityParam->load()) : 1;
+    const int qualityValue = static_cast<int>(parameterTable.getValue(GlobalParameter::linearPhaseQuality));
 
     switch (qualityValue)
     {
@@ -648,18 +745,21 @@ void AudioPluginAudioProcessor::updatePhaseModeAndLatency()
     }
     currentLinearPhaseQualityForUI.store(qualityValue);
 
-    if (linearPhaseKernel.size() != static_cast<size_t>(currentLinearPhaseKernelSize))
+    if (linearPhaseKernelSize != currentLinearPhaseKernelSize)
     {
-        linearPhaseKernel.assign(static_cast<size_t>(currentLinearPhaseKernelSize), 0.0f);
+        linearPhaseKernelSize = currentLinearPhaseKernelSize;
+        std::fill(linearPhaseKernel.begin(), linearPhaseKernel.end(), 0.0f);
         for (auto& history : linearPhaseHistory)
-            history.assign(static_cast<size_t>(currentLinearPhaseKernelSize), 0.0f);
+            std::fill(history.begin(), history.end(), 0.0f);
         linearPhaseWritePos = 0;
         linearPhaseKernelDirty = true;
     }
 
-    int requestedLatency = 0;
+    // La fase lineare non passa dalla catena IIR né dal sovracampionamento;
+    // in fase naturale il ritardo del wet assorbe quello degli stadi
+    int requestedLatency = oversampler.getLatencySamples();
     if (currentPhaseMode == PhaseMode::natural)
-        requestedLatency = naturalPhaseLatencySamples;
+        requestedLatency = juce::jmax(naturalPhaseLatencySamples, requestedLatency);
     else if (currentPhaseMode == PhaseMode::linear)
         requestedLatency = currentLinearPhaseLatencySamples;
 
@@ -678,52 +778,66 @@ void AudioPluginAudioProcessor::rebuildLinearPhaseKernel()
     const int fftSize = 1 << linearPhaseFFTOrder;
     const int maxBin = fftSize / 2;
 
-    juce::dsp::FFT fft(linearPhaseFFTOrder);
-    std::vector<float> ifftBuffer(static_cast<size_t>(2 * fftSize), 0.0f);
+    auto* ifftBuffer = linearPhaseFFTBuffer.data();
+    auto* magnitudes = linearPhaseMagnitudes.data();
+    const auto& kernels = KernelDispatch::getKernels();
 
     for (int bin = 0; bin <= maxBin; ++bin)
     {
         const float frequency = juce::jmax(1.0f, static_cast<float>(sampleRate * static_cast<double>(bin) / static_cast<double>(fftSize)));
-        const float responseDb = filterChain.getTotalFrequencyResponse(frequency);
-        const float magnitude = juce::jlimit(0.0001f, 16.0f, juce::Decibels::decibelsToGain(responseDb));
+        magnitudes[bin] = filterChain.getTotalFrequencyResponse(frequency);
+    }
+
+    kernels.decibelsToGains(magnitudes, magnitudes, maxBin + 1);
+
+    std::fill(linearPhaseFFTBuffer.begin(), linearPhaseFFTBuffer.end(), 0.0f);
+    for (int bin = 0; bin <= maxBin; ++bin)
+    {
+        const float magnitude = juce::jlimit(0.0001f, 16.0f, magnitudes[bin]);
 
-        ifftBuffer[static_cast<size_t>(2 * bin)] = magnitude;
-        ifftBuffer[static_cast<size_t>(2 * bin + 1)] = 0.0f;
+        ifftBuffer[2 * bin] = magnitude;
 
         if (bin > 0 && bin < maxBin)
-        {
-            const int mirrored = fftSize - bin;
-            ifftBuffer[static_cast<size_t>(2 * mirrored)] = magnitude;
-            ifftBuffer[static_cast<size_t>(2 * mirrored + 1)] = 0.0f;
-        }
+            ifftBuffer[2 * (fftSize - bin)] = magnitude;
     }
 
-    fft.performRealOnlyInverseTransform(ifftBuffer.data());
+    linearPhaseFFT.performRealOnlyInverseTransform(ifftBuffer);
 
-    const int kernelSize = currentLinearPhaseKernelSize;
+    const int kernelSize = linearPhaseKernelSize;
     const int delay = currentLinearPhaseLatencySamples;
     const float denom = static_cast<float>(juce::jmax(1, kernelSize - 1));
 
+    // Finestra di Blackman: cos(2 theta) = 2 cos^2(theta) - 1
+    auto* phases = linearPhaseWindowPhases.data();
+    auto* cosines = linearPhaseWindowCosines.data();
+    for (int n = 0; n < kernelSize; ++n)
+        phases[n] = juce::MathConstants<float>::twoPi * static_cast<float>(n) / denom;
+
+    kernels.sinCos(phases, linearPhaseWindowSines.data(), cosines, kernelSize);
+
+    auto* taps = linearPhaseKernel.data();
     for (int n = 0; n < kernelSize; ++n)
     {
         const int shiftedIndex = (n - delay + fftSize) % fftSize;
-        const float x = static_cast<float>(n) / denom;
-        const float window = 0.42f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * x)
-                           + 0.08f * std::cos(2.0f * juce::MathConstants<float>::twoPi * x);
-        linearPhaseKernel[static_cast<size_t>(n)] = ifftBuffer[static_cast<size_t>(shiftedIndex)] * window;
+        const float c = cosines[n];
+        const float window = 0.42f - 0.5f * c + 0.08f * (2.0f * c * c - 1.0f);
+        taps[n] = ifftBuffer[shiftedIndex] * window;
     }
 
     float dcGain = 0.0f;
-    for (const auto tap : linearPhaseKernel)
-        dcGain += tap;
+    for (int n = 0; n < kernelSize; ++n)
+        dcGain += taps[n];
 
     if (std::abs(dcGain) > 1.0e-6f)
     {
         const float norm = 1.0f / dcGain;
-        for (auto& tap : linearPhaseKernel)
-            tap *= norm;
+        for (int n = 0; n < kernelSize; ++n)
+            taps[n] *= norm;
     }
 
+    // Il FIR è un prodotto scalare con la storia dal campione più vecchio
+    std::reverse(taps, taps + kernelSize);
+
     for (auto& history : linearPhaseHistory)
         std::fill(history.begin(), history.end(), 0.0f);
     linearPhaseWritePos = 0;
@@ -737,10 +851,12 @@ void AudioPluginAudioProcessor::processLinearPhaseModel(juce::AudioBuffer<float>
         return;
 
     const int numChannels = juce::jmin(2, wetBuffer.getNumChannels());
-    const int kernelSize = static_cast<int>(linearPhaseKernel.size());
+    const int kernelSize = linearPhaseKernelSize;
     if (kernelSize <= 0)
         return;
 
+    const auto dotProduct = KernelDispatch::getKernels().dotProduct;
+    const float* taps = linearPhaseKernel.data();
     int writePos = linearPhaseWritePos;
 
     for (int sample = 0; sample < numSamples; ++sample)
@@ -748,19 +864,14 @@ void AudioPluginAudioProcessor::processLinearPhaseModel(juce::AudioBuffer<float>
         for (int ch = 0; ch < numChannels; ++ch)
         {
             auto* data = wetBuffer.getWritePointer(ch);
-            auto& history = linearPhaseHistory[static_cast<size_t>(ch)];
-
-            history[static_cast<size_t>(writePos)] = data[sample];
+            auto* history = linearPhaseHistory[static_cast<size_t>(ch)].data();
 
-            float y = 0.0f;
-            int tapIndex = writePos;
-            for (int tap = 0; tap < kernelSize; ++tap)
-            {
-                y += linearPhaseKernel[static_cast<size_t>(tap)] * history[static_cast<size_t>(tapIndex)];
-                tapIndex = (tapIndex == 0) ? (kernelSize - 1) : (tapIndex - 1);
-            }
+            // Storia scritta due volte (writePos e writePos + kernelSize): gli
+            // ultimi kernelSize campioni sono sempre contigui
+            history[writePos] = data[sample];
+            history[writePos + kernelSize] = data[sample];
 
-            data[sample] = y;
+            data[sample] = dotProduct(taps, history + writePos + 1, kernelSize);
         }
 
         writePos = (writePos + 1) % kernelSize;
@@ -780,7 +891,8 @@ void AudioPluginAudioProcessor::processPhaseModel(juce::AudioBuffer<float>& wetB
 
     const int numChannels = juce::jmin(2, wetBuffer.getNumChannels());
     const int numSamples = wetBuffer.getNumSamples();
-    const int delay = currentPhaseLatencySamples;
+    // Il wet arriva già in ritardo della latenza del sovracampionamento
+    const int delay = juce::jmax(0, currentPhaseLatencySamples - oversampler.getLatencySamples());
 
     for (int ch = 0; ch < numChannels; ++ch)
     {
@@ -792,10 +904,10 @@ void AudioPluginAudioProcessor::processPhaseModel(juce::AudioBuffer<float>& wetB
         for (int i = 0; i < numSamples; ++i)
         {
             const int readPos = (writePos - delay + maxNaturalPhaseDelaySamples) % maxNaturalPhaseDelaySamples;
-            const float delayedWet = delayLine[static_cast<size_t>(readPos)];
-
             delayLine[static_cast<size_t>(writePos)] = wet[i];
 
+            const float delayedWet = delayLine[static_cast<size_t>(readPos)];
+
             wet[i] = delayedWet * 0.8f + dry[i] * 0.2f;
 
             writePos = (writePos + 1) % maxNaturalPhaseDelaySamples;
@@ -821,6 +933,7 @@ FilterType AudioPluginAudioProcessor::getFilterTypeFromChoice(int choice)
 
 float AudioPluginAudioProcessor::calculateRMS(const juce::AudioBuffer<float>& buffer)
 {
+    const auto sumOfSquares = KernelDispatch::getKernels().sumOfSquares;
     float sumSquares = 0.0f;
     int totalSamples = 0;
     
@@ -829,11 +942,7 @@ float AudioPluginAudioProcessor::calculateRMS(const juce::AudioBuffer<float>& bu
         const float* channelData = buffer.getReadPointer(channel);
         int numSamples = buffer.getNumSamples();
         
-        for (int i = 0; i < numSamples; ++i)
-        {
-            float sample = channelData[i];
-            sumSquares += sample * sample;
-        }
+        sumSquares += sumOfSquares(channelData, numSamples);
         
         totalSamples += numSamples;
     }
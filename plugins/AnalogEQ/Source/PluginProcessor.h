@@ -2,9 +2,12 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <array>
-#include <limits>
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include "DSP/FilterChain.h"
+#include "DSP/ChainOversampler.h"
+#include "Utils/ParameterHelper.h"
 
 //==============================================================================
 /**
@@ -55,6 +58,9 @@ public:
     
     // Accesso all'APVTS
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
+
+    // Tabella dei parametri per banda/campo (nessuna ricerca per stringa)
+    const ParameterHelper::ParameterTable& getParameterTable() const { return parameterTable; }
     
     // Spectrum analyzer audio data access
     juce::AbstractFifo& getAudioFifo() { return audioFifo; }
@@ -73,11 +79,36 @@ public:
 private:
     //==============================================================================
     FilterChain filterChain;
+    ChainOversampler oversampler; // Attorno a filterChain, fattore dal parametro oversampling
     juce::AudioProcessorValueTreeState apvts;
-    
-    static constexpr int maxNumFilters = 8;
-    std::array<FilterBase*, maxNumFilters> filterInstances;
+
+    static constexpr int maxNumFilters = ParameterHelper::maxBands;
+    ParameterHelper::ParameterTable parameterTable;
+
     std::array<FilterType, maxNumFilters> currentFilterTypes; // Track current types to avoid unnecessary recreation
+
+    /**
+     * Listener APVTS di una banda: a ogni modifica di un suo parametro
+     * (dal thread dell'host o della UI) imposta il bit della banda in
+     * dirtyBands. Il thread audio riprogetta solo le bande marcate.
+     */
+    struct BandChangeListener : public juce::AudioProcessorValueTreeState::Listener
+    {
+        std::atomic<uint32_t>* dirtyBands = nullptr;
+        uint32_t bandBit = 0;
+
+        void parameterChanged(const juce::String&, float) override
+        {
+            dirtyBands->fetch_or(bandBit, std::memory_order_release);
+        }
+    };
+
+    static constexpr uint32_t allBandsMask = (1u << maxNumFilters) - 1u;
+
+    std::array<BandChangeListener, maxNumFilters> bandChangeListeners;
+    std::atomic<uint32_t> dirtyBands { allBandsMask };
+    uint32_t dynamicDirtyBands = 0; // Solo thread audio
+    uint32_t deferredBands = 0;     // Bande con un cambio di tipo/slope in corso (solo thread audio)
     
     // Spectrum analyzer audio capture
     static constexpr int audioFifoSize = 8192; // Must be power of 2
@@ -116,28 +147,45 @@ private:
 
     static constexpr int maxLinearPhaseKernelSize = 2049;
     static constexpr int linearPhaseFFTOrder = 12; // 4096-point design FFT
-    std::vector<float> linearPhaseKernel;
-    std::array<std::vector<float>, 2> linearPhaseHistory;
+    std::vector<float> linearPhaseKernel;                  // Tap in ordine inverso, i primi linearPhaseKernelSize attivi
+    std::array<std::vector<float>, 2> linearPhaseHistory; // 2 * kernelSize, scritta due volte
+    int linearPhaseKernelSize = 0;
     int linearPhaseWritePos = 0;
+
+    // Buffer della progettazione del kernel, dimensionati nel costruttore:
+    // la ricostruzione sul thread audio non alloca
+    juce::dsp::FFT linearPhaseFFT { linearPhaseFFTOrder };
+    std::vector<float> linearPhaseFFTBuffer;   // 2 * fftSize
+    std::vector<float> linearPhaseMagnitudes;  // fftSize / 2 + 1
+    std::vector<float> linearPhaseWindowPhases; // maxLinearPhaseKernelSize
+    std::vector<float> linearPhaseWindowSines;
+    std::vector<float> linearPhaseWindowCosines;
     bool linearPhaseKernelDirty = true;
     int currentLinearPhaseKernelSize = 1025;
     int currentLinearPhaseLatencySamples = (1025 - 1) / 2;
     LinearPhaseQuality currentLinearPhaseQuality = LinearPhaseQuality::mid;
 
-    std::array<float, maxNumFilters> previousFreq;
-    std::array<float, maxNumFilters> previousGain;
-    std::array<float, maxNumFilters> previousQ;
-    std::array<float, maxNumFilters> previousSlope;
-    std::array<float, maxNumFilters> previousEnabled;
-    std::array<float, maxNumFilters> previousType;
     std::array<float, maxNumFilters> dynamicBaseGain;
     std::array<float, maxNumFilters> dynamicCurrentOffset;
+    std::array<float, maxNumFilters> dynamicAppliedOffset; // Offset usato nell'ultima progettazione
+
+    // Variazione dell'offset dinamico sotto cui la banda non viene riprogettata
+    static constexpr float dynamicOffsetToleranceDb = 0.001f;
 
     int currentPhaseLatencySamples = 0;
     PhaseMode currentPhaseMode = PhaseMode::minimum;
     juce::AudioBuffer<float> dryBuffer;
 
+    int getOversamplingOrder() const;
+    ChainOversampler::Filter getOversamplingFilter() const;
+    ChainOversampler::Scope getOversamplingScope() const;
+    void prepareFilterChain(double sampleRate, int samplesPerBlock);
+    void updateOversampling();
+    void updateDesignMethod();
+    void updateCutResponse();
+    void updateFilterTopology();
     void updateFiltersFromParameters();
+    void applyBandParameters(int band);
     void updateDynamicGain(const juce::AudioBuffer<float>& sidechainBuffer, const juce::AudioBuffer<float>& inputBuffer);
     void pushToFifo(juce::AbstractFifo& fifo, std::array<float, audioFifoSize>& fifoBuffer, const float* samples, int numSamples);
     float calculateBandLevelDb(const juce::AudioBuffer<float>& buffer, float centerFrequency, float detectorQ) const;
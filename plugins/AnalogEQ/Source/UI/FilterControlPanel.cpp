@@ -1,9 +1,10 @@
 #include "FilterControlPanel.h"
 #include <ai_ui/ModernLookAndFeel.h>
-#include "../Utils/ParameterHelper.h"
 
-FilterControlPanel::FilterControlPanel(juce::AudioProcessorValueTreeState& apvts)
-    : apvtsRef(apvts)
+using ParameterHelper::BandParameter;
+
+FilterControlPanel::FilterControlPanel(const ParameterHelper::ParameterTable& parameterTable)
+    : parameters(parameterTable)
 {
     // Freq knob
     freqKnob = std::make_unique<juce::Slider>();
@@ -140,9 +141,7 @@ FilterControlPanel::FilterControlPanel(juce::AudioProcessorValueTreeState& apvts
     removeButton->onClick = [this]() {
         if (selectedFilterIndex >= 0)
         {
-            juce::String prefix = "filter" + juce::String(selectedFilterIndex) + "_";
-            if (auto* param = apvtsRef.getParameter(prefix + "enabled"))
-                param->setValueNotifyingHost(0.0f);
+            parameters.setValueNotifyingHost(selectedFilterIndex, BandParameter::enabled, 0.0f);
             setSelectedFilter(-1);
             if (onFilterRemoved)
                 onFilterRemoved();
@@ -155,13 +154,9 @@ FilterControlPanel::FilterControlPanel(juce::AudioProcessorValueTreeState& apvts
     resetButton->onClick = [this]() {
         if (selectedFilterIndex >= 0)
         {
-            juce::String prefix = "filter" + juce::String(selectedFilterIndex) + "_";
-            if (auto* param = apvtsRef.getParameter(prefix + "freq"))
-                param->setValueNotifyingHost(param->convertTo0to1(1000.0f));
-            if (auto* param = apvtsRef.getParameter(prefix + "gain"))
-                param->setValueNotifyingHost(param->convertTo0to1(0.0f));
-            if (auto* param = apvtsRef.getParameter(prefix + "q"))
-                param->setValueNotifyingHost(param->convertTo0to1(0.707f));
+            parameters.setValueNotifyingHost(selectedFilterIndex, BandParameter::freq, 1000.0f);
+            parameters.setValueNotifyingHost(selectedFilterIndex, BandParameter::gain, 0.0f);
+            parameters.setValueNotifyingHost(selectedFilterIndex, BandParameter::q, 0.707f);
         }
     };
     addAndMakeVisible(resetButton.get());
@@ -382,40 +377,43 @@ void FilterControlPanel::recreateAttachments()
     dynReleaseAttachment.reset();
     dynModeAttachment.reset();
 
-    juce::String prefix = "filter" + juce::String(selectedFilterIndex) + "_";
+    auto parameter = [this](BandParameter field) -> juce::RangedAudioParameter&
+    {
+        return parameters.getParameter(selectedFilterIndex, field);
+    };
 
     freqAttachment = std::make_unique<SliderAttachment>(
-        apvtsRef, prefix + "freq", *freqKnob);
+        parameter(BandParameter::freq), *freqKnob);
 
     gainAttachment = std::make_unique<SliderAttachment>(
-        apvtsRef, prefix + "gain", *gainKnob);
+        parameter(BandParameter::gain), *gainKnob);
 
     qAttachment = std::make_unique<SliderAttachment>(
-        apvtsRef, prefix + "q", *qKnob);
+        parameter(BandParameter::q), *qKnob);
 
     panAttachment = std::make_unique<SliderAttachment>(
-        apvtsRef, prefix + "pan", *panKnob);
+        parameter(BandParameter::pan), *panKnob);
 
     dynThresholdAttachment = std::make_unique<SliderAttachment>(
-        apvtsRef, prefix + "dyn_threshold", *dynThresholdKnob);
+        parameter(BandParameter::dynThreshold), *dynThresholdKnob);
 
     dynGainAttachment = std::make_unique<SliderAttachment>(
-        apvtsRef, prefix + "dyn_gain", *dynGainKnob);
+        parameter(BandParameter::dynGain), *dynGainKnob);
 
     dynAttackAttachment = std::make_unique<SliderAttachment>(
-        apvtsRef, prefix + "dyn_attack_ms", *dynAttackKnob);
+        parameter(BandParameter::dynAttackMs), *dynAttackKnob);
 
     dynReleaseAttachment = std::make_unique<SliderAttachment>(
-        apvtsRef, prefix + "dyn_release_ms", *dynReleaseKnob);
+        parameter(BandParameter::dynReleaseMs), *dynReleaseKnob);
 
     dynModeAttachment = std::make_unique<ComboAttachment>(
-        apvtsRef, prefix + "dyn_mode", *dynModeSelector);
+        parameter(BandParameter::dynMode), *dynModeSelector);
 
     slopeAttachment = std::make_unique<ComboAttachment>(
-        apvtsRef, prefix + "slope", *slopeSelector);
+        parameter(BandParameter::slope), *slopeSelector);
 
     typeAttachment = std::make_unique<ComboAttachment>(
-        apvtsRef, prefix + "type", *typeSelector);
+        parameter(BandParameter::type), *typeSelector);
 }
 
 void FilterControlPanel::updateSlopeAvailability()
@@ -425,15 +423,9 @@ void FilterControlPanel::updateSlopeAvailability()
     // Disable gain for LowPass (0) and HighPass (1)
     if (selectedFilterIndex >= 0)
     {
-        auto typeParam = apvtsRef.getRawParameterValue(
-            ParameterHelper::getParameterID(selectedFilterIndex, "type"));
-
-        if (typeParam)
-        {
-            int filterType = static_cast<int>(typeParam->load());
-            bool hasGain = (filterType != 0 && filterType != 1);
-            gainKnob->setEnabled(hasGain);
-            gainLabel.setAlpha(hasGain ? 1.0f : 0.4f);
-        }
+        int filterType = static_cast<int>(parameters.getValue(selectedFilterIndex, BandParameter::type));
+        bool hasGain = (filterType != 0 && filterType != 1);
+        gainKnob->setEnabled(hasGain);
+        gainLabel.setAlpha(hasGain ? 1.0f : 0.4f);
     }
 }
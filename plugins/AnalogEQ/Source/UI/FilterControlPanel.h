@@ -2,6 +2,7 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "../Utils/ParameterHelper.h"
 
 /**
  * FabFilter-style control panel for selected filter.
@@ -11,7 +12,7 @@
 class FilterControlPanel : public juce::Component
 {
 public:
-    FilterControlPanel(juce::AudioProcessorValueTreeState& apvts);
+    explicit FilterControlPanel(const ParameterHelper::ParameterTable& parameterTable);
     ~FilterControlPanel() override;
 
     void paint(juce::Graphics& g) override;
@@ -27,7 +28,7 @@ public:
     std::function<void()> onFilterRemoved;
 
 private:
-    juce::AudioProcessorValueTreeState& apvtsRef;
+    const ParameterHelper::ParameterTable& parameters;
     int selectedFilterIndex = -1;
 
     // Knobs
@@ -53,8 +54,8 @@ private:
     juce::Label freqLabel, gainLabel, qLabel, panLabel, slopeLabel, typeLabel, dynThresholdLabel, dynGainLabel, dynAttackLabel, dynReleaseLabel, dynModeLabel, noSelectionLabel;
 
     // Attachments
-    using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
-    using ComboAttachment = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
+    using SliderAttachment = juce::SliderParameterAttachment;
+    using ComboAttachment = juce::ComboBoxParameterAttachment;
 
     std::unique_ptr<SliderAttachment> freqAttachment;
     std::unique_ptr<SliderAttachment> gainAttachment;
@@ -1,10 +1,12 @@
 #include "FrequencyResponseCurve.h"
+#include "../DSP/KernelDispatch.h"
 #include <ai_ui/ModernLookAndFeel.h>
 #include <ai_ui/ParameterTooltip.h>
 
-FrequencyResponseCurve::FrequencyResponseCurve(FilterChain& fc, juce::AudioProcessorValueTreeState& apvts,
-                                               AudioPluginAudioProcessor& processor)
-    : filterChain(fc), apvtsRef(apvts), processorRef(processor)
+using ParameterHelper::BandParameter;
+
+FrequencyResponseCurve::FrequencyResponseCurve(FilterChain& fc, AudioPluginAudioProcessor& processor)
+    : filterChain(fc), parameters(processor.getParameterTable()), processorRef(processor)
 {
     startTimerHz(30); // 30 FPS for maximum fluidity and precision
     
@@ -98,6 +100,15 @@ void FrequencyResponseCurve::timerCallback()
         shouldRepaint = true;
     }
 
+    // Nuovi coefficienti pubblicati dal thread audio
+    const auto responseVersion = filterChain.getResponseSnapshotVersion();
+    if (responseVersion != lastResponseVersion)
+    {
+        lastResponseVersion = responseVersion;
+        responseNeedsUpdate = true;
+        shouldRepaint = true;
+    }
+
     if (sidechainSpectrumAnalyzer->hasNewData())
     {
         sidechainSpectrumNeedsUpdate = true;
@@ -121,17 +132,34 @@ std::vector<float> FrequencyResponseCurve::calculateFrequencyResponse()
     auto width = getWidth();
     response.reserve(width);
     
+    // Legge solo la copia pubblicata: la catena appartiene al thread audio
+    const auto snapshot = filterChain.readResponseSnapshot();
+
     // Calcola la risposta per ogni pixel orizzontale
-    for (int x = 0; x < width; ++x)
-    {
-        float freq = xToFrequency(static_cast<float>(x));
-        float gain = filterChain.getTotalFrequencyResponse(freq);
-        response.push_back(gain);
-    }
+    for (const auto freq : getPixelFrequencies())
+        response.push_back(snapshot->getResponseDb(freq));
     
     return response;
 }
 
+const std::vector<float>& FrequencyResponseCurve::getPixelFrequencies()
+{
+    const auto width = juce::jmax(0, getWidth());
+    if (pixelFrequencies.size() == static_cast<size_t>(width))
+        return pixelFrequencies;
+
+    // Come xToFrequency, in un solo passaggio vettoriale: 2^(log2(min) + ottave * x / width)
+    const float minOctave = std::log2(minFreq);
+    const float octaves = std::log2(maxFreq / minFreq);
+    pixelFrequencies.resize(static_cast<size_t>(width));
+
+    for (int x = 0; x < width; ++x)
+        pixelFrequencies[static_cast<size_t>(x)] = minOctave + octaves * static_cast<float>(x) / static_cast<float>(width);
+
+    KernelDispatch::getKernels().exp2(pixelFrequencies.data(), pixelFrequencies.data(), width);
+    return pixelFrequencies;
+}
+
 float FrequencyResponseCurve::xToFrequency(float x) const
 {
     auto width = getWidth();
@@ -295,12 +323,12 @@ void FrequencyResponseCurve::mouseDown(const juce::MouseEvent& event)
     {
         isDragging = true;
         dragStartPosition = mousePos;
-        dragStartFrequency = getFilterParameter(selectedFilterIndex, "freq");
-        dragStartGain = getFilterParameter(selectedFilterIndex, "gain");
+        dragStartFrequency = getFilterParameter(selectedFilterIndex, BandParameter::freq);
+        dragStartGain = getFilterParameter(selectedFilterIndex, BandParameter::gain);
 
         // Show tooltip
         auto filterType = getFilterTypeName(selectedFilterIndex);
-        auto q = getFilterParameter(selectedFilterIndex, "q");
+        auto q = getFilterParameter(selectedFilterIndex, BandParameter::q);
         tooltip->setParameters(dragStartFrequency, dragStartGain, q, filterType);
         tooltip->showAt(event.getPosition());
 
@@ -335,15 +363,15 @@ void FrequencyResponseCurve::mouseDrag(const juce::MouseEvent& event)
     newGain = juce::jlimit(minGain, maxGain, newGain);
     
     // Update parameters
-    updateFilterParameter(selectedFilterIndex, "freq", newFrequency);
-    updateFilterParameter(selectedFilterIndex, "gain", newGain);
+    updateFilterParameter(selectedFilterIndex, BandParameter::freq, newFrequency);
+    updateFilterParameter(selectedFilterIndex, BandParameter::gain, newGain);
     
     // Mark response curve as needing recalculation
     responseNeedsUpdate = true;
     
     // Update tooltip
     auto filterType = getFilterTypeName(selectedFilterIndex);
-    auto q = getFilterParameter(selectedFilterIndex, "q");
+    auto q = getFilterParameter(selectedFilterIndex, BandParameter::q);
     tooltip->setParameters(newFrequency, newGain, q, filterType);
     tooltip->showAt(event.getPosition());
     
@@ -399,18 +427,18 @@ void FrequencyResponseCurve::mouseWheelMove(const juce::MouseEvent& event, const
         int filterIndex = selectedFilterIndex >= 0 ? selectedFilterIndex : hoveredFilterIndex;
         
         // Mouse wheel → Q factor
-        float currentQ = getFilterParameter(filterIndex, "q");
+        float currentQ = getFilterParameter(filterIndex, BandParameter::q);
         float deltaQ = wheel.deltaY * (wheel.isReversed ? -1.0f : 1.0f) * 0.5f;
         float newQ = juce::jlimit(0.1f, 10.0f, currentQ + deltaQ);
         
-        updateFilterParameter(filterIndex, "q", newQ);
+        updateFilterParameter(filterIndex, BandParameter::q, newQ);
         
         // Mark response curve as needing recalculation
         responseNeedsUpdate = true;
         
         // Show tooltip with updated Q
-        auto freq = getFilterParameter(filterIndex, "freq");
-        auto gain = getFilterParameter(filterIndex, "gain");
+        auto freq = getFilterParameter(filterIndex, BandParameter::freq);
+        auto gain = getFilterParameter(filterIndex, BandParameter::gain);
         auto filterType = getFilterTypeName(filterIndex);
         tooltip->setParameters(freq, gain, newQ, filterType);
         tooltip->showAt(event.getPosition());
@@ -427,7 +455,7 @@ int FrequencyResponseCurve::findFilterNearMouse(juce::Point<float> mousePos)
     for (int i = 0; i < maxFilters; ++i)
     {
         // Check if filter is enabled
-        if (getFilterParameter(i, "enabled") < 0.5f)
+        if (getFilterParameter(i, BandParameter::enabled) < 0.5f)
             continue;
         
         auto nodePos = getFilterNodePosition(i);
@@ -448,18 +476,18 @@ void FrequencyResponseCurve::addFilterAtMouse(juce::Point<float> mousePos)
     // Find first disabled filter
     for (int i = 0; i < maxFilters; ++i)
     {
-        if (getFilterParameter(i, "enabled") < 0.5f)
+        if (getFilterParameter(i, BandParameter::enabled) < 0.5f)
         {
             // Enable and position the filter
-            updateFilterParameter(i, "enabled", 1.0f);
+            updateFilterParameter(i, BandParameter::enabled, 1.0f);
             
             float freq = xToFrequency(mousePos.x);
             float gain = yToGain(mousePos.y);
             
-            updateFilterParameter(i, "freq", freq);
-            updateFilterParameter(i, "gain", gain);
-            updateFilterParameter(i, "q", 0.707f);
-            updateFilterParameter(i, "type", 2.0f); // Bell filter
+            updateFilterParameter(i, BandParameter::freq, freq);
+            updateFilterParameter(i, BandParameter::gain, gain);
+            updateFilterParameter(i, BandParameter::q, 0.707f);
+            updateFilterParameter(i, BandParameter::type, 2.0f); // Bell filter
             
             repaint();
             break;
@@ -473,12 +501,12 @@ void FrequencyResponseCurve::showContextMenu(int filterIndex)
     
     // Submenu for filter type
     juce::PopupMenu typeMenu;
-    typeMenu.addItem(1, "Low Pass", true, getFilterParameter(filterIndex, "type") == 0);
-    typeMenu.addItem(2, "High Pass", true, getFilterParameter(filterIndex, "type") == 1);
-    typeMenu.addItem(3, "Bell", true, getFilterParameter(filterIndex, "type") == 2);
-    typeMenu.addItem(4, "Low Shelf", true, getFilterParameter(filterIndex, "type") == 3);
-    typeMenu.addItem(5, "High Shelf", true, getFilterParameter(filterIndex, "type") == 4);
-    typeMenu.addItem(6, "Notch", true, getFilterParameter(filterIndex, "type") == 5);
+    typeMenu.addItem(1, "Low Pass", true, getFilterParameter(filterIndex, BandParameter::type) == 0);
+    typeMenu.addItem(2, "High Pass", true, getFilterParameter(filterIndex, BandParameter::type) == 1);
+    typeMenu.addItem(3, "Bell", true, getFilterParameter(filterIndex, BandParameter::type) == 2);
+    typeMenu.addItem(4, "Low Shelf", true, getFilterParameter(filterIndex, BandParameter::type) == 3);
+    typeMenu.addItem(5, "High Shelf", true, getFilterParameter(filterIndex, BandParameter::type) == 4);
+    typeMenu.addItem(6, "Notch", true, getFilterParameter(filterIndex, BandParameter::type) == 5);
     
     menu.addSubMenu("Change Type", typeMenu);
     menu.addSeparator();
@@ -489,19 +517,19 @@ void FrequencyResponseCurve::showContextMenu(int filterIndex)
         if (result >= 1 && result <= 6)
         {
             // Change filter type
-            updateFilterParameter(filterIndex, "type", static_cast<float>(result - 1));
+            updateFilterParameter(filterIndex, BandParameter::type, static_cast<float>(result - 1));
         }
         else if (result == 10)
         {
             // Reset parameters
-            updateFilterParameter(filterIndex, "freq", 1000.0f);
-            updateFilterParameter(filterIndex, "gain", 0.0f);
-            updateFilterParameter(filterIndex, "q", 0.707f);
+            updateFilterParameter(filterIndex, BandParameter::freq, 1000.0f);
+            updateFilterParameter(filterIndex, BandParameter::gain, 0.0f);
+            updateFilterParameter(filterIndex, BandParameter::q, 0.707f);
         }
         else if (result == 11)
         {
             // Remove filter
-            updateFilterParameter(filterIndex, "enabled", 0.0f);
+            updateFilterParameter(filterIndex, BandParameter::enabled, 0.0f);
         }
         repaint();
     });
@@ -509,8 +537,8 @@ void FrequencyResponseCurve::showContextMenu(int filterIndex)
 
 juce::Point<float> FrequencyResponseCurve::getFilterNodePosition(int filterIndex)
 {
-    float freq = getFilterParameter(filterIndex, "freq");
-    float gain = getFilterParameter(filterIndex, "gain");
+    float freq = getFilterParameter(filterIndex, BandParameter::freq);
+    float gain = getFilterParameter(filterIndex, BandParameter::gain);
     
     float x = frequencyToX(freq);
     float y = gainToY(gain);
@@ -523,7 +551,7 @@ void FrequencyResponseCurve::drawFilterNodes(juce::Graphics& g)
     for (int i = 0; i < maxFilters; ++i)
     {
         // Skip disabled filters
-        if (getFilterParameter(i, "enabled") < 0.5f)
+        if (getFilterParameter(i, BandParameter::enabled) < 0.5f)
             continue;
         
         auto nodePos = getFilterNodePosition(i);
@@ -563,30 +591,23 @@ void FrequencyResponseCurve::drawFilterNodes(juce::Graphics& g)
     }
 }
 
-void FrequencyResponseCurve::updateFilterParameter(int filterIndex, const juce::String& paramName, float value)
+void FrequencyResponseCurve::updateFilterParameter(int filterIndex, BandParameter parameter, float value)
 {
-    juce::String paramID = "filter" + juce::String(filterIndex) + "_" + paramName;
-    
-    if (auto* param = apvtsRef.getParameter(paramID))
-    {
-        float normalized = param->convertTo0to1(value);
-        param->setValueNotifyingHost(normalized);
-    }
+    if (juce::isPositiveAndBelow(filterIndex, parameters.getNumBands()))
+        parameters.setValueNotifyingHost(filterIndex, parameter, value);
 }
 
-float FrequencyResponseCurve::getFilterParameter(int filterIndex, const juce::String& paramName)
+float FrequencyResponseCurve::getFilterParameter(int filterIndex, BandParameter parameter) const
 {
-    juce::String paramID = "filter" + juce::String(filterIndex) + "_" + paramName;
-    
-    if (auto* param = apvtsRef.getRawParameterValue(paramID))
-        return param->load();
-    
+    if (juce::isPositiveAndBelow(filterIndex, parameters.getNumBands()))
+        return parameters.getValue(filterIndex, parameter);
+
     return 0.0f;
 }
 
 juce::String FrequencyResponseCurve::getFilterTypeName(int filterIndex)
 {
-    int typeIndex = static_cast<int>(getFilterParameter(filterIndex, "type"));
+    int typeIndex = static_cast<int>(getFilterParameter(filterIndex, BandParameter::type));
     
     switch (typeIndex)
     {
@@ -616,9 +637,10 @@ void FrequencyResponseCurve::drawSpectrum(juce::Graphics& g)
         
         // Sample every 2 pixels instead of every pixel for performance
         // This reduces the loop iterations by 50% with minimal visual quality loss
-        for (int x = 0; x < width; x += 2)
+        const auto& frequencies = getPixelFrequencies();
+        for (int x = 0; x < static_cast<int>(frequencies.size()); x += 2)
         {
-            float freq = xToFrequency(static_cast<float>(x));
+            float freq = frequencies[static_cast<size_t>(x)];
             float magnitude = spectrumAnalyzer->getMagnitudeForFrequency(freq);
             
             // Map magnitude (-60 to 0 dB) to screen Y
@@ -687,9 +709,10 @@ void FrequencyResponseCurve::drawSidechainSpectrum(juce::Graphics& g)
         cachedSidechainSpectrumPath.clear();
         bool firstPoint = true;
 
-        for (int x = 0; x < width; x += 2)
+        const auto& frequencies = getPixelFrequencies();
+        for (int x = 0; x < static_cast<int>(frequencies.size()); x += 2)
         {
-            float freq = xToFrequency(static_cast<float>(x));
+            float freq = frequencies[static_cast<size_t>(x)];
             float magnitude = sidechainSpectrumAnalyzer->getMagnitudeForFrequency(freq);
             float y = gainToY(magnitude * 0.4f);
 
@@ -3,6 +3,7 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "../DSP/FilterChain.h"
 #include "../PluginProcessor.h"
+#include "../Utils/ParameterHelper.h"
 #include "SpectrumAnalyzer.h"
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <memory>
@@ -19,8 +20,7 @@ class FrequencyResponseCurve : public juce::Component,
                                public juce::Timer
 {
 public:
-    FrequencyResponseCurve(FilterChain& fc, juce::AudioProcessorValueTreeState& apvts,
-                          AudioPluginAudioProcessor& processor);
+    FrequencyResponseCurve(FilterChain& fc, AudioPluginAudioProcessor& processor);
     ~FrequencyResponseCurve() override;
     
     void paint(juce::Graphics& g) override;
@@ -43,7 +43,7 @@ public:
     
 private:
     FilterChain& filterChain;
-    juce::AudioProcessorValueTreeState& apvtsRef;
+    const ParameterHelper::ParameterTable& parameters;
     AudioPluginAudioProcessor& processorRef;
     
     std::unique_ptr<ParameterTooltip> tooltip;
@@ -75,13 +75,16 @@ private:
     juce::Path cachedSpectrumPath;
     juce::Path cachedSidechainSpectrumPath;
     std::vector<float> cachedResponse;
+    std::vector<float> pixelFrequencies; // Frequenza di ogni pixel orizzontale
     bool spectrumNeedsUpdate = true;
     bool sidechainSpectrumNeedsUpdate = true;
     bool responseNeedsUpdate = true;
+    unsigned int lastResponseVersion = 0;
     int frameSkipCounter = 0;
     
     // Helper methods
     std::vector<float> calculateFrequencyResponse();
+    const std::vector<float>& getPixelFrequencies();
     float xToFrequency(float x) const;
     float frequencyToX(float freq) const;
     float yToGain(float y) const;
@@ -102,8 +105,8 @@ private:
     juce::Point<float> getFilterNodePosition(int filterIndex);
     
     // Parameter helpers
-    void updateFilterParameter(int filterIndex, const juce::String& paramName, float value);
-    float getFilterParameter(int filterIndex, const juce::String& paramName);
+    void updateFilterParameter(int filterIndex, ParameterHelper::BandParameter parameter, float value);
+    float getFilterParameter(int filterIndex, ParameterHelper::BandParameter parameter) const;
     juce::String getFilterTypeName(int filterIndex);
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FrequencyResponseCurve)
@@ -1,4 +1,5 @@
 #include "SpectrumAnalyzer.h"
+#include "../DSP/KernelDispatch.h"
 #include <algorithm>
 #include <cmath>
 
@@ -88,21 +89,9 @@ void SpectrumAnalyzer::performFFT()
     // Perform FFT
     fft->performFrequencyOnlyForwardTransform(fftData.data());
     
-    // Calculate magnitude spectrum in dB
-    for (int i = 0; i < currentScopeSize; ++i)
-    {
-        // Get magnitude
-        float magnitude = fftData[i];
-        
-        // Convert to dB with floor at -60dB
-        const float minLevel = 0.0000001f; // -140dB
-        magnitude = std::max(magnitude, minLevel);
-        
-        float db = 20.0f * std::log10(magnitude);
-        
-        // Clamp to -60dB to 0dB range
-        scopeData[i] = juce::jlimit(-60.0f, 0.0f, db);
-    }
+    // Calculate magnitude spectrum in dB, clamped to -60dB to 0dB range
+    KernelDispatch::getKernels().magnitudesToDecibels(fftData.data(), scopeData.data(), currentScopeSize,
+                                                      -60.0f, 0.0f);
     
     // Apply smoothing
     smoothSpectrum();
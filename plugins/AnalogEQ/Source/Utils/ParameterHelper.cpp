@@ -165,6 +165,74 @@ namespace ParameterHelper
             juce::StringArray{"Low", "Mid", "High"},
             1));
 
+        // Global filter engine: serie, forma parallela (fratti semplici) o serie a tile
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            "engine_mode",
+            "Engine Mode",
+            juce::StringArray{"Serial", "Parallel", "Fused"},
+            0));
+
+        // Rampe dei coefficienti (passi da 32 campioni) su automazione e bande dinamiche
+        layout.add(std::make_unique<juce::AudioParameterBool>(
+            "coefficient_smoothing",
+            "Coefficient Smoothing",
+            true));
+
+        // Saturazione dopo ogni banda, una sola volta in uscita o solo sulle bande con gain
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            "saturation_placement",
+            "Saturation Placement",
+            juce::StringArray{"Every Band", "Chain Output", "Gain Bands"},
+            0));
+
+        // Antialiasing della saturazione a 1x (ADAA del primo o secondo ordine)
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            "saturation_antialiasing",
+            "Saturation Antialiasing",
+            juce::StringArray{"Off", "ADAA 1st Order", "ADAA 2nd Order"},
+            0));
+
+        // Sovracampionamento della catena di filtri e filtro half-band degli stadi
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            "oversampling",
+            "Oversampling",
+            juce::StringArray{"Off", "2x", "4x", "8x"},
+            0));
+
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            "oversampling_filter",
+            "Oversampling Filter",
+            juce::StringArray{"Polyphase IIR", "Linear Phase FIR"},
+            0));
+
+        // Coefficienti dalla bilineare (RBJ) o con risposta analogica fino a Nyquist
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            "filter_design",
+            "Filter Design",
+            juce::StringArray{"Bilinear", "Matched"},
+            0));
+
+        // Sovracampionamento di tutta la catena o solo delle bande vicine a Nyquist
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            "oversampling_scope",
+            "Oversampling Scope",
+            juce::StringArray{"Whole Chain", "High Bands"},
+            0));
+
+        // Risposta dei passa-basso/passa-alto oltre i 12 dB/ottava
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            "cut_response",
+            "Cut Response",
+            juce::StringArray{"Butterworth", "Linkwitz-Riley", "Elliptic"},
+            0));
+
+        // Biquad in forma diretta o SVF con parametri interpolati a ogni campione
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            "filter_topology",
+            "Filter Topology",
+            juce::StringArray{"Biquad", "TPT SVF"},
+            0));
+
         // Crea parametri per ogni filtro
         for (int i = 0; i < numFilters; ++i)
         {
@@ -183,4 +251,75 @@ namespace ParameterHelper
     {
         return "Filter " + juce::String(filterIndex + 1) + " " + paramName;
     }
+
+    const char* getBandParameterKey(BandParameter parameter)
+    {
+        switch (parameter)
+        {
+            case BandParameter::enabled:      return "enabled";
+            case BandParameter::type:         return "type";
+            case BandParameter::freq:         return "freq";
+            case BandParameter::gain:         return "gain";
+            case BandParameter::q:            return "q";
+            case BandParameter::pan:          return "pan";
+            case BandParameter::slope:        return "slope";
+            case BandParameter::dynThreshold: return "dyn_threshold";
+            case BandParameter::dynGain:      return "dyn_gain";
+            case BandParameter::dynMode:      return "dyn_mode";
+            case BandParameter::dynAttackMs:  return "dyn_attack_ms";
+            case BandParameter::dynReleaseMs: return "dyn_release_ms";
+            case BandParameter::dynDetectorQ: return "dyn_detector_q";
+        }
+
+        return "";
+    }
+
+    const char* getGlobalParameterID(GlobalParameter parameter)
+    {
+        switch (parameter)
+        {
+            case GlobalParameter::outputGain:             return "output_gain";
+            case GlobalParameter::autoGain:               return "auto_gain";
+            case GlobalParameter::sidechainEnabled:       return "sidechain_enabled";
+            case GlobalParameter::phaseMode:              return "phase_mode";
+            case GlobalParameter::linearPhaseQuality:     return "linear_phase_quality";
+            case GlobalParameter::engineMode:             return "engine_mode";
+            case GlobalParameter::coefficientSmoothing:   return "coefficient_smoothing";
+            case GlobalParameter::saturationPlacement:    return "saturation_placement";
+            case GlobalParameter::saturationAntialiasing: return "saturation_antialiasing";
+            case GlobalParameter::oversampling:           return "oversampling";
+            case GlobalParameter::oversamplingFilter:     return "oversampling_filter";
+            case GlobalParameter::filterDesign:           return "filter_design";
+            case GlobalParameter::oversamplingScope:      return "oversampling_scope";
+            case GlobalParameter::cutResponse:            return "cut_response";
+            case GlobalParameter::filterTopology:         return "filter_topology";
+        }
+
+        return "";
+    }
+
+    ParameterTable::ParameterTable(juce::AudioProcessorValueTreeState& apvts, int numBandsToUse)
+        : numBands(juce::jlimit(0, maxBands, numBandsToUse))
+    {
+        auto resolve = [&apvts](const juce::String& parameterID)
+        {
+            Slot slot { apvts.getRawParameterValue(parameterID), apvts.getParameter(parameterID) };
+            jassert(slot.value != nullptr && slot.parameter != nullptr); // Parametro mancante nel layout
+            return slot;
+        };
+
+        for (int i = 0; i < numGlobalParameters; ++i)
+            globalSlots[static_cast<size_t>(i)] = resolve(getGlobalParameterID(static_cast<GlobalParameter>(i)));
+
+        for (int band = 0; band < numBands; ++band)
+            for (int i = 0; i < numBandParameters; ++i)
+                bandSlots[static_cast<size_t>(band)][static_cast<size_t>(i)]
+                    = resolve(getParameterID(band, getBandParameterKey(static_cast<BandParameter>(i))));
+    }
+
+    void ParameterTable::setValueNotifyingHost(int band, BandParameter parameter, float value) const
+    {
+        if (auto* param = getSlot(band, parameter).parameter)
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+    }
 }
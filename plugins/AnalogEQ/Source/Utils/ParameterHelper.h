@@ -2,6 +2,8 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include "../DSP/FilterTypes.h"
+#include <array>
+#include <atomic>
 #include <vector>
 
 //==============================================================================
@@ -37,6 +39,120 @@ namespace ParameterHelper
      */
     juce::String getParameterName(int filterIndex, const juce::String& paramName);
     
+    /**
+     * Parametri di ogni banda, nell'ordine in cui vengono creati.
+     */
+    enum class BandParameter
+    {
+        enabled = 0,
+        type,
+        freq,
+        gain,
+        q,
+        pan,
+        slope,
+        dynThreshold,
+        dynGain,
+        dynMode,
+        dynAttackMs,
+        dynReleaseMs,
+        dynDetectorQ
+    };
+
+    constexpr int numBandParameters = 13;
+
+    /**
+     * Parametri globali.
+     */
+    enum class GlobalParameter
+    {
+        outputGain = 0,
+        autoGain,
+        sidechainEnabled,
+        phaseMode,
+        linearPhaseQuality,
+        engineMode,
+        coefficientSmoothing,
+        saturationPlacement,
+        saturationAntialiasing,
+        oversampling,
+        oversamplingFilter,
+        filterDesign,
+        oversamplingScope,
+        cutResponse,
+        filterTopology
+    };
+
+    constexpr int numGlobalParameters = 15;
+    constexpr int maxBands = 8;
+
+    /**
+     * Suffisso dell'ID di un parametro di banda (es. "freq" per filterN_freq).
+     */
+    const char* getBandParameterKey(BandParameter parameter);
+
+    /**
+     * ID di un parametro globale.
+     */
+    const char* getGlobalParameterID(GlobalParameter parameter);
+
+    /**
+     * Tabella dei parametri indicizzata per banda e campo, costruita una volta
+     * sola a partire dall'APVTS. Gli accessori non costruiscono stringhe né
+     * cercano nelle mappe dell'APVTS: sono utilizzabili da processBlock e da
+     * paint. I puntatori restano validi finché vive l'APVTS.
+     */
+    class ParameterTable
+    {
+    public:
+        struct Slot
+        {
+            std::atomic<float>* value = nullptr;
+            juce::RangedAudioParameter* parameter = nullptr;
+        };
+
+        ParameterTable(juce::AudioProcessorValueTreeState& apvts, int numBands);
+
+        int getNumBands() const { return numBands; }
+
+        const Slot& getSlot(int band, BandParameter parameter) const
+        {
+            jassert(juce::isPositiveAndBelow(band, numBands));
+            return bandSlots[static_cast<size_t>(band)][static_cast<size_t>(parameter)];
+        }
+
+        const Slot& getSlot(GlobalParameter parameter) const
+        {
+            return globalSlots[static_cast<size_t>(parameter)];
+        }
+
+        /** Valore corrente (non normalizzato). */
+        float getValue(int band, BandParameter parameter) const
+        {
+            return getSlot(band, parameter).value->load(std::memory_order_relaxed);
+        }
+
+        float getValue(GlobalParameter parameter) const
+        {
+            return getSlot(parameter).value->load(std::memory_order_relaxed);
+        }
+
+        juce::RangedAudioParameter& getParameter(int band, BandParameter parameter) const
+        {
+            return *getSlot(band, parameter).parameter;
+        }
+
+        /**
+         * Imposta un valore non normalizzato notificando l'host (thread UI).
+         */
+        void setValueNotifyingHost(int band, BandParameter parameter, float value) const;
+
+    private:
+        int numBands = 0;
+        std::array<std::array<Slot, numBandParameters>, maxBands> bandSlots {};
+        std::array<Slot, numGlobalParameters> globalSlots {};
+    };
+
     /**
      * Range standard per i diversi parametri.
      */
@@ -0,0 +1,370 @@
+#include "PluginProcessor.h"
+#include "DSP/FilterChain.h"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+
+//==============================================================================
+// operator new contato per tutto l'eseguibile di test. Solo le allocazioni del
+// thread che ha armato il controllo (il thread audio simulato) vengono
+// contate: il DesignWorker e il thread dei messaggi possono allocare.
+// Le allocazioni con malloc (es. juce::HeapBlock) non passano da qui.
+namespace
+{
+    thread_local bool allocationCheckArmed = false;
+    std::atomic<int> allocationCount { 0 };
+
+    void noteAllocation()
+    {
+        if (allocationCheckArmed)
+            allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void* allocate(std::size_t size)
+    {
+        noteAllocation();
+
+        if (auto* pointer = std::malloc(size == 0 ? 1 : size))
+            return pointer;
+
+        throw std::bad_alloc();
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment)
+    {
+        noteAllocation();
+
+        const auto bytes = size == 0 ? 1 : size;
+        const auto align = juce::jmax(sizeof(void*), static_cast<std::size_t>(alignment));
+
+       #if JUCE_WINDOWS
+        if (auto* pointer = _aligned_malloc(bytes, align))
+            return pointer;
+       #else
+        void* pointer = nullptr;
+        if (posix_memalign(&pointer, align, bytes) == 0)
+            return pointer;
+       #endif
+
+        throw std::bad_alloc();
+    }
+
+    void freeAligned(void* pointer) noexcept
+    {
+       #if JUCE_WINDOWS
+        _aligned_free(pointer);
+       #else
+        std::free(pointer);
+       #endif
+    }
+
+    /** Conta le allocazioni del thread corrente finché è in vita. */
+    struct ScopedAllocationCheck
+    {
+        ScopedAllocationCheck()
+        {
+            allocationCount.store(0);
+            allocationCheckArmed = true;
+        }
+
+        ~ScopedAllocationCheck() { allocationCheckArmed = false; }
+
+        int getCount() const { return allocationCount.load(); }
+    };
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { freeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { freeAligned(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { freeAligned(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { freeAligned(pointer); }
+
+//==============================================================================
+/**
+ * Verifica che processBlock del processore e di FilterChain non allochi,
+ * anche mentre cambiano i parametri: automazione di frequenza/gain/Q, cambi
+ * di tipo e slope (dissolvenza), sovracampionamento, metodo di progetto,
+ * motore, topologia e fase lineare (ricostruzione del kernel FIR).
+ * I parametri vengono scritti fuori dal controllo, come farebbe l'host.
+ */
+class AllocationTests : public juce::UnitTest
+{
+public:
+    AllocationTests() : juce::UnitTest("Audio thread allocations", "Realtime") {}
+
+    void runTest() override
+    {
+        beginTest("FilterChain::processBlock");
+        testFilterChain();
+
+        beginTest("Processor: parameter automation");
+        {
+            ProcessorHarness harness;
+            harness.enableBands();
+
+            for (int engine = 0; engine < 3; ++engine)
+            {
+                for (int topology = 0; topology < 2; ++topology)
+                {
+                    for (int smoothing = 0; smoothing < 2; ++smoothing)
+                    {
+                        harness.setGlobal(GlobalParameter::engineMode, static_cast<float>(engine));
+                        harness.setGlobal(GlobalParameter::filterTopology, static_cast<float>(topology));
+                        harness.setGlobal(GlobalParameter::coefficientSmoothing, static_cast<float>(smoothing));
+
+                        for (int block = 0; block < 64; ++block)
+                        {
+                            harness.automate(block);
+                            expectNoAllocations(harness.processBlock());
+                        }
+                    }
+                }
+            }
+        }
+
+        beginTest("Processor: type and slope changes");
+        {
+            ProcessorHarness harness;
+            harness.enableBands();
+
+            for (int type = 0; type < 6; ++type)
+            {
+                for (int slope = 0; slope < 5; ++slope)
+                {
+                    for (int band = 0; band < 4; ++band)
+                    {
+                        harness.setBand(band, BandParameter::type, static_cast<float>((type + band) % 6));
+                        harness.setBand(band, BandParameter::slope, static_cast<float>((slope + band) % 5));
+                    }
+
+                    // Abbastanza blocchi da coprire progetto, warm-up e dissolvenza
+                    for (int block = 0; block < 16; ++block)
+                        expectNoAllocations(harness.processBlock());
+                }
+            }
+        }
+
+        beginTest("Processor: oversampling and design changes");
+        {
+            ProcessorHarness harness;
+            harness.enableBands();
+
+            for (int order = 0; order < 4; ++order)
+            {
+                for (int variant = 0; variant < 4; ++variant)
+                {
+                    harness.setGlobal(GlobalParameter::oversampling, static_cast<float>(order));
+                    harness.setGlobal(GlobalParameter::oversamplingFilter, static_cast<float>(variant & 1));
+                    harness.setGlobal(GlobalParameter::oversamplingScope, static_cast<float>((variant >> 1) & 1));
+                    harness.setGlobal(GlobalParameter::filterDesign, static_cast<float>(variant & 1));
+                    harness.setGlobal(GlobalParameter::cutResponse, static_cast<float>(variant % 3));
+                    harness.setGlobal(GlobalParameter::saturationAntialiasing, static_cast<float>(variant % 3));
+
+                    for (int block = 0; block < 8; ++block)
+                    {
+                        harness.automate(block);
+                        expectNoAllocations(harness.processBlock());
+                    }
+                }
+            }
+        }
+
+        beginTest("Processor: linear phase");
+        {
+            ProcessorHarness harness;
+            harness.enableBands();
+            harness.setGlobal(GlobalParameter::phaseMode, 2.0f);
+
+            for (int quality = 0; quality < 3; ++quality)
+            {
+                harness.setGlobal(GlobalParameter::linearPhaseQuality, static_cast<float>(quality));
+
+                // Ogni modifica ricostruisce il kernel nel blocco successivo
+                for (int block = 0; block < 8; ++block)
+                {
+                    harness.automate(block);
+                    harness.setBand(block % 4, BandParameter::type, static_cast<float>(block % 6));
+                    expectNoAllocations(harness.processBlock());
+                }
+            }
+
+            // Ritorno alla fase minima con la catena IIR
+            harness.setGlobal(GlobalParameter::phaseMode, 0.0f);
+            for (int block = 0; block < 8; ++block)
+                expectNoAllocations(harness.processBlock());
+        }
+    }
+
+private:
+    using BandParameter = ParameterHelper::BandParameter;
+    using GlobalParameter = ParameterHelper::GlobalParameter;
+
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+
+    void expectNoAllocations(int count)
+    {
+        expectEquals(count, 0, "allocations on the audio thread");
+    }
+
+    static void fillInput(juce::AudioBuffer<float>& buffer, int& phase)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* data = buffer.getWritePointer(ch);
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const auto t = static_cast<float>(phase + i) / static_cast<float>(sampleRate);
+                data[i] = 0.25f * std::sin(juce::MathConstants<float>::twoPi * 220.0f * t)
+                        + 0.1f * std::sin(juce::MathConstants<float>::twoPi * 9000.0f * t);
+            }
+        }
+
+        phase += buffer.getNumSamples();
+    }
+
+    //==============================================================================
+    struct ProcessorHarness
+    {
+        ProcessorHarness()
+        {
+            processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+            processor.prepareToPlay(sampleRate, blockSize);
+            buffer.setSize(2, blockSize);
+        }
+
+        ~ProcessorHarness() { processor.releaseResources(); }
+
+        void setBand(int band, BandParameter parameter, float value)
+        {
+            processor.getParameterTable().setValueNotifyingHost(band, parameter, value);
+        }
+
+        void setGlobal(GlobalParameter parameter, float value)
+        {
+            auto& parameterObject = *processor.getParameterTable().getSlot(parameter).parameter;
+            parameterObject.setValueNotifyingHost(parameterObject.convertTo0to1(value));
+        }
+
+        /** Quattro bande di tipi diversi, una dinamica (detector a ogni blocco). */
+        void enableBands()
+        {
+            const float types[] { 2.0f, 3.0f, 4.0f, 1.0f };
+            for (int band = 0; band < 4; ++band)
+            {
+                setBand(band, BandParameter::enabled, 1.0f);
+                setBand(band, BandParameter::type, types[band]);
+                setBand(band, BandParameter::gain, 6.0f);
+            }
+
+            setBand(0, BandParameter::dynGain, 6.0f);
+            setBand(0, BandParameter::dynThreshold, -40.0f);
+
+            // Primi blocchi fuori dal controllo: avvio del worker e primi progetti
+            for (int block = 0; block < 4; ++block)
+                processBlock();
+        }
+
+        /** Un passo di automazione continua su tutte le bande attive. */
+        void automate(int step)
+        {
+            for (int band = 0; band < 4; ++band)
+            {
+                const auto position = static_cast<float>((step + 7 * band) % 64) / 63.0f;
+                setBand(band, BandParameter::freq, 40.0f * std::pow(500.0f, position));
+                setBand(band, BandParameter::gain, -12.0f + 24.0f * position);
+                setBand(band, BandParameter::q, 0.3f + 4.0f * position);
+            }
+        }
+
+        /** @return Le allocazioni del thread corrente durante processBlock */
+        int processBlock()
+        {
+            fillInput(buffer, phase);
+
+            int count = 0;
+            {
+                ScopedAllocationCheck check;
+                processor.processBlock(buffer, midi);
+                count = check.getCount();
+            }
+
+            // Lascia al DesignWorker il tempo di consegnare i progetti
+            juce::Thread::sleep(1);
+            return count;
+        }
+
+        AudioPluginAudioProcessor processor;
+        juce::AudioBuffer<float> buffer;
+        juce::MidiBuffer midi;
+        int phase = 0;
+    };
+
+    //==============================================================================
+    void testFilterChain()
+    {
+        FilterChain chain;
+        const FilterType types[] { FilterType::Bell, FilterType::LowShelf, FilterType::HighShelf, FilterType::HighPass };
+        for (const auto type : types)
+            chain.addFilter(type);
+
+        chain.prepare(sampleRate, blockSize);
+        chain.setCoefficientSmoothing(true);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        int phase = 0;
+
+        for (int block = 0; block < 512; ++block)
+        {
+            fillInput(buffer, phase);
+
+            int count = 0;
+            {
+                ScopedAllocationCheck check;
+
+                // Le stesse chiamate che il processore fa dal thread audio
+                chain.setExecutionMode(static_cast<FilterChain::ExecutionMode>((block / 64) % 3));
+                chain.setTopology((block / 192) % 2 == 0 ? FilterChain::Topology::biquad : FilterChain::Topology::svf);
+                chain.setDesignMethod((block / 128) % 2 == 0 ? BiquadDesign::Method::bilinear : BiquadDesign::Method::matched);
+                chain.setSaturationAntialiasing(static_cast<AnalogSaturation::Antialiasing>((block / 32) % 3));
+
+                const auto band = static_cast<size_t>(block % 4);
+                if (auto* filter = chain.getFilter(band))
+                {
+                    const auto position = static_cast<float>(block % 64) / 63.0f;
+                    filter->setFrequency(40.0f * std::pow(500.0f, position));
+                    filter->setGain(-12.0f + 24.0f * position);
+                    filter->setQ(0.3f + 4.0f * position);
+                    chain.updateFilterCoefficients(band);
+                }
+
+                if (block % 48 == 47)
+                {
+                    BiquadDesign::BandParameters replacement;
+                    replacement.type = types[static_cast<size_t>((block / 48) % 4)];
+                    replacement.frequency = 800.0f;
+                    replacement.gain = 3.0f;
+                    replacement.slope = (block / 48) % 5;
+                    chain.scheduleFilterChange(band, replacement);
+                }
+
+                chain.processBlock(buffer);
+                count = check.getCount();
+            }
+
+            expectNoAllocations(count);
+            juce::Thread::sleep(1);
+        }
+    }
+};
+
+static AllocationTests allocationTests;
@@ -0,0 +1,120 @@
+#include "TestSections.h"
+#include "DSP/BlockStateSpace.h"
+#include "DSP/KernelDispatch.h"
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+ * Motore a blocchi in forma di stato contro il kernel ricorsivo, su una
+ * griglia di bande da 2-3 sezioni (tipo, frequenza tra 20 Hz e 20 kHz, Q,
+ * gain) con rumore a -6 dBFS in blocchi da 512 campioni. Le bande che
+ * BlockStateSpace::isPreferred ammette devono restare entro il limite
+ * documentato; quelle con i poli vicini a z = 1 devono essere escluse.
+ */
+class BlockStateSpaceTests : public juce::UnitTest
+{
+public:
+    BlockStateSpaceTests() : juce::UnitTest("Block state space", "DSP") {}
+
+    // Differenza massima dal percorso ricorsivo, relativa al fondo scala
+    static constexpr double maxDifference = 1.0e-4;
+
+    void runTest() override
+    {
+        if (! BlockStateSpace::isAvailable())
+            return;
+
+        KernelDispatch::selectKernels();
+
+        beginTest("Admitted bands match the recursive kernel");
+
+        const auto input = makeNoise();
+        double worst = 0.0;
+        int admitted = 0, excluded = 0;
+
+        for (const auto type : { FilterType::LowPass, FilterType::HighPass, FilterType::Bell,
+                                 FilterType::LowShelf, FilterType::HighShelf, FilterType::Notch })
+            for (int i = 0; i < numFrequencies; ++i)
+                for (const auto q : { 0.5f, 0.707f, 3.0f, 10.0f })
+                    for (const auto gain : { -12.0f, 12.0f })
+                        for (const int slope : { 1, 2 })
+                        {
+                            const auto frequency = 20.0f * std::pow(1000.0f, static_cast<float>(i) / (numFrequencies - 1));
+                            TestSections block({ type, frequency, gain, q, slope }), recursive({ type, frequency, gain, q, slope });
+
+                            if (! BlockStateSpace::isPreferred(block.numSections, blockSize))
+                                continue;
+
+                            if (! BlockStateSpace::isPreferred(block.getRange(), blockSize))
+                            {
+                                ++excluded;
+                                continue;
+                            }
+
+                            ++admitted;
+                            worst = juce::jmax(worst, measureDifference(block, recursive, input));
+                        }
+
+        logMessage(juce::String(admitted) + " bands admitted, " + juce::String(excluded)
+                   + " excluded; max difference " + juce::String(worst, 3, true));
+
+        expectGreaterThan(admitted, 0);
+        expectLessOrEqual(worst, maxDifference);
+
+        beginTest("Poles near z = 1 are excluded");
+
+        for (const auto frequency : { 20.0f, 50.0f, 100.0f })
+        {
+            TestSections lowPass({ FilterType::LowPass, frequency, 0.0f, 0.707f, 2 });
+            TestSections bell({ FilterType::Bell, frequency, 12.0f, 3.0f, 1 });
+            expect(! BlockStateSpace::isPreferred(lowPass.getRange(), blockSize), "low pass at " + juce::String(frequency));
+            expect(! BlockStateSpace::isPreferred(bell.getRange(), blockSize), "bell at " + juce::String(frequency));
+        }
+    }
+
+private:
+    static constexpr int numFrequencies = 16;
+    static constexpr int blockSize = 512;
+    static constexpr int numSamples = 32 * blockSize;
+
+    static std::vector<float> makeNoise()
+    {
+        juce::Random random(7);
+        std::vector<float> data(static_cast<size_t>(numSamples));
+        for (auto& sample : data)
+            sample = 0.5f * (2.0f * random.nextFloat() - 1.0f);
+
+        return data;
+    }
+
+    /** Stesso segnale stereo nei due motori; differenza massima sui due canali. */
+    static double measureDifference(TestSections& block, TestSections& recursive, const std::vector<float>& input)
+    {
+        auto engine = std::make_unique<BlockStateSpace>();
+        const auto& kernels = KernelDispatch::getKernels();
+
+        auto l1 = input, r1 = input, l2 = input, r2 = input;
+        std::reverse(r1.begin(), r1.end());
+        std::reverse(r2.begin(), r2.end());
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            float* const channels[] = { l1.data() + start, r1.data() + start };
+            engine->processBand(0, block.getRange(), 1, channels, 2, blockSize);
+            kernels.biquadStereo(recursive.getRange(), l2.data() + start, r2.data() + start, blockSize);
+        }
+
+        double difference = 0.0;
+        for (size_t i = 0; i < input.size(); ++i)
+            difference = juce::jmax(difference, static_cast<double>(std::abs(l1[i] - l2[i])),
+                                    static_cast<double>(std::abs(r1[i] - r2[i])));
+
+        return difference;
+    }
+};
+
+static BlockStateSpaceTests blockStateSpaceTests;
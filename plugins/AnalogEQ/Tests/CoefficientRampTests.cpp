@@ -0,0 +1,170 @@
+#include "DSP/FilterChain.h"
+#include <juce_core/juce_core.h>
+#include <cmath>
+
+//==============================================================================
+/**
+ * Rampe di coefficienti: il limite per passo di DesignWorker::getRampLength
+ * (frequenza e Q al più 1/3 di ottava, gain al più 1.5 dB) su coppie casuali
+ * e sugli estremi dei range, e la ripartenza dal passo caricato di una
+ * modifica che arriva a metà rampa, misurata sulla risposta della catena.
+ */
+class CoefficientRampTests : public juce::UnitTest
+{
+public:
+    CoefficientRampTests() : juce::UnitTest("Coefficient ramps", "DSP") {}
+
+    void runTest() override
+    {
+        testStepBound();
+        testRetarget();
+        testContinuousChanges();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr float tolerance = 1.0e-3f;
+
+    //==============================================================================
+    void testStepBound()
+    {
+        using Parameters = BiquadDesign::BandParameters;
+
+        beginTest("Ramp steps stay within the bound");
+
+        expectRampWithinBound({ FilterType::Bell, 20.0f, -24.0f, 0.1f }, { FilterType::Bell, 20000.0f, 24.0f, 10.0f });
+        expectRampWithinBound({ FilterType::Bell, 20000.0f, 24.0f, 10.0f }, { FilterType::Bell, 20.0f, -24.0f, 0.1f });
+
+        juce::Random random(11);
+        const auto randomParameters = [&random]
+        {
+            return Parameters { FilterType::Bell, 20.0f * std::pow(1000.0f, random.nextFloat()),
+                                -24.0f + 48.0f * random.nextFloat(), 0.1f * std::pow(100.0f, random.nextFloat()) };
+        };
+
+        for (int i = 0; i < 1000; ++i)
+            expectRampWithinBound(randomParameters(), randomParameters());
+
+        // Le modifiche piccole durano comunque minRampLength passi
+        expectEquals(DesignWorker::getRampLength({ FilterType::Bell, 1000.0f, 0.0f, 1.0f },
+                                                 { FilterType::Bell, 1000.0f, 0.5f, 1.0f }),
+                     DesignWorker::minRampLength);
+    }
+
+    void expectRampWithinBound(const BiquadDesign::BandParameters& from, const BiquadDesign::BandParameters& to)
+    {
+        const auto numSteps = DesignWorker::getRampLength(from, to);
+        expect(numSteps >= DesignWorker::minRampLength && numSteps <= DesignWorker::maxRampLength);
+
+        auto previous = from;
+        for (int step = 1; step <= numSteps; ++step)
+        {
+            const auto current = BiquadDesign::interpolate(from, to, static_cast<float>(step) / static_cast<float>(numSteps));
+            expectLessOrEqual(std::abs(std::log2(current.frequency / previous.frequency)), DesignWorker::maxStepOctaves + tolerance);
+            expectLessOrEqual(std::abs(std::log2(current.q / previous.q)), DesignWorker::maxStepOctaves + tolerance);
+            expectLessOrEqual(std::abs(current.gain - previous.gain), DesignWorker::maxStepDecibels + tolerance);
+            previous = current;
+        }
+    }
+
+    //==============================================================================
+    /**
+     * Bell a 1 kHz da 0 a +12 dB, e ritorno a 0 dB dopo quattro passi: al
+     * centro della campana la risposta è il gain, quindi deve scendere
+     * subito dal valore raggiunto, un passo alla volta, senza arrivare a 12.
+     */
+    void testRetarget()
+    {
+        beginTest("Mid-ramp change retargets from the loaded step");
+
+        constexpr float centre = 1000.0f;
+
+        FilterChain chain;
+        auto* filter = chain.addFilter(FilterType::Bell);
+        filter->setFrequency(centre);
+        filter->setGain(0.0f);
+        filter->setQ(1.0f);
+
+        chain.setAsyncDesign(false);
+        chain.setCoefficientSmoothing(true);
+        chain.prepare(sampleRate, 512);
+        chain.updateFilterCoefficients(0);
+
+        juce::AudioBuffer<float> buffer(2, FilterChain::rampStepSamples);
+        const auto processStep = [&]
+        {
+            buffer.clear();
+            chain.processBlock(buffer);
+            return filter->getFrequencyResponse(centre);
+        };
+
+        filter->setGain(12.0f);
+        chain.updateFilterCoefficients(0);
+
+        float reached = 0.0f;
+        for (int step = 0; step < 4; ++step)
+            reached = processStep();
+
+        expectGreaterThan(reached, 0.0f);
+        expectLessThan(reached, 12.0f);
+
+        filter->setGain(0.0f);
+        chain.updateFilterCoefficients(0);
+
+        auto previous = reached;
+        for (int step = 0; step < DesignWorker::maxRampLength; ++step)
+        {
+            const auto response = processStep();
+            expectLessOrEqual(response, previous + tolerance, "no overshoot after the change");
+            expectLessOrEqual(previous - response, DesignWorker::maxStepDecibels + tolerance, "one step at a time");
+            previous = response;
+        }
+
+        expectWithinAbsoluteError(previous, 0.0f, tolerance);
+    }
+
+    /**
+     * Con il progetto asincrono (il caso in tempo reale) una banda che cambia
+     * a ogni blocco, come durante un'automazione o una banda dinamica, deve
+     * comunque avanzare: il gain oscilla di 0.01 dB attorno a +12 dB e la
+     * risposta al centro deve arrivarci.
+     */
+    void testContinuousChanges()
+    {
+        beginTest("Changes on every block still converge with async design");
+
+        constexpr float centre = 1000.0f;
+        constexpr float target = 12.0f;
+        constexpr int maxBlocks = 2000;
+
+        FilterChain chain;
+        auto* filter = chain.addFilter(FilterType::Bell);
+        filter->setFrequency(centre);
+        filter->setGain(0.0f);
+        filter->setQ(1.0f);
+
+        chain.setAsyncDesign(false);
+        chain.setCoefficientSmoothing(true);
+        chain.prepare(sampleRate, 512);
+        chain.updateFilterCoefficients(0);
+        chain.setAsyncDesign(true);
+
+        juce::AudioBuffer<float> buffer(2, 2 * FilterChain::rampStepSamples);
+        float response = filter->getFrequencyResponse(centre);
+
+        for (int block = 0; block < maxBlocks && std::abs(response - target) > 0.1f; ++block)
+        {
+            filter->setGain(target + (block % 2 == 0 ? 0.01f : -0.01f));
+            chain.updateFilterCoefficients(0);
+
+            buffer.clear();
+            chain.processBlock(buffer);
+            response = filter->getFrequencyResponse(centre);
+            juce::Thread::sleep(1);
+        }
+
+        expectWithinAbsoluteError(response, target, 0.1f);
+    }
+};
+
+static CoefficientRampTests coefficientRampTests;
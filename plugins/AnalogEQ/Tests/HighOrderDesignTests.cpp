@@ -0,0 +1,390 @@
+#include "DSP/BiquadDesign.h"
+#include "DSP/HighOrderDesign.h"
+#include <juce_core/juce_core.h>
+#include <cmath>
+#include <complex>
+
+//==============================================================================
+/**
+ * Tagli di ordine alto di HighOrderDesign, valutati in double sulle sezioni
+ * in float che il motore esegue: Butterworth a -3.01 dB e Linkwitz-Riley a
+ * -6.02 dB al taglio, somma piatta dei due LR, ripple e attenuazione
+ * nominale a un'ottava degli ellittici con 2/3/4 sezioni, e stabilità di
+ * ogni sezione su slope × risposta × metodo. Bell e shelf di ogni ordine
+ * su frequenza × gain × Q: gain al centro, bordi e shelf RBJ a ordine 2.
+ */
+class HighOrderDesignTests : public juce::UnitTest
+{
+public:
+    HighOrderDesignTests() : juce::UnitTest("High order design", "DSP") {}
+
+    void runTest() override
+    {
+        testButterworth();
+        testLinkwitzRiley();
+        testElliptic();
+        testCutStability();
+        testBell();
+        testShelf();
+    }
+
+private:
+    using Complex = std::complex<double>;
+    using CutResponse = BiquadDesign::CutResponse;
+    using Method = BiquadDesign::Method;
+
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int numSlopes = 5;
+
+    struct Band
+    {
+        BiquadDesign::SectionArray sections;
+        int numSections = 0;
+        double rate = sampleRate;
+
+        Complex response(double frequency) const
+        {
+            const auto z1 = std::polar(1.0, -juce::MathConstants<double>::twoPi * frequency / rate);
+            const auto z2 = z1 * z1;
+            Complex h = 1.0;
+
+            for (int s = 0; s < numSections; ++s)
+            {
+                const auto& c = sections[static_cast<size_t>(s)];
+                h *= (static_cast<double>(c.b0) + static_cast<double>(c.b1) * z1 + static_cast<double>(c.b2) * z2)
+                   / (1.0 + static_cast<double>(c.a1) * z1 + static_cast<double>(c.a2) * z2);
+            }
+
+            return h;
+        }
+
+        double responseDb(double frequency) const { return toDb(std::abs(response(frequency))); }
+    };
+
+    static double toDb(double magnitude) { return 20.0 * std::log10(juce::jmax(1.0e-30, magnitude)); }
+
+    static Band design(FilterType type, float frequency, int slope, CutResponse response, Method method, float q = 0.707f)
+    {
+        Band band;
+        BiquadDesign::BandParameters parameters { type, frequency, 0.0f, q, slope, method, response };
+        band.numSections = BiquadDesign::designBand(parameters, sampleRate, band.sections);
+        return band;
+    }
+
+    //==============================================================================
+    void testButterworth()
+    {
+        beginTest("Butterworth is -3.01 dB at the cutoff");
+
+        // La bilineare è precompensata al taglio. Le sezioni matched seguono
+        // il prototipo analogico, ma i loro errori si sommano: a 5 kHz il
+        // passa-basso da 8 sezioni è già a -3.66 dB, quindi solo fino a 1 kHz
+        for (const auto method : { Method::bilinear, Method::matched })
+            for (const auto type : { FilterType::LowPass, FilterType::HighPass })
+                for (int slope = 1; slope < numSlopes; ++slope)
+                    for (const auto frequency : { 100.0f, 1000.0f, 5000.0f })
+                    {
+                        if (method == Method::matched && frequency > 1000.0f)
+                            continue;
+
+                        const auto band = design(type, frequency, slope, CutResponse::butterworth, method);
+                        expectWithinAbsoluteError(band.responseDb(frequency), -3.0103,
+                                                  method == Method::bilinear ? 0.01 : 0.05);
+                    }
+    }
+
+    void testLinkwitzRiley()
+    {
+        beginTest("Linkwitz-Riley is -6.02 dB at the cutoff and sums flat");
+
+        for (int slope = 1; slope < numSlopes; ++slope)
+            for (const auto frequency : { 100.0f, 1000.0f, 5000.0f })
+            {
+                const auto lowPass = design(FilterType::LowPass, frequency, slope, CutResponse::linkwitzRiley, Method::bilinear);
+                const auto highPass = design(FilterType::HighPass, frequency, slope, CutResponse::linkwitzRiley, Method::bilinear);
+
+                expectWithinAbsoluteError(lowPass.responseDb(frequency), -6.0206, 0.01);
+                expectWithinAbsoluteError(highPass.responseDb(frequency), -6.0206, 0.01);
+
+                // LR2 somma piatta con il passa-alto invertito, gli ordini multipli di 4 in fase
+                const double polarity = HighOrderDesign::getCutOrder(slope, CutResponse::linkwitzRiley) % 4 == 0 ? 1.0 : -1.0;
+                double worst = 0.0;
+
+                for (int i = 0; i < numPoints; ++i)
+                {
+                    const double f = 20.0 * std::pow(1000.0, static_cast<double>(i) / (numPoints - 1));
+                    worst = juce::jmax(worst, std::abs(toDb(std::abs(lowPass.response(f) + polarity * highPass.response(f)))));
+                }
+
+                expectLessOrEqual(worst, 0.01, "LP + HP at slope " + juce::String(slope));
+            }
+    }
+
+    void testElliptic()
+    {
+        beginTest("Elliptic ripple and nominal attenuation one octave from the cutoff");
+
+        const int expectedSections[] { 0, 0, 2, 3, 4 };
+
+        for (int slope = 2; slope < numSlopes; ++slope)
+        {
+            const double stopbandDb = 6.0 * static_cast<double>(1 << slope);
+            expectEquals(HighOrderDesign::getCutSections(slope, CutResponse::elliptic), expectedSections[slope]);
+
+            for (const auto frequency : { 200.0f, 1000.0f, 5000.0f })
+            {
+                const auto lowPass = design(FilterType::LowPass, frequency, slope, CutResponse::elliptic, Method::bilinear);
+                const auto highPass = design(FilterType::HighPass, frequency, slope, CutResponse::elliptic, Method::bilinear);
+                expectEquals(lowPass.numSections, expectedSections[slope]);
+
+                double rippleMin = 0.0, rippleMax = -1000.0, stopbandMax = -1000.0;
+
+                for (int i = 0; i < numPoints; ++i)
+                {
+                    const double t = static_cast<double>(i) / (numPoints - 1);
+
+                    // Banda passante: 20 Hz - taglio (LP), taglio - 20 kHz (HP)
+                    const double lowPassband = 20.0 * std::pow(frequency / 20.0, t);
+                    const double highPassband = frequency * std::pow(20000.0 / frequency, t);
+                    for (const auto db : { lowPass.responseDb(lowPassband), highPass.responseDb(highPassband) })
+                    {
+                        rippleMin = juce::jmin(rippleMin, db);
+                        rippleMax = juce::jmax(rippleMax, db);
+                    }
+
+                    // Banda oscura: da un'ottava oltre il taglio
+                    const double lowStopband = 2.0 * frequency * std::pow(0.45 * sampleRate / (2.0 * frequency), t);
+                    const double highStopband = 10.0 * std::pow(0.5 * frequency / 10.0, t);
+                    stopbandMax = juce::jmax(stopbandMax, lowPass.responseDb(lowStopband), highPass.responseDb(highStopband));
+                }
+
+                expectGreaterOrEqual(rippleMin, -HighOrderDesign::ellipticPassbandRippleDb - 0.005, "ripple");
+                expectLessOrEqual(rippleMax, 0.005, "ripple");
+                expectLessOrEqual(stopbandMax, -stopbandDb + 0.05, "stopband at " + juce::String(stopbandDb) + " dB");
+            }
+        }
+    }
+
+    void testCutStability()
+    {
+        beginTest("Every cut section is stable");
+
+        int numBands = 0;
+
+        for (int slope = 0; slope < numSlopes; ++slope)
+            for (const auto response : { CutResponse::butterworth, CutResponse::linkwitzRiley, CutResponse::elliptic })
+                for (const auto method : { Method::bilinear, Method::matched })
+                    for (const auto type : { FilterType::LowPass, FilterType::HighPass })
+                        for (int i = 0; i < 16; ++i)
+                            for (const auto q : { 0.1f, 0.707f, 3.0f, 10.0f })
+                            {
+                                const auto frequency = 20.0f * std::pow(1100.0f, static_cast<float>(i) / 15.0f);
+                                const auto band = design(type, frequency, slope, response, method, q);
+                                ++numBands;
+
+                                for (int s = 0; s < band.numSections; ++s)
+                                    expect(isStable(band.sections[static_cast<size_t>(s)]),
+                                           "slope " + juce::String(slope) + " at " + juce::String(frequency) + " Hz");
+                            }
+
+        logMessage(juce::String(numBands) + " bands");
+    }
+
+    //==============================================================================
+    static constexpr int bellOrders[] { 1, 2, 3, 4, 6 };
+    static constexpr float gains[] { -24.0f, -12.0f, -3.0f, 3.0f, 12.0f, 24.0f };
+    static constexpr float qs[] { 0.1f, 0.3f, 0.707f, 1.0f, 3.0f, 10.0f, 18.0f };
+    static constexpr int numFrequencies = 16;
+
+    static float gridFrequency(int i)
+    {
+        return 40.0f * std::pow(550.0f, static_cast<float>(i) / (numFrequencies - 1));
+    }
+
+    /** Un'unica sezione in Band, per valutare i biquad RBJ. */
+    static Band single(const BiquadCoefficients& c, double rate)
+    {
+        Band band;
+        band.rate = rate;
+        band.sections[0] = c;
+        band.numSections = 1;
+        return band;
+    }
+
+    /**
+     * Frequenza a cui la risposta vale targetDb, tra from e to (in ottave),
+     * per bisezione: la risposta dei Bell Butterworth è monotona su ogni
+     * fianco.
+     */
+    static double findCrossing(const Band& band, double targetDb, double from, double to)
+    {
+        const bool rising = band.responseDb(to) > band.responseDb(from);
+
+        for (int i = 0; i < 60; ++i)
+        {
+            const double middle = std::sqrt(from * to);
+            ((band.responseDb(middle) < targetDb) == rising ? from : to) = middle;
+        }
+
+        return std::sqrt(from * to);
+    }
+
+    /**
+     * Bell di ogni ordine su frequenza (40 Hz - 22 kHz) × gain (±24 dB) × Q
+     * (0.1 - 18): gain esatto al centro, punti a metà gain sugli stessi del
+     * biquad RBJ, e nessuna sezione che stabilise debba riportare nel
+     * triangolo di stabilità. Vicino a continua e a Nyquist l'arrotondamento
+     * dei coefficienti in float sposta il centro fino a circa 0.8 dB, come
+     * per il biquad RBJ.
+     */
+    void testBell()
+    {
+        beginTest("Bell: exact centre gain, RBJ half-gain edges, no clamped sections");
+
+        double centreError = 0.0, outerCentreError = 0.0, edgeError = 0.0;
+
+        for (const auto rate : { 44100.0, 48000.0 })
+            for (int i = 0; i < numFrequencies; ++i)
+                for (const auto gain : gains)
+                    for (const auto q : qs)
+                    {
+                        const auto frequency = gridFrequency(i);
+                        const auto rbj = single(BiquadDesign::peak(rate, frequency, q, juce::Decibels::decibelsToGain(gain)), rate);
+
+                        // Bordi RBJ dove cadono entrambi dentro la banda utile
+                        const bool edges = isWellConditioned(frequency) && q >= 0.3f;
+                        const double nyquist = 0.4999 * rate;
+                        const double lowerEdge = edges ? findCrossing(rbj, 0.5 * gain, 0.01, frequency) : 0.0;
+                        const double upperEdge = edges ? findCrossing(rbj, 0.5 * gain, frequency, nyquist) : 0.0;
+
+                        for (const auto order : bellOrders)
+                        {
+                            Band band;
+                            band.rate = rate;
+                            band.numSections = HighOrderDesign::peak(order, rate, frequency, q, gain, band.sections);
+                            expectEquals(band.numSections, order);
+
+                            for (int s = 0; s < band.numSections; ++s)
+                                expect(isInsideMargin(band.sections[static_cast<size_t>(s)]),
+                                       "order " + juce::String(order) + " at " + juce::String(frequency) + " Hz, Q "
+                                       + juce::String(q) + ", " + juce::String(gain) + " dB");
+
+                            auto& error = isWellConditioned(frequency) ? centreError : outerCentreError;
+                            error = juce::jmax(error, std::abs(band.responseDb(frequency) - gain));
+
+                            if (edges)
+                            {
+                                edgeError = juce::jmax(edgeError,
+                                                       std::abs(std::log2(findCrossing(band, 0.5 * gain, 0.01, frequency) / lowerEdge)),
+                                                       std::abs(std::log2(findCrossing(band, 0.5 * gain, frequency, nyquist) / upperEdge)));
+                            }
+                        }
+                    }
+
+        logMessage("centre within " + juce::String(centreError, 4) + " dB from 200 Hz to 15 kHz, "
+                   + juce::String(outerCentreError, 4) + " dB outside; half-gain edges within "
+                   + juce::String(edgeError, 5) + " octaves of RBJ");
+
+        expectLessOrEqual(centreError, maxCentreErrorDb);
+        expectLessOrEqual(outerCentreError, maxOuterCentreErrorDb);
+        expectLessOrEqual(edgeError, maxEdgeErrorOctaves);
+    }
+
+    /**
+     * Shelf di ogni ordine sulla stessa griglia: metà gain alla frequenza e
+     * gain pieno in continua (low) o a Nyquist (high) lontano dagli estremi,
+     * e a ordine 2 gli stessi coefficienti dello shelf RBJ, Q compreso.
+     */
+    void testShelf()
+    {
+        beginTest("Shelf: half gain at the frequency, order 2 matches the RBJ shelf");
+
+        double halfGainError = 0.0, plateauError = 0.0, rbjError = 0.0;
+
+        for (const auto rate : { 44100.0, 48000.0 })
+            for (int i = 0; i < numFrequencies; ++i)
+                for (const auto gain : gains)
+                    for (const auto q : qs)
+                        for (const bool highShelf : { false, true })
+                        {
+                            const auto frequency = gridFrequency(i);
+
+                            for (int slope = 0; slope < numSlopes; ++slope)
+                            {
+                                const int order = HighOrderDesign::getShelfOrder(slope);
+                                Band band;
+                                band.rate = rate;
+                                band.numSections = HighOrderDesign::shelf(highShelf, order, rate, frequency, q, gain, band.sections);
+
+                                for (int s = 0; s < band.numSections; ++s)
+                                    expect(isStable(band.sections[static_cast<size_t>(s)]));
+
+                                if (isWellConditioned(frequency))
+                                {
+                                    const double plateau = highShelf ? 0.5 * rate : 0.0;
+                                    halfGainError = juce::jmax(halfGainError, std::abs(band.responseDb(frequency) - 0.5 * gain));
+                                    plateauError = juce::jmax(plateauError, std::abs(band.responseDb(plateau) - gain));
+                                }
+
+                                if (order == 2)
+                                {
+                                    const auto gainFactor = juce::Decibels::decibelsToGain(gain);
+                                    rbjError = juce::jmax(rbjError, coefficientError(band.sections[0],
+                                                                                     highShelf ? BiquadDesign::highShelf(rate, frequency, q, gainFactor)
+                                                                                               : BiquadDesign::lowShelf(rate, frequency, q, gainFactor)));
+                                }
+                            }
+                        }
+
+        logMessage("half gain within " + juce::String(halfGainError, 4) + " dB and plateau within "
+                   + juce::String(plateauError, 4) + " dB from 200 Hz to 15 kHz; order 2 coefficients within "
+                   + juce::String(rbjError, 3, true) + " of RBJ");
+
+        expectLessOrEqual(halfGainError, maxCentreErrorDb);
+        expectLessOrEqual(plateauError, maxPlateauErrorDb);
+        expectLessOrEqual(rbjError, maxCoefficientError);
+    }
+
+    /**
+     * Dove l'arrotondamento dei coefficienti in float non sposta la
+     * risposta: i poli vicini a z = ±1 ne amplificano l'effetto.
+     */
+    static bool isWellConditioned(float frequency) { return frequency >= 200.0f && frequency <= 15000.0f; }
+
+    /** Differenza massima tra i coefficienti, relativa al loro ordine di grandezza (a1 fino a 2). */
+    static double coefficientError(const BiquadCoefficients& c, const BiquadCoefficients& reference)
+    {
+        const double scale = juce::jmax(2.0f, std::abs(reference.b0), juce::jmax(std::abs(reference.b1), std::abs(reference.b2)));
+        double error = 0.0;
+
+        for (const auto difference : { c.b0 - reference.b0, c.b1 - reference.b1, c.b2 - reference.b2,
+                                       c.a1 - reference.a1, c.a2 - reference.a2 })
+            error = juce::jmax(error, std::abs(static_cast<double>(difference)) / scale);
+
+        return error;
+    }
+
+    /** Dentro il triangolo con il margine di HighOrderDesign: stabilise non è intervenuto. */
+    static bool isInsideMargin(const BiquadCoefficients& c)
+    {
+        constexpr float margin = HighOrderDesign::stabilityMargin;
+        return std::abs(c.a2) < 1.0f - margin && std::abs(c.a1) < (1.0f + c.a2) * (1.0f - margin);
+    }
+
+    /** Poli dentro il cerchio unitario: triangolo |a2| < 1, |a1| < 1 + a2. */
+    static bool isStable(const BiquadCoefficients& c)
+    {
+        return std::abs(c.a2) < 1.0f && std::abs(c.a1) < 1.0f + c.a2;
+    }
+
+    static constexpr int numPoints = 512;
+
+    // Bell e shelf: errori da 200 Hz a 15 kHz e, per il centro dei Bell, fuori
+    static constexpr double maxCentreErrorDb = 0.1;
+    static constexpr double maxOuterCentreErrorDb = 1.0;
+    static constexpr double maxPlateauErrorDb = 0.01;
+    static constexpr double maxEdgeErrorOctaves = 0.01;
+    static constexpr double maxCoefficientError = 1.0e-6;
+};
+
+static HighOrderDesignTests highOrderDesignTests;
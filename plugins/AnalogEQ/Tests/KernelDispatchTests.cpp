@@ -0,0 +1,225 @@
+#include "TestSections.h"
+#include "DSP/KernelDispatch.h"
+#include <juce_core/juce_core.h>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+//==============================================================================
+/**
+ * Ogni ISA disponibile, forzata con setForcedIsa come in modalità di test,
+ * contro la tabella scalar sugli stessi dati. Cascata di biquad, saturazione
+ * e approssimazioni di FastMath devono coincidere bit per bit; prodotto
+ * scalare e somma dei quadrati entro l'arrotondamento delle somme riordinate.
+ */
+class KernelDispatchTests : public juce::UnitTest
+{
+public:
+    KernelDispatchTests() : juce::UnitTest("Kernel dispatch", "DSP") {}
+
+    void runTest() override
+    {
+        using KernelDispatch::Isa;
+
+        beginTest("Forced ISA selection");
+        for (int i = 0; i < KernelDispatch::numIsas; ++i)
+        {
+            const auto requested = static_cast<Isa>(i);
+            KernelDispatch::setForcedIsa(requested);
+            const auto selected = KernelDispatch::selectKernels();
+
+            expect(KernelDispatch::isSupported(selected));
+            expect(static_cast<int>(selected) <= i);
+            expect(! KernelDispatch::isSupported(requested) || selected == requested);
+            expect(KernelDispatch::getKernels().isa == selected);
+        }
+
+        KernelDispatch::clearForcedIsa();
+        expect(KernelDispatch::selectKernels() == KernelDispatch::detectIsa());
+
+        const auto* scalar = KernelDispatch::getKernels(Isa::scalar);
+        expect(scalar != nullptr);
+        if (scalar == nullptr)
+            return;
+
+        for (int i = 0; i < KernelDispatch::numIsas; ++i)
+        {
+            const auto isa = static_cast<Isa>(i);
+            if (! KernelDispatch::isSupported(isa))
+                continue;
+
+            beginTest(juce::String(KernelDispatch::getIsaName(isa)) + " vs scalar");
+            KernelDispatch::setForcedIsa(isa);
+            expect(KernelDispatch::selectKernels() == isa);
+
+            const auto& table = KernelDispatch::getKernels();
+            compareBiquads(table, *scalar);
+            compareReductions(table, *scalar);
+            compareMath(table, *scalar);
+        }
+
+        KernelDispatch::clearForcedIsa();
+        KernelDispatch::selectKernels();
+    }
+
+private:
+    using Table = KernelDispatch::KernelTable;
+
+    static constexpr int numSamples = 1031; // non multiplo della larghezza dei vettori
+    static constexpr int blockSizes[] { 1, 3, 17, 64, 255, 691 };
+
+    static std::vector<float> makeNoise(int count, float amplitude, juce::int64 seed)
+    {
+        juce::Random random(seed);
+        std::vector<float> data(static_cast<size_t>(count));
+        for (auto& sample : data)
+            sample = amplitude * (2.0f * random.nextFloat() - 1.0f);
+
+        return data;
+    }
+
+    static bool identical(const std::vector<float>& a, const std::vector<float>& b)
+    {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+    }
+
+    void compareBiquads(const Table& table, const Table& scalar)
+    {
+        const BiquadDesign::BandParameters bands[] {
+            { FilterType::Bell, 1000.0f, 9.0f, 2.0f, 1 },
+            { FilterType::LowShelf, 80.0f, -6.0f, 0.707f, 1 },
+            { FilterType::HighPass, 40.0f, 0.0f, 0.707f, 3 },
+            { FilterType::LowPass, 12000.0f, 0.0f, 0.707f, 4 },
+        };
+
+        for (const auto& parameters : bands)
+        {
+            const auto left = makeNoise(numSamples, 0.5f, 1);
+            const auto right = makeNoise(numSamples, 0.5f, 2);
+
+            // Stereo a blocchi di lunghezze diverse: stato e code dei vettori
+            {
+                TestSections a(parameters), b(parameters);
+                auto l1 = left, r1 = right, l2 = left, r2 = right;
+
+                for (int start = 0, block = 0; start < numSamples; ++block)
+                {
+                    const int length = juce::jmin(blockSizes[block % 6], numSamples - start);
+                    table.biquadStereo(a.getRange(), l1.data() + start, r1.data() + start, length);
+                    scalar.biquadStereo(b.getRange(), l2.data() + start, r2.data() + start, length);
+                    start += length;
+                }
+
+                expect(identical(l1, l2) && identical(r1, r2), "biquadStereo");
+            }
+
+            // Mono sul secondo canale dello stato
+            {
+                TestSections a(parameters), b(parameters);
+                auto m1 = left, m2 = left;
+                table.biquadMono(a.getRange(), 1, m1.data(), numSamples);
+                scalar.biquadMono(b.getRange(), 1, m2.data(), numSamples);
+                expect(identical(m1, m2), "biquadMono");
+            }
+
+            // Frame interleaved (tile del motore fuso)
+            {
+                TestSections a(parameters), b(parameters);
+                std::vector<float> f1(static_cast<size_t>(2 * numSamples));
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    f1[static_cast<size_t>(2 * i)] = left[static_cast<size_t>(i)];
+                    f1[static_cast<size_t>(2 * i + 1)] = right[static_cast<size_t>(i)];
+                }
+
+                auto f2 = f1;
+                table.biquadStereoFrames(a.getRange(), f1.data(), numSamples);
+                scalar.biquadStereoFrames(b.getRange(), f2.data(), numSamples);
+                expect(identical(f1, f2), "biquadStereoFrames");
+            }
+        }
+    }
+
+    void compareReductions(const Table& table, const Table& scalar)
+    {
+        const auto a = makeNoise(numSamples, 1.0f, 3);
+        const auto b = makeNoise(numSamples, 1.0f, 4);
+
+        for (const int count : { 1, 7, 64, 513, numSamples })
+        {
+            // Limite: arrotondamento di somme riordinate, relativo alla somma dei moduli
+            double magnitude = 0.0, squares = 0.0;
+            for (int i = 0; i < count; ++i)
+            {
+                magnitude += std::abs(static_cast<double>(a[static_cast<size_t>(i)]) * b[static_cast<size_t>(i)]);
+                squares += static_cast<double>(a[static_cast<size_t>(i)]) * a[static_cast<size_t>(i)];
+            }
+
+            const auto tolerance = 1.0e-6 * static_cast<double>(count);
+            expectWithinAbsoluteError(static_cast<double>(table.dotProduct(a.data(), b.data(), count)),
+                                      static_cast<double>(scalar.dotProduct(a.data(), b.data(), count)),
+                                      tolerance * magnitude, "dotProduct");
+            expectWithinAbsoluteError(static_cast<double>(table.sumOfSquares(a.data(), count)),
+                                      static_cast<double>(scalar.sumOfSquares(a.data(), count)),
+                                      tolerance * squares, "sumOfSquares");
+        }
+    }
+
+    void compareMath(const Table& table, const Table& scalar)
+    {
+        const auto noise = makeNoise(numSamples, 3.0f, 5);
+
+        {
+            auto x1 = noise, x2 = noise;
+            table.saturate(x1.data(), numSamples);
+            scalar.saturate(x2.data(), numSamples);
+            expect(identical(x1, x2), "saturate");
+        }
+
+        // Frame stereo (stride 2) e canale singolo
+        for (const int stride : { 1, 2 })
+        {
+            const int count = numSamples - (numSamples % stride);
+            std::array<float, 4> h1 {}, h2 {}, h3 {}, h4 {};
+            auto x1 = noise, x2 = noise, x3 = noise, x4 = noise;
+            table.saturateAdaa1(x1.data(), count, stride, h1.data());
+            scalar.saturateAdaa1(x2.data(), count, stride, h2.data());
+            table.saturateAdaa2(x3.data(), count, stride, h3.data());
+            scalar.saturateAdaa2(x4.data(), count, stride, h4.data());
+            expect(identical(x1, x2) && h1 == h2, "saturateAdaa1");
+            expect(identical(x3, x4) && h3 == h4, "saturateAdaa2");
+        }
+
+        std::vector<float> input(static_cast<size_t>(numSamples));
+        std::vector<float> o1(input.size()), o2(input.size()), o3(input.size()), o4(input.size());
+
+        for (size_t i = 0; i < input.size(); ++i)
+            input[i] = std::abs(noise[i]) * 0.3f + 1.0e-8f;
+        table.magnitudesToDecibels(input.data(), o1.data(), numSamples, -100.0f, 12.0f);
+        scalar.magnitudesToDecibels(input.data(), o2.data(), numSamples, -100.0f, 12.0f);
+        expect(identical(o1, o2), "magnitudesToDecibels");
+
+        for (size_t i = 0; i < input.size(); ++i)
+            input[i] = noise[i] * 40.0f;
+        table.decibelsToGains(input.data(), o1.data(), numSamples);
+        scalar.decibelsToGains(input.data(), o2.data(), numSamples);
+        expect(identical(o1, o2), "decibelsToGains");
+
+        table.exp2(input.data(), o1.data(), numSamples);
+        scalar.exp2(input.data(), o2.data(), numSamples);
+        expect(identical(o1, o2), "exp2");
+
+        table.sinCos(input.data(), o1.data(), o3.data(), numSamples);
+        scalar.sinCos(input.data(), o2.data(), o4.data(), numSamples);
+        expect(identical(o1, o2) && identical(o3, o4), "sinCos");
+
+        for (size_t i = 0; i < input.size(); ++i)
+            input[i] = std::exp2(noise[i] * 20.0f);
+        table.log2(input.data(), o1.data(), numSamples);
+        scalar.log2(input.data(), o2.data(), numSamples);
+        expect(identical(o1, o2), "log2");
+    }
+};
+
+static KernelDispatchTests kernelDispatchTests;
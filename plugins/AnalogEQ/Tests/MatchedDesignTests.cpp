@@ -0,0 +1,171 @@
+#include "DSP/BiquadDesign.h"
+#include <juce_core/juce_core.h>
+#include <cmath>
+#include <complex>
+
+//==============================================================================
+/**
+ * Progetti matched contro il prototipo analogico RBJ da cui derivano:
+ * modulo in dB su una griglia logaritmica tra 20 Hz e 20 kHz, a 44.1 e
+ * 48 kHz, per frequenze del filtro fino a 20 kHz, Q tra 0.5 e 3 e gain tra
+ * -12 e +15 dB. Il prototipo è scritto qui in forma indipendente da
+ * BiquadDesign; sotto -30 dB (fondo di passa-basso, passa-alto e notch)
+ * il confronto si ferma al pavimento.
+ *
+ * Due limiti per prototipo: frequenza del filtro fino a 10 kHz e fino a
+ * 20 kHz. Oltre i 10 kHz passa-alto e notch perdono precisione (Nyquist
+ * non è vincolato), gli shelf risonanti (Q 3) già da 5 kHz; la bilineare
+ * resta comunque molto peggiore in ogni caso.
+ */
+class MatchedDesignTests : public juce::UnitTest
+{
+public:
+    MatchedDesignTests() : juce::UnitTest("Matched design", "DSP") {}
+
+    void runTest() override
+    {
+        for (const auto& prototype : prototypes)
+        {
+            beginTest(juce::String("Matched vs analog prototype, ") + prototype.name);
+
+            Errors matched, bilinear;
+            for (const auto sampleRate : { 44100.0, 48000.0 })
+                for (const auto frequency : { 30.0f, 200.0f, 1000.0f, 5000.0f, 10000.0f, 16000.0f, 20000.0f })
+                    for (const auto q : { 0.5f, 0.707f, 1.5f, 3.0f })
+                        for (const auto gain : { -12.0f, -3.0f, 6.0f, 15.0f })
+                        {
+                            const Band band { prototype.type, frequency, q, gain };
+                            matched.add(frequency, measureErrorDb(band, sampleRate, BiquadDesign::Method::matched));
+                            bilinear.add(frequency, measureErrorDb(band, sampleRate, BiquadDesign::Method::bilinear));
+
+                            if (! prototype.usesGain)
+                                break;
+                        }
+
+            logMessage("max error up to 10 kHz: matched " + juce::String(matched.upTo10k, 2) + " dB, bilinear "
+                       + juce::String(bilinear.upTo10k, 2) + " dB; up to 20 kHz: matched "
+                       + juce::String(matched.upTo20k, 2) + " dB, bilinear " + juce::String(bilinear.upTo20k, 2) + " dB");
+
+            expectLessOrEqual(matched.upTo10k, prototype.maxErrorDbUpTo10k, "up to 10 kHz");
+            expectLessOrEqual(matched.upTo20k, prototype.maxErrorDbUpTo20k, "up to 20 kHz");
+            expectLessThan(matched.upTo10k, bilinear.upTo10k, "better than bilinear up to 10 kHz");
+            expectLessThan(matched.upTo20k, bilinear.upTo20k, "better than bilinear up to 20 kHz");
+        }
+    }
+
+private:
+    static constexpr double floorDb = -30.0;
+    static constexpr int numPoints = 512;
+
+    enum class Type { lowPass, highPass, notch, peak, lowShelf, highShelf };
+
+    struct Prototype
+    {
+        Type type;
+        const char* name;
+        bool usesGain;
+        double maxErrorDbUpTo10k, maxErrorDbUpTo20k;
+    };
+
+    // Limiti in dB fino a 10 e fino a 20 kHz (misurati: LP 1.40/1.52,
+    // HP 1.23/6.25, notch 1.75/7.11, bell 1.08/1.70, shelf 3.48/3.48)
+    static constexpr Prototype prototypes[] {
+        { Type::lowPass, "low pass", false, 1.6, 1.75 },
+        { Type::highPass, "high pass", false, 1.4, 7.0 },
+        { Type::notch, "notch", false, 2.0, 8.0 },
+        { Type::peak, "bell", true, 1.25, 2.0 },
+        { Type::lowShelf, "low shelf", true, 4.0, 4.0 },
+        { Type::highShelf, "high shelf", true, 4.0, 4.0 },
+    };
+
+    /** Errore massimo per frequenza del filtro fino a 10 e fino a 20 kHz. */
+    struct Errors
+    {
+        void add(float frequency, double error)
+        {
+            if (frequency <= 10000.0f)
+                upTo10k = juce::jmax(upTo10k, error);
+
+            upTo20k = juce::jmax(upTo20k, error);
+        }
+
+        double upTo10k = 0.0, upTo20k = 0.0;
+    };
+
+    struct Band
+    {
+        Type type;
+        float frequency, q, gain;
+    };
+
+    static BiquadCoefficients design(const Band& band, double sampleRate, BiquadDesign::Method method)
+    {
+        using namespace BiquadDesign;
+        const bool matched = method == Method::matched;
+        const auto gainFactor = juce::Decibels::decibelsToGain(band.gain);
+
+        switch (band.type)
+        {
+            case Type::lowPass:  return (matched ? matchedLowPass : lowPass)(sampleRate, band.frequency, band.q);
+            case Type::highPass: return (matched ? matchedHighPass : highPass)(sampleRate, band.frequency, band.q);
+            case Type::notch:    return (matched ? matchedNotch : notch)(sampleRate, band.frequency, band.q);
+            case Type::peak:     return (matched ? matchedPeak : peak)(sampleRate, band.frequency, band.q, gainFactor);
+            case Type::lowShelf: return (matched ? matchedLowShelf : lowShelf)(sampleRate, band.frequency, band.q, gainFactor);
+            case Type::highShelf:
+            default:             return (matched ? matchedHighShelf : highShelf)(sampleRate, band.frequency, band.q, gainFactor);
+        }
+    }
+
+    /** |H(jΩ)| del prototipo RBJ, con Ω normalizzata alla frequenza del filtro. */
+    static double analogMagnitude(const Band& band, double omega)
+    {
+        using Complex = std::complex<double>;
+        const Complex s(0.0, omega);
+        const double Q = static_cast<double>(band.q);
+        const double A = std::pow(10.0, static_cast<double>(band.gain) / 40.0);
+        const double slope = std::sqrt(A) / Q;
+
+        switch (band.type)
+        {
+            case Type::lowPass:  return std::abs(1.0 / (s * s + s / Q + 1.0));
+            case Type::highPass: return std::abs(s * s / (s * s + s / Q + 1.0));
+            case Type::notch:    return std::abs((s * s + 1.0) / (s * s + s / Q + 1.0));
+            case Type::peak:     return std::abs((s * s + s * (A / Q) + 1.0) / (s * s + s / (A * Q) + 1.0));
+            case Type::lowShelf: return std::abs(A * (s * s + slope * s + A) / (A * s * s + slope * s + 1.0));
+            case Type::highShelf:
+            default:             return std::abs(A * (A * s * s + slope * s + 1.0) / (s * s + slope * s + A));
+        }
+    }
+
+    static double digitalMagnitude(const BiquadCoefficients& c, double omega)
+    {
+        const auto z1 = std::polar(1.0, -omega);
+        const auto z2 = z1 * z1;
+        return std::abs((static_cast<double>(c.b0) + static_cast<double>(c.b1) * z1 + static_cast<double>(c.b2) * z2)
+                        / (1.0 + static_cast<double>(c.a1) * z1 + static_cast<double>(c.a2) * z2));
+    }
+
+    static double toDb(double magnitude)
+    {
+        return juce::jmax(floorDb, 20.0 * std::log10(juce::jmax(1.0e-30, magnitude)));
+    }
+
+    /** Errore massimo in dB tra 20 Hz e 20 kHz. */
+    static double measureErrorDb(const Band& band, double sampleRate, BiquadDesign::Method method)
+    {
+        const auto coefficients = design(band, sampleRate, method);
+        double error = 0.0;
+
+        for (int i = 0; i < numPoints; ++i)
+        {
+            const double frequency = 20.0 * std::pow(1000.0, static_cast<double>(i) / (numPoints - 1));
+            const double omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+            const double analog = toDb(analogMagnitude(band, frequency / static_cast<double>(band.frequency)));
+            error = juce::jmax(error, std::abs(toDb(digitalMagnitude(coefficients, omega)) - analog));
+        }
+
+        return error;
+    }
+};
+
+static MatchedDesignTests matchedDesignTests;
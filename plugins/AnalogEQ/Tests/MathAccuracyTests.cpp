@@ -0,0 +1,231 @@
+#include "DSP/KernelDispatch.h"
+#include <juce_core/juce_core.h>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+//==============================================================================
+/**
+ * Errore massimo delle approssimazioni di FastMath rispetto a libm (in
+ * double), per ogni ISA supportata dalla CPU, su griglie fitte dei rispettivi
+ * domini. Gli errori misurati vengono riportati nel log; il test fallisce
+ * sopra i limiti qui sotto, gli stessi documentati in FastMath.h.
+ */
+class MathAccuracyTests : public juce::UnitTest
+{
+public:
+    MathAccuracyTests() : juce::UnitTest("FastMath accuracy", "DSP") {}
+
+    // Limiti documentati (FastMath.h)
+    static constexpr double exp2MaxUlp = 1.5;          // x in [-100, 100]
+    static constexpr double log2MaxUlp = 3.0;          // x in [1e-30, 1e30]
+    static constexpr double tanhMaxUlp = 4.5;          // saturazione, x in [-20, 20]
+    static constexpr double sinCosMaxError = 2.5e-7;   // assoluto, x in [-100 pi, 100 pi]
+    static constexpr double decibelsMaxError = 2.0e-5; // dB, andata e ritorno tra -140 e +40 dB
+    static constexpr double adaa1MaxError = 2.0e-6;    // assoluto, contro la media di tanh
+    static constexpr double adaa2MaxError = 5.0e-5;    // calcolata per quadratura
+
+    void runTest() override
+    {
+        for (int i = 0; i < KernelDispatch::numIsas; ++i)
+        {
+            const auto isa = static_cast<KernelDispatch::Isa>(i);
+            const auto* table = KernelDispatch::getKernels(isa);
+            if (table == nullptr)
+                continue;
+
+            beginTest(juce::String("FastMath vs libm, ") + KernelDispatch::getIsaName(isa));
+            testTable(*table);
+        }
+    }
+
+private:
+    static constexpr int numPoints = 1 << 16;
+    static constexpr int numAdaaPoints = 1 << 12;
+    static constexpr float threshold = KernelDispatch::saturationThreshold;
+
+    void check(const char* function, double error, double bound, const char* unit)
+    {
+        logMessage(juce::String(function) + ": max error " + juce::String(error, 3, true) + " " + unit
+                   + " (bound " + juce::String(bound, 3, true) + ")");
+        expectLessOrEqual(error, bound, function);
+    }
+
+    void testTable(const KernelDispatch::KernelTable& table)
+    {
+        std::vector<float> output(static_cast<size_t>(numPoints)), second(static_cast<size_t>(numPoints));
+
+        {
+            double error = 0.0;
+            const auto input = makeGrid(-100.0, 100.0, false, numPoints);
+            table.exp2(input.data(), output.data(), numPoints);
+            for (size_t i = 0; i < input.size(); ++i)
+                error = juce::jmax(error, ulpError(output[i], std::exp2(static_cast<double>(input[i]))));
+
+            check("exp2", error, exp2MaxUlp, "ULP");
+        }
+
+        {
+            double error = 0.0;
+            const auto input = makeGrid(1.0e-30, 1.0e30, true, numPoints);
+            table.log2(input.data(), output.data(), numPoints);
+            for (size_t i = 0; i < input.size(); ++i)
+                error = juce::jmax(error, ulpError(output[i], std::log2(static_cast<double>(input[i]))));
+
+            check("log2", error, log2MaxUlp, "ULP");
+        }
+
+        {
+            double error = 0.0;
+            const auto input = makeGrid(-20.0, 20.0, false, numPoints);
+            output = input;
+            table.saturate(output.data(), numPoints);
+            for (size_t i = 0; i < input.size(); ++i)
+            {
+                const auto x = static_cast<double>(input[i] * (1.0f / threshold));
+                error = juce::jmax(error, ulpError(output[i], std::tanh(x) * threshold));
+            }
+
+            check("saturate (tanh)", error, tanhMaxUlp, "ULP");
+        }
+
+        {
+            double error = 0.0;
+            const auto input = makeGrid(-100.0 * juce::MathConstants<double>::pi,
+                                        100.0 * juce::MathConstants<double>::pi, false, numPoints);
+            table.sinCos(input.data(), output.data(), second.data(), numPoints);
+            for (size_t i = 0; i < input.size(); ++i)
+            {
+                const auto x = static_cast<double>(input[i]);
+                error = juce::jmax(error, std::abs(static_cast<double>(output[i]) - std::sin(x)),
+                                   std::abs(static_cast<double>(second[i]) - std::cos(x)));
+            }
+
+            check("sinCos", error, sinCosMaxError, "abs");
+        }
+
+        {
+            // Entrambe le direzioni contro libm, in dB
+            double error = 0.0;
+            const auto input = makeGrid(-140.0, 40.0, false, numPoints);
+            table.decibelsToGains(input.data(), output.data(), numPoints);
+            table.magnitudesToDecibels(output.data(), second.data(), numPoints, -200.0f, 200.0f);
+            for (size_t i = 0; i < input.size(); ++i)
+            {
+                const auto exactGain = std::pow(10.0, static_cast<double>(input[i]) / 20.0);
+                const auto exactDb = 20.0 * std::log10(static_cast<double>(output[i]));
+                error = juce::jmax(error, std::abs(20.0 * std::log10(static_cast<double>(output[i]) / exactGain)),
+                                   std::abs(static_cast<double>(second[i]) - exactDb));
+            }
+
+            check("decibels", error, decibelsMaxError, "dB");
+        }
+
+        {
+            const auto input = makeAdaaInput();
+            std::array<float, 2> history1 {}, history2 {};
+            std::vector<float> first(input), secondOrder(input);
+            table.saturateAdaa1(first.data(), numAdaaPoints, 1, history1.data());
+            table.saturateAdaa2(secondOrder.data(), numAdaaPoints, 1, history2.data());
+
+            double adaa1Error = 0.0, adaa2Error = 0.0;
+            for (size_t i = 2; i < input.size(); ++i)
+            {
+                const auto x0 = static_cast<double>(input[i] * (1.0f / threshold));
+                const auto x1 = static_cast<double>(input[i - 1] * (1.0f / threshold));
+                const auto x2 = static_cast<double>(input[i - 2] * (1.0f / threshold));
+                adaa1Error = juce::jmax(adaa1Error, std::abs(static_cast<double>(first[i]) - meanTanh(x0, x1) * threshold));
+                adaa2Error = juce::jmax(adaa2Error, std::abs(static_cast<double>(secondOrder[i]) - meanTanh(x0, x1, x2) * threshold));
+            }
+
+            check("saturateAdaa1", adaa1Error, adaa1MaxError, "abs");
+            check("saturateAdaa2", adaa2Error, adaa2MaxError, "abs");
+        }
+    }
+
+    /** Distanza da exact in ULP del float più vicino. */
+    static double ulpError(float value, double exact)
+    {
+        const auto magnitude = std::abs(static_cast<float>(exact));
+        const auto ulp = std::nextafter(magnitude, std::numeric_limits<float>::infinity()) - magnitude;
+        return std::abs(static_cast<double>(value) - exact) / static_cast<double>(ulp);
+    }
+
+    /** count valori tra start ed end, in scala lineare o logaritmica. */
+    static std::vector<float> makeGrid(double start, double end, bool logarithmic, int count)
+    {
+        std::vector<float> grid(static_cast<size_t>(count));
+
+        for (int i = 0; i < count; ++i)
+        {
+            const auto proportion = static_cast<double>(i) / static_cast<double>(count - 1);
+            grid[static_cast<size_t>(i)] = static_cast<float>(logarithmic ? start * std::pow(end / start, proportion)
+                                                                           : start + (end - start) * proportion);
+        }
+
+        return grid;
+    }
+
+    /** Sinusoidi fino a 20 kHz (a 48 kHz) e rumore, anche quasi costante. */
+    static std::vector<float> makeAdaaInput()
+    {
+        std::vector<float> input(static_cast<size_t>(numAdaaPoints));
+        juce::Random random(1);
+
+        for (int i = 0; i < numAdaaPoints; ++i)
+        {
+            const auto segment = i / (numAdaaPoints / 8);
+            const auto amplitude = 0.05 * std::pow(2.0, segment % 4 * 1.5);
+            const auto value = segment < 4 ? amplitude * std::sin(0.0003 * i * i)
+                                           : (segment < 6 ? amplitude * (random.nextDouble() * 2.0 - 1.0)
+                                                          : 0.7 + 1.0e-4 * random.nextDouble());
+            input[static_cast<size_t>(i)] = static_cast<float>(value);
+        }
+
+        return input;
+    }
+
+    /** Nodi (su [0, 1]) e pesi di Gauss-Legendre a 8 punti. */
+    static constexpr std::array<std::array<double, 2>, 8> gaussLegendre {{
+        { 0.01985507175123188, 0.05061426814518813 }, { 0.10166676129318664, 0.11119051722668724 },
+        { 0.23723379504183550, 0.15685332293894364 }, { 0.40828267875217510, 0.18134189168918100 },
+        { 0.59171732124782490, 0.18134189168918100 }, { 0.76276620495816450, 0.15685332293894364 },
+        { 0.89833323870681336, 0.11119051722668724 }, { 0.98014492824876812, 0.05061426814518813 }
+    }};
+
+    /** Media di tanh sul segmento tra a e b (uscita esatta di ADAA1), per quadratura composta. */
+    static double meanTanh(double a, double b)
+    {
+        const int pieces = 1 + static_cast<int>(std::abs(a - b));
+        double sum = 0.0;
+
+        for (int p = 0; p < pieces; ++p)
+            for (const auto& node : gaussLegendre)
+                sum += node[1] * std::tanh(b + (p + node[0]) / pieces * (a - b));
+
+        return sum / pieces;
+    }
+
+    /** Media di tanh sul triangolo x0, x1, x2 (uscita esatta di ADAA2), Duffy + quadratura composta. */
+    static double meanTanh(double x0, double x1, double x2)
+    {
+        const auto spread = juce::jmax(std::abs(x0 - x1), std::abs(x1 - x2), std::abs(x0 - x2));
+        const int pieces = 1 + static_cast<int>(spread);
+        double sum = 0.0;
+
+        for (int p = 0; p < pieces; ++p)
+            for (int q = 0; q < pieces; ++q)
+                for (const auto& s : gaussLegendre)
+                    for (const auto& t : gaussLegendre)
+                    {
+                        const auto u = (p + s[0]) / pieces;
+                        const auto v = (q + t[0]) / pieces;
+                        sum += s[1] * t[1] * u * std::tanh(x0 + u * (x1 - x0) + u * v * (x2 - x1));
+                    }
+
+        return 2.0 * sum / (pieces * pieces);
+    }
+};
+
+static MathAccuracyTests mathAccuracyTests;
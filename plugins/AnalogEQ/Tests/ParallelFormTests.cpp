@@ -0,0 +1,166 @@
+#include "DSP/FilterChain.h"
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+//==============================================================================
+/**
+ * Forma parallela progettata dal DesignWorker: la catena resta in serie
+ * finché la prima forma non è pubblicata, poi la usa con la stessa uscita
+ * della serie; le rampe di coefficienti continuano ad avanzare e la forma
+ * resta attiva mentre le segue.
+ */
+class ParallelFormTests : public juce::UnitTest
+{
+public:
+    ParallelFormTests() : juce::UnitTest("Parallel form", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest("Parallel form is published by the worker");
+
+        auto parallel = makeChain(FilterChain::ExecutionMode::parallel);
+        auto reference = makeChain(FilterChain::ExecutionMode::cascade);
+
+        juce::AudioBuffer<float> buffer(2, blockSize), expected(2, blockSize);
+        processSilence(*parallel, buffer);
+        expect(! parallel->isParallelFormActive(), "the first block runs in series");
+
+        expect(waitForParallelForm(*parallel, buffer));
+
+        beginTest("Parallel output matches the cascade");
+
+        parallel->reset();
+        reference->reset();
+
+        juce::Random random(5);
+        float difference = 0.0f;
+
+        for (int block = 0; block < 32; ++block)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.getWritePointer(ch)[i] = 0.25f * (2.0f * random.nextFloat() - 1.0f);
+
+            for (int ch = 0; ch < 2; ++ch)
+                std::copy_n(buffer.getReadPointer(ch), blockSize, expected.getWritePointer(ch));
+
+            parallel->processBlock(buffer);
+            reference->processBlock(expected);
+            expect(parallel->isParallelFormActive());
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                const auto* output = buffer.getReadPointer(ch);
+                const auto* target = expected.getReadPointer(ch);
+                for (int i = 0; i < blockSize; ++i)
+                    difference = juce::jmax(difference, std::abs(output[i] - target[i]));
+            }
+        }
+
+        logMessage("max difference " + juce::String(difference, 3, true));
+        expectLessOrEqual(difference, maxDifference);
+
+        testRampInParallelMode(*parallel);
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 512;
+    static constexpr float maxDifference = 1.0e-4f;
+    static constexpr float toleranceDb = 0.01f;
+    static constexpr int maxWaitBlocks = 2000;
+
+    static std::unique_ptr<FilterChain> makeChain(FilterChain::ExecutionMode mode)
+    {
+        auto chain = std::make_unique<FilterChain>();
+
+        const struct { FilterType type; float frequency, gain, q; } bands[] {
+            { FilterType::Bell, 200.0f, 6.0f, 1.0f },
+            { FilterType::LowShelf, 100.0f, -3.0f, 0.707f },
+            { FilterType::Bell, 2000.0f, -5.0f, 2.0f },
+            { FilterType::HighShelf, 8000.0f, 4.0f, 0.707f },
+        };
+
+        chain->setAsyncDesign(false);
+        for (const auto& band : bands)
+        {
+            auto* filter = chain->addFilter(band.type);
+            filter->setFrequency(band.frequency);
+            filter->setGain(band.gain);
+            filter->setQ(band.q);
+        }
+
+        chain->setExecutionMode(mode);
+        chain->setSaturationPlacement(FilterChain::SaturationPlacement::chainOutput);
+        chain->prepare(sampleRate, blockSize);
+
+        for (size_t i = 0; i < std::size(bands); ++i)
+            chain->updateFilterCoefficients(i);
+
+        chain->setAsyncDesign(true);
+        return chain;
+    }
+
+    static void processSilence(FilterChain& chain, juce::AudioBuffer<float>& buffer)
+    {
+        buffer.clear();
+        chain.processBlock(buffer);
+    }
+
+    /** Blocchi di silenzio finché il worker non pubblica la forma parallela. */
+    static bool waitForParallelForm(FilterChain& chain, juce::AudioBuffer<float>& buffer)
+    {
+        for (int block = 0; block < maxWaitBlocks && ! chain.isParallelFormActive(); ++block)
+        {
+            juce::Thread::sleep(1);
+            processSilence(chain, buffer);
+        }
+
+        return chain.isParallelFormActive();
+    }
+
+    /**
+     * Bell a 200 Hz da +6 a -6 dB con le rampe attive: un blocco da 64
+     * campioni carica due passi, quindi la risposta della banda deve essere
+     * a metà strada, con la forma parallela ancora in uso.
+     */
+    void testRampInParallelMode(FilterChain& chain)
+    {
+        beginTest("Ramps keep running in parallel mode");
+
+        constexpr int rampBlockSize = 2 * FilterChain::rampStepSamples;
+        constexpr float centre = 200.0f;
+
+        juce::AudioBuffer<float> buffer(2, rampBlockSize);
+        auto* filter = chain.getFilter(0);
+        chain.setCoefficientSmoothing(true);
+
+        filter->setGain(-6.0f);
+        chain.updateFilterCoefficients(0);
+
+        // Il primo blocco con la rampa dal worker
+        float response = filter->getFrequencyResponse(centre);
+        for (int block = 0; block < maxWaitBlocks && response > 6.0f - toleranceDb; ++block)
+        {
+            juce::Thread::sleep(1);
+            processSilence(chain, buffer);
+            response = filter->getFrequencyResponse(centre);
+        }
+
+        expectLessThan(response, 6.0f - toleranceDb, "the ramp has started");
+        expectGreaterThan(response, -6.0f + toleranceDb, "the ramp has not jumped to the end");
+        expect(chain.isParallelFormActive());
+
+        for (int block = 0; block < DesignWorker::maxRampLength; ++block)
+        {
+            processSilence(chain, buffer);
+            expect(chain.isParallelFormActive(), "no fallback to series during the ramp");
+        }
+
+        expectWithinAbsoluteError(filter->getFrequencyResponse(centre), -6.0f, toleranceDb);
+    }
+};
+
+static ParallelFormTests parallelFormTests;
@@ -0,0 +1,105 @@
+#include "DSP/AnalogSaturation.h"
+#include <juce_core/juce_core.h>
+#include <cmath>
+#include <vector>
+
+//==============================================================================
+/**
+ * Aliasing della saturazione a 1x: una sinusoide acuta e ampia attraverso
+ * AnalogSaturation senza antialiasing, con ADAA del primo e del secondo
+ * ordine. Con un numero intero di periodi nella finestra l'uscita ideale
+ * contiene solo la fondamentale (tutte le armoniche dispari superano
+ * Nyquist): l'energia che resta togliendo la fondamentale ai minimi
+ * quadrati è quella dei parziali ripiegati.
+ *
+ * L'ADAA attenua i parziali ripiegati con una risposta di tipo sinc (sinc²
+ * al secondo ordine), che abbassa anche la fondamentale: sopra ~13 kHz a
+ * 48 kHz il rapporto non migliora più, quindi il test resta tra 8 e 12 kHz.
+ */
+class SaturationAliasingTests : public juce::UnitTest
+{
+public:
+    SaturationAliasingTests() : juce::UnitTest("Saturation aliasing", "DSP") {}
+
+    // Energia massima dei parziali ripiegati rispetto alla fondamentale
+    // (misurati: -20.5, da -26.9 a -39.4 e da -39.7 a -51.1 dB)
+    static constexpr double noneMaxDb = -18.0;
+    static constexpr double adaa1MaxDb = -25.0;
+    static constexpr double adaa2MaxDb = -37.0;
+
+    // Riduzione minima rispetto al modo senza antialiasing
+    static constexpr double adaa1MinReductionDb = 5.0;
+    static constexpr double adaa2MinReductionDb = 16.0;
+
+    void runTest() override
+    {
+        using AnalogSaturation::Antialiasing;
+
+        KernelDispatch::selectKernels();
+
+        for (const auto frequency : { 8500.0, 10000.0, 11500.0 })
+        {
+            beginTest("Folded partials at " + juce::String(frequency / 1000.0, 1) + " kHz");
+
+            const auto none = measureAliasingDb(Antialiasing::none, frequency);
+            const auto adaa1 = measureAliasingDb(Antialiasing::firstOrder, frequency);
+            const auto adaa2 = measureAliasingDb(Antialiasing::secondOrder, frequency);
+
+            logMessage("aliasing (dB re fundamental): off " + juce::String(none, 1)
+                       + ", ADAA1 " + juce::String(adaa1, 1) + ", ADAA2 " + juce::String(adaa2, 1));
+
+            expectLessOrEqual(none, noneMaxDb, "no antialiasing");
+            expectLessOrEqual(adaa1, adaa1MaxDb, "ADAA1");
+            expectLessOrEqual(adaa2, adaa2MaxDb, "ADAA2");
+            expectGreaterOrEqual(none - adaa1, adaa1MinReductionDb, "ADAA1 reduction");
+            expectGreaterOrEqual(none - adaa2, adaa2MinReductionDb, "ADAA2 reduction");
+            expectLessThan(adaa2, adaa1, "ADAA2 below ADAA1");
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int analysisLength = 8192;
+    static constexpr int warmupLength = 256;
+    static constexpr float amplitude = 1.0f; // 1.9 dB sopra la soglia
+
+    /**
+     * @return L'energia dell'uscita senza fondamentale e componente continua,
+     *         in dB rispetto alla fondamentale
+     */
+    static double measureAliasingDb(AnalogSaturation::Antialiasing antialiasing, double requestedFrequency)
+    {
+        // Bin dispari: nessuna armonica ripiegata cade sulla fondamentale
+        const int bin = 2 * static_cast<int>(requestedFrequency / sampleRate * analysisLength / 2.0) + 1;
+        const auto omega = juce::MathConstants<double>::twoPi * bin / analysisLength;
+
+        std::vector<float> signal(static_cast<size_t>(warmupLength + analysisLength));
+        for (size_t i = 0; i < signal.size(); ++i)
+            signal[i] = amplitude * static_cast<float>(std::sin(omega * static_cast<double>(i)));
+
+        AnalogSaturation::State state;
+        float* channels[] = { signal.data() };
+        AnalogSaturation::process(channels, 1, static_cast<int>(signal.size()), antialiasing, state);
+
+        // Proiezione su continua, seno e coseno della fondamentale (ortogonali
+        // su un numero intero di periodi)
+        const float* output = signal.data() + warmupLength;
+        double mean = 0.0, sine = 0.0, cosine = 0.0, total = 0.0;
+        for (int n = 0; n < analysisLength; ++n)
+        {
+            const auto y = static_cast<double>(output[n]);
+            const auto phase = omega * static_cast<double>(n + warmupLength);
+            mean += y;
+            sine += y * std::sin(phase);
+            cosine += y * std::cos(phase);
+            total += y * y;
+        }
+
+        mean /= analysisLength;
+        const auto fundamental = 2.0 * (sine * sine + cosine * cosine) / analysisLength;
+        const auto residual = juce::jmax(1.0e-30, total - analysisLength * mean * mean - fundamental);
+        return 10.0 * std::log10(residual / fundamental);
+    }
+};
+
+static SaturationAliasingTests saturationAliasingTests;
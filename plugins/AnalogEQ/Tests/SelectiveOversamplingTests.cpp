@@ -0,0 +1,194 @@
+#include "DSP/ChainOversampler.h"
+#include "DSP/FilterChain.h"
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+ * Sovracampionamento selettivo (ChainOversampler::Scope::highBands): la
+ * catena con le bande alte sovracampionate dà la stessa uscita di una catena
+ * con le sole bande basse seguita da una catena sovracampionata con le sole
+ * bande alte, in modalità cascade, fused e parallel; e le bande passano da
+ * un segmento all'altro con l'isteresi della soglia.
+ */
+class SelectiveOversamplingTests : public juce::UnitTest
+{
+public:
+    SelectiveOversamplingTests() : juce::UnitTest("Selective oversampling", "DSP") {}
+
+    void runTest() override
+    {
+        for (const auto mode : { FilterChain::ExecutionMode::cascade, FilterChain::ExecutionMode::fused,
+                                 FilterChain::ExecutionMode::parallel })
+            testMatchesSeparateChains(mode);
+
+        testHysteresis();
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 512;
+    static constexpr int order = 1; // 2x
+    static constexpr float maxDifference = 1.0e-6f;
+
+    struct Band
+    {
+        FilterType type;
+        float frequency, gain, q;
+    };
+
+    // Soglia a 48 kHz: 0.25 di Nyquist, cioè 6 kHz
+    const std::vector<Band> lowBands {
+        { FilterType::LowShelf, 100.0f, -3.0f, 0.707f },
+        { FilterType::Bell, 1000.0f, 6.0f, 1.0f },
+    };
+
+    const std::vector<Band> highBands {
+        { FilterType::Bell, 9000.0f, -5.0f, 2.0f },
+        { FilterType::HighShelf, 15000.0f, 4.0f, 0.707f },
+    };
+
+    /**
+     * Come AudioPluginAudioProcessor::prepareFilterChain, alla frequenza di
+     * lavoro di oversampler (frequenza base senza).
+     */
+    static std::unique_ptr<FilterChain> makeChain(FilterChain::ExecutionMode mode, const std::vector<Band>& bands,
+                                                  const ChainOversampler* oversampler)
+    {
+        auto chain = std::make_unique<FilterChain>();
+        chain->setAsyncDesign(false);
+
+        for (const auto& band : bands)
+        {
+            auto* filter = chain->addFilter(band.type);
+            filter->setFrequency(band.frequency);
+            filter->setGain(band.gain);
+            filter->setQ(band.q);
+        }
+
+        const auto rate = oversampler != nullptr ? oversampler->getProcessingRate(sampleRate) : sampleRate;
+        chain->setExecutionMode(mode);
+        chain->prepare(rate, blockSize * (oversampler != nullptr ? oversampler->getFactor() : 1));
+        chain->setSelectiveOversampling(oversampler != nullptr ? oversampler->getSelectiveFactor() : 1);
+        chain->updateAllCoefficients(rate);
+        chain->reset();
+        chain->setAsyncDesign(true);
+        return chain;
+    }
+
+    static std::unique_ptr<ChainOversampler> makeOversampler(ChainOversampler::Scope scope)
+    {
+        auto oversampler = std::make_unique<ChainOversampler>();
+        oversampler->prepare(blockSize);
+        oversampler->reset();
+        oversampler->setMode(order, ChainOversampler::Filter::polyphaseIir, scope);
+        return oversampler;
+    }
+
+    //==============================================================================
+    /**
+     * Selettivo: bande basse a 48 kHz, poi le alte a 96 kHz tra gli stessi
+     * stadi. Riferimento: catena a 48 kHz con le sole bande basse, poi
+     * catena con le sole bande alte sovracampionata per intero.
+     */
+    void testMatchesSeparateChains(FilterChain::ExecutionMode mode)
+    {
+        const juce::String modeName = mode == FilterChain::ExecutionMode::cascade ? "cascade"
+                                    : mode == FilterChain::ExecutionMode::fused ? "fused" : "parallel";
+        beginTest("High bands match a separate oversampled chain (" + modeName + ")");
+
+        auto selectiveOversampler = makeOversampler(ChainOversampler::Scope::highBands);
+        auto wholeOversampler = makeOversampler(ChainOversampler::Scope::wholeChain);
+
+        auto bands = lowBands;
+        bands.insert(bands.end(), highBands.begin(), highBands.end());
+
+        // In parallel la catena selettiva resta in serie (la forma parallela
+        // non copre le bande sovracampionate e satura solo in uscita): il
+        // riferimento sono le stesse catene in serie
+        const auto referenceMode = mode == FilterChain::ExecutionMode::parallel ? FilterChain::ExecutionMode::cascade : mode;
+
+        auto selective = makeChain(mode, bands, selectiveOversampler.get());
+        auto lowChain = makeChain(referenceMode, lowBands, nullptr);
+        auto highChain = makeChain(referenceMode, highBands, wholeOversampler.get());
+
+        // Le bande alte sono gli slot dopo le basse
+        const auto numLow = static_cast<int>(lowBands.size());
+        const auto highMask = ((1 << bands.size()) - 1) & ~((1 << numLow) - 1);
+
+        juce::AudioBuffer<float> buffer(2, blockSize), expected(2, blockSize);
+
+        juce::Random random(22);
+        float difference = 0.0f;
+
+        for (int block = 0; block < 32; ++block)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.getWritePointer(ch)[i] = 0.25f * (2.0f * random.nextFloat() - 1.0f);
+
+            for (int ch = 0; ch < 2; ++ch)
+                std::copy_n(buffer.getReadPointer(ch), blockSize, expected.getWritePointer(ch));
+
+            selectiveOversampler->process(buffer, *selective);
+            lowChain->processBlock(expected);
+            wholeOversampler->process(expected, *highChain);
+
+            expectEquals(static_cast<int>(selective->getOversampledBandMask()), highMask);
+            expect(! selective->isParallelFormActive());
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                const auto* output = buffer.getReadPointer(ch);
+                const auto* target = expected.getReadPointer(ch);
+                for (int i = 0; i < blockSize; ++i)
+                    difference = juce::jmax(difference, std::abs(output[i] - target[i]));
+            }
+        }
+
+        logMessage("max difference " + juce::String(difference, 3, true));
+        expectLessOrEqual(difference, maxDifference);
+    }
+
+    //==============================================================================
+    /**
+     * A 48 kHz la soglia è 6 kHz e il ritorno a frequenza base sotto 4.8 kHz:
+     * un Bell a 7 kHz viene sovracampionato, a 5.5 kHz resta dov'è in
+     * entrambe le direzioni, a 4 kHz torna a frequenza base.
+     */
+    void testHysteresis()
+    {
+        beginTest("Bands change segment with hysteresis");
+
+        auto oversampler = makeOversampler(ChainOversampler::Scope::highBands);
+        auto chain = makeChain(FilterChain::ExecutionMode::cascade, { { FilterType::Bell, 7000.0f, 6.0f, 1.0f } }, oversampler.get());
+        auto* filter = chain->getFilter(0);
+        const auto band = filter->getCascadeBand();
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        const auto moveTo = [&](float frequency)
+        {
+            filter->setFrequency(frequency);
+            chain->updateFilterCoefficients(0);
+            buffer.clear();
+            oversampler->process(buffer, *chain);
+            return chain->getBandSampleRate(band);
+        };
+
+        const auto oversampledRate = sampleRate * oversampler->getSelectiveFactor();
+
+        expectEquals(moveTo(7000.0f), oversampledRate, "above the threshold");
+        expectEquals(moveTo(5500.0f), oversampledRate, "stays oversampled above the hysteresis");
+        expectEquals(moveTo(4000.0f), sampleRate, "back to the base rate below the hysteresis");
+        expectEquals(moveTo(5500.0f), sampleRate, "stays at the base rate below the threshold");
+        expectEquals(moveTo(7000.0f), oversampledRate, "oversampled again");
+
+        // La banda spostata viene riprogettata alla sua nuova frequenza
+        expectWithinAbsoluteError(filter->getFrequencyResponse(7000.0f), 6.0f, 0.01f);
+    }
+};
+
+static SelectiveOversamplingTests selectiveOversamplingTests;
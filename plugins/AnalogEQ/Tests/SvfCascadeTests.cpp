@@ -0,0 +1,235 @@
+#include "DSP/BiquadCascade.h"
+#include "DSP/BiquadDesign.h"
+#include "DSP/SvfCascade.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+ * Topologia SVF: a rampa finita SvfCascade dà la stessa uscita di
+ * BiquadCascade per ogni tipo di banda, bilineare e matched, e lungo una
+ * rampa tra due progetti qualsiasi (anche ripartita a metà) g resta
+ * positivo e k non negativo in ogni sezione, campione per campione.
+ */
+class SvfCascadeTests : public juce::UnitTest
+{
+public:
+    SvfCascadeTests() : juce::UnitTest("SVF cascade", "DSP") {}
+
+    void runTest() override
+    {
+        testMatchesBiquad();
+        testRampStaysStable();
+    }
+
+private:
+    using Parameters = BiquadDesign::BandParameters;
+    using Method = BiquadDesign::Method;
+    using CutResponse = BiquadDesign::CutResponse;
+
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 4096;
+    static constexpr int rampSamples = 1024;
+    static constexpr float maxDifference = 3.7e-5f;
+    static constexpr double maxReferenceDifference = 1.0e-5;
+
+    static constexpr FilterType types[] { FilterType::LowPass, FilterType::HighPass, FilterType::BandPass, FilterType::Bell,
+                                          FilterType::LowShelf, FilterType::HighShelf, FilterType::Notch };
+
+    static bool isCut(FilterType type) { return type == FilterType::LowPass || type == FilterType::HighPass; }
+
+    //==============================================================================
+    /**
+     * Ogni progetto arriva nell'SVF con una rampa da quello precedente e,
+     * a rampa finita e stati azzerati, il rumore esce come dalla cascata
+     * biquad con gli stessi coefficienti. A 100 Hz è la forma diretta in
+     * float a scostarsi (fino a 1.3e-4): lì il confronto è con le stesse
+     * sezioni calcolate in double.
+     */
+    void testMatchesBiquad()
+    {
+        beginTest("Static output matches the biquad cascade");
+
+        auto cascade = std::make_unique<BiquadCascade>();
+        auto svf = std::make_unique<SvfCascade>();
+
+        juce::AudioBuffer<float> input(2, blockSize), biquadOutput(2, blockSize), svfOutput(2, blockSize);
+        juce::Random random(25);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < blockSize; ++i)
+                input.getWritePointer(ch)[i] = 0.25f * (2.0f * random.nextFloat() - 1.0f);
+
+        std::vector<double> reference(static_cast<size_t>(blockSize));
+        float biquadDifference = 0.0f;
+        double referenceDifference = 0.0;
+        int numDesigns = 0;
+
+        for (const auto type : types)
+            for (const auto method : { Method::bilinear, Method::matched })
+                for (const auto response : { CutResponse::butterworth, CutResponse::linkwitzRiley, CutResponse::elliptic })
+                {
+                    if (response != CutResponse::butterworth && ! isCut(type))
+                        continue;
+
+                    for (int slope = 0; slope < 5; ++slope)
+                        for (const auto frequency : { 100.0f, 1000.0f, 10000.0f })
+                        {
+                            BiquadDesign::SectionArray sections;
+                            const int numSections = BiquadDesign::designBand({ type, frequency, 6.0f, 2.0f, slope, method, response },
+                                                                             sampleRate, sections);
+
+                            cascade->setNumSections(0, numSections);
+                            for (int s = 0; s < numSections; ++s)
+                                cascade->setSection(0, s, sections[static_cast<size_t>(s)]);
+
+                            svf->setTargets(0, sections.data(), numSections, rampSamples);
+                            process(*svf, svfOutput, nullptr);
+                            expect(! svf->isSmoothing(0), "the ramp has finished");
+                            expectEquals(svf->getNumSections(0), numSections);
+
+                            cascade->reset();
+                            svf->reset();
+                            process(*cascade, biquadOutput, &input);
+                            process(*svf, svfOutput, &input);
+
+                            for (int ch = 0; ch < 2; ++ch)
+                            {
+                                processReference(sections, numSections, input.getReadPointer(ch), reference);
+                                const auto* output = svfOutput.getReadPointer(ch);
+                                const auto* expected = biquadOutput.getReadPointer(ch);
+
+                                for (int i = 0; i < blockSize; ++i)
+                                {
+                                    referenceDifference = juce::jmax(referenceDifference,
+                                                                     std::abs(static_cast<double>(output[i]) - reference[static_cast<size_t>(i)]));
+
+                                    if (frequency >= 1000.0f)
+                                        biquadDifference = juce::jmax(biquadDifference, std::abs(output[i] - expected[i]));
+                                }
+                            }
+
+                            ++numDesigns;
+                        }
+                }
+
+        logMessage(juce::String(numDesigns) + " designs, max difference " + juce::String(biquadDifference, 3, true)
+                   + " from the biquad cascade (1 kHz and up), " + juce::String(referenceDifference, 3, true)
+                   + " from the double-precision sections");
+
+        expectLessOrEqual(biquadDifference, maxDifference);
+        expectLessOrEqual(referenceDifference, maxReferenceDifference);
+    }
+
+    /** Le stesse sezioni in double (trasposta di forma diretta II). */
+    static void processReference(const BiquadDesign::SectionArray& sections, int numSections, const float* input,
+                                 std::vector<double>& output)
+    {
+        std::copy_n(input, blockSize, output.begin());
+
+        for (int s = 0; s < numSections; ++s)
+        {
+            const auto& c = sections[static_cast<size_t>(s)];
+            double z1 = 0.0, z2 = 0.0;
+
+            for (auto& sample : output)
+            {
+                const double x = sample;
+                const double y = static_cast<double>(c.b0) * x + z1;
+                z1 = static_cast<double>(c.b1) * x - static_cast<double>(c.a1) * y + z2;
+                z2 = static_cast<double>(c.b2) * x - static_cast<double>(c.a2) * y;
+                sample = y;
+            }
+        }
+    }
+
+    /** Copia input (o silenzio) in output e lo processa nella banda 0. */
+    template <typename Engine>
+    static void process(Engine& engine, juce::AudioBuffer<float>& output, const juce::AudioBuffer<float>* input)
+    {
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            if (input != nullptr)
+                std::copy_n(input->getReadPointer(ch), blockSize, output.getWritePointer(ch));
+            else
+                std::fill_n(output.getWritePointer(ch), blockSize, 0.0f);
+        }
+
+        engine.processBand(0, output.getArrayOfWritePointers(), 2, blockSize);
+    }
+
+    //==============================================================================
+    /**
+     * Coppie casuali di progetti (tipo, slope, metodo, risposta, frequenza,
+     * gain e Q su tutto il range), con una nuova destinazione a metà rampa
+     * nella metà dei casi: un campione alla volta, così ogni passo
+     * dell'interpolazione è visibile.
+     */
+    void testRampStaysStable()
+    {
+        beginTest("g > 0 and k >= 0 along ramps between arbitrary designs");
+
+        auto svf = std::make_unique<SvfCascade>();
+        juce::Random random(7);
+
+        const auto randomDesign = [&random]
+        {
+            return Parameters { types[random.nextInt(static_cast<int>(std::size(types)))],
+                                20.0f * std::pow(1000.0f, random.nextFloat()),
+                                -24.0f + 48.0f * random.nextFloat(),
+                                0.1f * std::pow(180.0f, random.nextFloat()),
+                                random.nextInt(5),
+                                random.nextBool() ? Method::matched : Method::bilinear,
+                                static_cast<CutResponse>(random.nextInt(3)) };
+        };
+
+        const auto setTargets = [&svf](const Parameters& parameters, int ramp)
+        {
+            BiquadDesign::SectionArray sections;
+            const int numSections = BiquadDesign::designBand(parameters, sampleRate, sections);
+            svf->setTargets(0, sections.data(), numSections, ramp);
+        };
+
+        int numSamples = 0;
+
+        for (int pair = 0; pair < 200; ++pair)
+        {
+            svf->reset();
+            setTargets(randomDesign(), 0);
+
+            const int ramp = 1 + random.nextInt(2 * rampSamples);
+            const int retargetAt = random.nextBool() ? random.nextInt(ramp) : -1;
+            setTargets(randomDesign(), ramp);
+
+            bool stable = true, finite = true;
+
+            for (int n = 0; svf->isSmoothing(0); ++n, ++numSamples)
+            {
+                if (n == retargetAt)
+                    setTargets(randomDesign(), 1 + random.nextInt(2 * rampSamples));
+
+                float sample = 0.25f * (2.0f * random.nextFloat() - 1.0f);
+                float* channels[] { &sample };
+                svf->processBand(0, channels, 1, 1);
+                finite = finite && std::isfinite(sample);
+
+                for (int s = 0; s < svf->getNumSections(0); ++s)
+                {
+                    const auto parameters = svf->getParameters(0, s);
+                    stable = stable && parameters.g > 0.0f && parameters.k >= 0.0f;
+                }
+            }
+
+            expect(stable, "ramp " + juce::String(pair));
+            expect(finite, "ramp " + juce::String(pair));
+        }
+
+        logMessage(juce::String(numSamples) + " ramp samples");
+    }
+};
+
+static SvfCascadeTests svfCascadeTests;
@@ -0,0 +1,28 @@
+#include <juce_gui_basics/juce_gui_basics.h>
+
+//==============================================================================
+/**
+ * Esegue tutti i juce::UnitTest registrati nell'eseguibile (un'istanza
+ * statica per file) e restituisce un codice d'uscita non nullo se almeno
+ * un'asserzione fallisce, come richiesto da ctest.
+ * Con un argomento viene eseguita solo la categoria indicata.
+ */
+int main(int argc, char* argv[])
+{
+    // MessageManager e thread di supporto come nel plugin caricato da un host
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+
+    if (argc > 1)
+        runner.runTestsInCategory(argv[1]);
+    else
+        runner.runAllTests();
+
+    int failures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        failures += runner.getResult(i)->failures;
+
+    return failures > 0 ? 1 : 0;
+}